@@ -19,6 +19,7 @@
  */
 
 #include <brayns/Brayns.h>
+#include <brayns/common/Statistics.h>
 #include <brayns/common/Timer.h>
 #include <brayns/common/log.h>
 #include <brayns/common/types.h>
@@ -28,22 +29,26 @@
 
 #include <uvw.hpp>
 
+#include <algorithm>
 #include <thread>
 
+namespace
+{
+const std::chrono::milliseconds STATISTICS_INTERVAL{1000};
+}
+
 class BraynsService
 {
 public:
     BraynsService(int argc, const char** argv)
         : _renderingDone{_mainLoop->resource<uvw::AsyncHandle>()}
         , _eventRendering{_mainLoop->resource<uvw::IdleHandle>()}
-        , _accumRendering{_mainLoop->resource<uvw::IdleHandle>()}
-        , _checkIdleRendering{_mainLoop->resource<uvw::CheckHandle>()}
+        , _accumRendering{_mainLoop->resource<uvw::TimerHandle>()}
+        , _statisticsUpdate{_mainLoop->resource<uvw::TimerHandle>()}
         , _sigintHandle{_mainLoop->resource<uvw::SignalHandle>()}
         , _triggerRendering{_renderLoop->resource<uvw::AsyncHandle>()}
         , _stopRenderThread{_renderLoop->resource<uvw::AsyncHandle>()}
     {
-        _checkIdleRendering->start();
-
         _setupMainThread();
         _setupRenderThread();
 
@@ -58,6 +63,7 @@ public:
 
         // launch first frame; after that, only events will trigger that
         _eventRendering->start();
+        _statisticsUpdate->start(STATISTICS_INTERVAL, STATISTICS_INTERVAL);
 
         // stop the application on Ctrl+C
         _sigintHandle->once<uvw::SignalEvent>(
@@ -81,9 +87,9 @@ private:
     {
         // triggered after rendering, send events to rockets from the main
         // thread
-        _renderingDone->on<uvw::AsyncEvent>([& brayns = _brayns](const auto&,
-                                                                 auto&) {
-            brayns->postRender();
+        _renderingDone->on<uvw::AsyncEvent>([&](const auto&, auto&) {
+            _brayns->postRender();
+            _scheduleAccumRendering();
         });
 
         // render or data load trigger from events
@@ -104,23 +110,37 @@ private:
                 _triggerRendering->send();
         });
 
-        // start accum rendering when we have no more other events
-        _checkIdleRendering->on<uvw::CheckEvent>([& accumRendering =
-                                                      _accumRendering](
-            const auto&, auto&) { accumRendering->start(); });
-
-        // accumulation rendering on idle; re-triggered by _checkIdleRendering
-        _accumRendering->on<uvw::IdleEvent>([&](const auto&, auto&) {
-            if (_timeSinceLastEvent.elapsed() < _idleRenderingDelay)
-                return;
-
+        // accumulation and animation rendering, scheduled after each frame
+        _accumRendering->on<uvw::TimerEvent>([&](const auto&, auto&) {
             if (_brayns->getEngine().continueRendering() && _brayns->commit())
                 _triggerRendering->send();
+        });
 
-            _accumRendering->stop();
+        // CPU usage, also sampled while idle
+        _statisticsUpdate->on<uvw::TimerEvent>([&](const auto&, auto&) {
+            _brayns->getEngine().getStatistics().setCPUUsage(
+                _cpuUsage.sample());
         });
     }
 
+    /**
+     * Schedule the next frame if accumulation has not converged or an
+     * animation is playing, after a delay following the last event to keep
+     * interactions responsive. Otherwise nothing is scheduled and the main
+     * loop sleeps until the next event.
+     */
+    void _scheduleAccumRendering()
+    {
+        if (!_brayns->getEngine().continueRendering())
+            return;
+
+        using ms = std::chrono::milliseconds;
+        const auto remaining =
+            _idleRenderingDelay - _timeSinceLastEvent.elapsed();
+        _accumRendering->start(ms(std::max<int64_t>(0, remaining * 1000)),
+                               ms(0));
+    }
+
     void _setupRenderThread()
     {
         // rendering, triggered from main thread
@@ -152,7 +172,7 @@ private:
         _renderingDone->close();
         _eventRendering->close();
         _accumRendering->close();
-        _checkIdleRendering->close();
+        _statisticsUpdate->close();
         _sigintHandle->close();
 
         _mainLoop->stop();
@@ -170,8 +190,8 @@ private:
     std::shared_ptr<uvw::Loop> _mainLoop{uvw::Loop::getDefault()};
     std::shared_ptr<uvw::AsyncHandle> _renderingDone;
     std::shared_ptr<uvw::IdleHandle> _eventRendering;
-    std::shared_ptr<uvw::IdleHandle> _accumRendering;
-    std::shared_ptr<uvw::CheckHandle> _checkIdleRendering;
+    std::shared_ptr<uvw::TimerHandle> _accumRendering;
+    std::shared_ptr<uvw::TimerHandle> _statisticsUpdate;
     std::shared_ptr<uvw::SignalHandle> _sigintHandle;
 
     std::shared_ptr<uvw::Loop> _renderLoop{uvw::Loop::create()};
@@ -180,6 +200,7 @@ private:
 
     const float _idleRenderingDelay{0.1f};
     brayns::Timer _timeSinceLastEvent;
+    brayns::CPUUsage _cpuUsage;
 };
 
 int main(int argc, const char** argv)
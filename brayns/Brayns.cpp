@@ -23,6 +23,7 @@
 #include "EngineFactory.h"
 #include "PluginManager.h"
 
+#include <brayns/common/FrameLimiter.h>
 #include <brayns/common/PropertyMap.h>
 #include <brayns/common/Timer.h>
 #include <brayns/common/input/KeyboardHandler.h>
@@ -56,7 +57,9 @@
 
 #include <brayns/pluginapi/PluginAPI.h>
 
-#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 namespace
 {
@@ -128,10 +131,43 @@ struct Brayns::Impl : public PluginAPI
 
     bool commit()
     {
-        std::unique_lock<std::mutex> lock{_renderMutex, std::defer_lock};
-        if (!lock.try_lock())
-            return false;
+        // A commit during rendering is not lost: the changes stay on the
+        // objects and postRender() triggers a new commit at the frame boundary
+        {
+            std::lock_guard<std::mutex> lock(_frameMutex);
+            if (_frameState != FrameState::idle)
+            {
+                _commitPending = true;
+                return false;
+            }
+            _frameState = FrameState::committing;
+            _commitPending = false;
+        }
+
+        try
+        {
+            _commit();
+        }
+        catch (...)
+        {
+            _setFrameIdle();
+            throw;
+        }
+        _setFrameIdle();
+        return true;
+    }
 
+    void _setFrameIdle()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_frameMutex);
+            _frameState = FrameState::idle;
+        }
+        _frameIdle.notify_all();
+    }
+
+    void _commit()
+    {
         _pluginManager.preRender();
 
         auto& scene = _engine->getScene();
@@ -148,18 +184,41 @@ struct Brayns::Impl : public PluginAPI
             lightManager.addLight(_sunLight);
         }
 
+        // Levels of detail are selected from the projected size of the models
+        const auto windowSize =
+            _parametersManager.getApplicationParameters().getWindowSize();
+        const auto fovy = camera.getPropertyOrValue<double>("fovy", 0.);
+        scene.setLODViewpoint(camera.getPosition(),
+                              fovy > 0. ? windowSize.y /
+                                              (2. * std::tan(glm::radians(
+                                                        fovy / 2.)))
+                                        : 0.);
+
+        // Paged volumes load the bricks in view and the instances out of view
+        // can be culled, other cameras see everything
+        const auto frustum =
+            fovy > 0. ? Frustum(camera.getPosition(), camera.getOrientation(),
+                                fovy, double(windowSize.x) / windowSize.y)
+                      : Frustum();
+        scene.setViewFrustum(frustum);
+
+        const auto& gp = _parametersManager.getGeometryParameters();
+        if (gp.getOcclusionCulling())
+            scene.setOcclusionMap(_createOcclusionMap(frustum, fovy));
+
         scene.commit();
 
         _engine->getStatistics().setSceneSizeInBytes(scene.getSizeInBytes());
+        const auto loaderCacheStats = scene.getLoaderCache().getStats();
+        _engine->getStatistics().setLoaderCacheStats(
+            loaderCacheStats.hits, loaderCacheStats.misses,
+            loaderCacheStats.savedMilliseconds);
 
         _parametersManager.getAnimationParameters().update();
 
         auto& renderer = _engine->getRenderer();
         renderer.setCurrentType(rp.getCurrentRenderer());
 
-        const auto windowSize =
-            _parametersManager.getApplicationParameters().getWindowSize();
-
         if (camera.hasProperty("aspect"))
         {
             camera.updateProperty("aspect",
@@ -187,28 +246,36 @@ struct Brayns::Impl : public PluginAPI
         scene.resetModified();
         renderer.resetModified();
         lightManager.resetModified();
-
-        return true;
     }
 
     void render()
     {
-        std::lock_guard<std::mutex> lock{_renderMutex};
+        const auto& params = _parametersManager.getApplicationParameters();
+        _frameLimiter.waitForNextFrame(params.getMaxRenderFPS());
 
-        _renderTimer.start();
-        _engine->render();
-        _renderTimer.stop();
-        _lastFPS = _renderTimer.perSecondSmoothed();
+        // A commit may load data or build acceleration structures, the
+        // frame waits for it to finish
+        {
+            std::unique_lock<std::mutex> lock(_frameMutex);
+            _frameIdle.wait(lock, [this] {
+                return _frameState == FrameState::idle;
+            });
+            _frameState = FrameState::rendering;
+        }
 
-        const auto& params = _parametersManager.getApplicationParameters();
-        const auto fps = params.getMaxRenderFPS();
-        const auto delta = _lastFPS - fps;
-        if (delta > 0)
+        try
+        {
+            _renderTimer.start();
+            _engine->render();
+            _renderTimer.stop();
+        }
+        catch (...)
         {
-            const int64_t targetTime = (1. / fps) * 1000.f;
-            std::this_thread::sleep_for(std::chrono::milliseconds(
-                targetTime - _renderTimer.milliseconds()));
+            _setFrameIdle();
+            throw;
         }
+        _lastFPS = _renderTimer.perSecondSmoothed();
+        _setFrameIdle();
     }
 
     void postRender(RenderOutput* output)
@@ -224,6 +291,14 @@ struct Brayns::Impl : public PluginAPI
 
         _engine->resetFrameBuffers();
         _engine->getStatistics().resetModified();
+
+        bool commitPending = false;
+        {
+            std::lock_guard<std::mutex> lock(_frameMutex);
+            std::swap(commitPending, _commitPending);
+        }
+        if (commitPending)
+            _engine->triggerRender();
     }
 
     bool commit(const RenderInput& renderInput)
@@ -236,6 +311,27 @@ struct Brayns::Impl : public PluginAPI
         return commit();
     }
 
+    OcclusionMap _createOcclusionMap(const Frustum& frustum, const double fovy)
+    {
+        // The depth of the previous frame is only valid for the same view, the
+        // hidden instances are culled once the camera stopped moving
+        const bool sameView =
+            !frustum.isUnbounded() && frustum == _renderedFrustum;
+        _renderedFrustum = frustum;
+
+        auto& frameBuffer = _engine->getFrameBuffer();
+        if (!sameView || frameBuffer.numAccumFrames() == 0)
+            return {};
+
+        frameBuffer.map();
+        const auto& camera = _engine->getCamera();
+        OcclusionMap occlusionMap(frameBuffer.getDepthBuffer(),
+                                  frameBuffer.getSize(), camera.getPosition(),
+                                  camera.getOrientation(), fovy);
+        frameBuffer.unmap();
+        return occlusionMap;
+    }
+
     void _updateRenderOutput(RenderOutput& renderOutput)
     {
         FrameBuffer& frameBuffer = _engine->getFrameBuffer();
@@ -782,14 +878,28 @@ private:
     std::unique_ptr<AbstractManipulator> _cameraManipulator;
     std::vector<FrameBufferPtr> _frameBuffers;
 
-    // protect render() vs commit() when doing all the commits
-    std::mutex _renderMutex;
+    // render() vs commit() handshake, as OSPRay objects cannot be committed
+    // while rendering
+    enum class FrameState
+    {
+        idle,
+        committing,
+        rendering
+    };
+    std::mutex _frameMutex;
+    std::condition_variable _frameIdle;
+    FrameState _frameState{FrameState::idle};
+    bool _commitPending{false};
 
     Timer _renderTimer;
+    FrameLimiter _frameLimiter;
     std::atomic<double> _lastFPS;
 
     std::shared_ptr<ActionInterface> _actionInterface;
     std::shared_ptr<DirectionalLight> _sunLight;
+
+    // View of the frame in the frame buffer, for occlusion culling
+    Frustum _renderedFrustum;
 };
 
 // -----------------------------------------------------------------------------
@@ -107,13 +107,14 @@ public:
      *
      * @return true if render() is allowed/needed after all states have been
      *         evaluated (accum rendering, data loading, etc.)
-     * @note threadsafe with render()
+     * @note threadsafe with render(); never blocks. A commit during rendering
+     *       returns false and is triggered again by postRender().
      */
     BRAYNS_API bool commit();
 
     /**
      * Render a frame into the current framebuffer.
-     * @note threadsafe with commit()
+     * @note threadsafe with commit(); blocks while a commit is in progress.
      */
     BRAYNS_API void render();
 
@@ -0,0 +1,54 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "FrameLimiter.h"
+
+#include <thread>
+
+namespace brayns
+{
+namespace
+{
+// Sleeping is only accurate to the scheduler granularity, the end of the wait
+// is spent yielding to reach the deadline precisely
+const auto SPIN_DURATION = std::chrono::milliseconds(1);
+}
+
+void FrameLimiter::waitForNextFrame(const double maxFPS)
+{
+    if (maxFPS <= 0.)
+    {
+        _deadline = Clock::now();
+        return;
+    }
+
+    if (Clock::now() < _deadline)
+    {
+        std::this_thread::sleep_until(_deadline - SPIN_DURATION);
+        while (Clock::now() < _deadline)
+            std::this_thread::yield();
+    }
+
+    const auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1. / maxFPS));
+    // Small delays from waking up do not shift the schedule
+    const auto now = Clock::now();
+    const auto frameStart = now - _deadline < SPIN_DURATION ? _deadline : now;
+    _deadline = frameStart + period;
+}
+}
@@ -0,0 +1,47 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <chrono>
+
+namespace brayns
+{
+/**
+ * Paces frames to a maximum frame rate. Frame starts are scheduled on
+ * deadlines one period apart, rather than sleeping for an estimated remainder
+ * after each frame, so the frame rate does not drift with the render time.
+ */
+class FrameLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Wait until the next frame may start, i.e. one period after the start of
+     * the previous frame. A frame started late moves the following deadlines,
+     * no burst of frames is rendered to catch up.
+     *
+     * @param maxFPS the maximum frame rate, 0 for no limit
+     */
+    void waitForNextFrame(double maxFPS);
+
+private:
+    Clock::time_point _deadline{};
+};
+}
@@ -38,10 +38,29 @@ public:
     {
         _updateValue(_sceneSizeInBytes, sceneSizeInBytes);
     }
+    /** Set the hit and miss counts of the loader cache, and the loading time
+     * saved by the hits in milliseconds. */
+    void setLoaderCacheStats(const size_t hits, const size_t misses,
+                             const uint64_t savedMilliseconds)
+    {
+        _updateValue(_loaderCacheHits, hits);
+        _updateValue(_loaderCacheMisses, misses);
+        _updateValue(_loaderCacheSavedMilliseconds, savedMilliseconds);
+    }
+    /** CPU usage of the process in percent of one core. */
+    double getCPUUsage() const { return _cpuUsage; }
+    void setCPUUsage(const double cpuUsage)
+    {
+        _updateValue(_cpuUsage, cpuUsage);
+    }
 
 private:
     double _fps{0.0};
     size_t _sceneSizeInBytes{0};
+    size_t _loaderCacheHits{0};
+    size_t _loaderCacheMisses{0};
+    uint64_t _loaderCacheSavedMilliseconds{0};
+    double _cpuUsage{0.0};
 
     SERIALIZATION_FRIEND(Statistics)
 };
@@ -89,4 +89,21 @@ double Timer::fps() const
 {
     return _fps;
 }
+
+CPUUsage::CPUUsage()
+    : _cpuTime(std::clock())
+    , _time(std::chrono::steady_clock::now())
+{
+}
+
+double CPUUsage::sample()
+{
+    const auto cpuTime = std::clock();
+    const auto time = std::chrono::steady_clock::now();
+    const auto elapsed = std::chrono::duration<double>(time - _time).count();
+    const double used = double(cpuTime - _cpuTime) / CLOCKS_PER_SEC;
+    _cpuTime = cpuTime;
+    _time = time;
+    return elapsed > 0. ? 100. * used / elapsed : 0.;
+}
 }
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <chrono>
+#include <ctime>
 
 namespace brayns
 {
@@ -74,4 +75,21 @@ private:
     clock::time_point _lastFPSTickTime;
     double _fps{0.0};
 };
+
+/** Measures the CPU time used by the process, all threads included. */
+class CPUUsage
+{
+public:
+    CPUUsage();
+
+    /**
+     * @return the CPU usage since the previous call in percent of one core,
+     *         i.e. up to 100 times the number of cores
+     */
+    double sample();
+
+private:
+    std::clock_t _cpuTime;
+    std::chrono::steady_clock::time_point _time;
+};
 }
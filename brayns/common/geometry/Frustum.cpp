@@ -0,0 +1,59 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "Frustum.h"
+
+#include <cmath>
+
+namespace brayns
+{
+Frustum::Frustum(const Vector3d& position, const Quaterniond& orientation,
+                 const double fovy, const double aspect)
+    : _position(position)
+{
+    const auto direction = glm::rotate(orientation, Vector3d(0, 0, -1));
+    const auto up = glm::rotate(orientation, Vector3d(0, 1, 0));
+    const auto right = glm::rotate(orientation, Vector3d(1, 0, 0));
+    const double tanY = std::tan(glm::radians(fovy / 2.));
+    const double tanX = tanY * aspect;
+
+    // A point at depth d along the direction is inside if its distance to the
+    // axis along up (resp. right) is at most d * tanY (resp. d * tanX)
+    for (const auto& normal :
+         {direction, direction * tanY - up, direction * tanY + up,
+          direction * tanX - right, direction * tanX + right})
+    {
+        _planes.emplace_back(normal, -glm::dot(normal, position));
+    }
+}
+
+bool Frustum::intersects(const Boxd& box) const
+{
+    for (const auto& plane : _planes)
+    {
+        // The corner of the box the furthest along the normal
+        const Vector3d normal(plane);
+        const Vector3d corner(normal.x >= 0 ? box.getMax().x : box.getMin().x,
+                              normal.y >= 0 ? box.getMax().y : box.getMin().y,
+                              normal.z >= 0 ? box.getMax().z : box.getMin().z);
+        if (glm::dot(normal, corner) + plane.w < 0)
+            return false;
+    }
+    return true;
+}
+} // namespace brayns
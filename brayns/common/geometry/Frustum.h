@@ -0,0 +1,64 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * The view frustum of a perspective camera, without far plane, used to select
+ * the data to load or to render for the current viewpoint.
+ */
+class Frustum
+{
+public:
+    /** An unbounded frustum, which intersects everything. */
+    Frustum() = default;
+
+    /**
+     * @param position the position of the camera
+     * @param orientation the orientation of the camera, looking along -z
+     * @param fovy the vertical field of view in degrees
+     * @param aspect the ratio of the width to the height of the image
+     */
+    BRAYNS_API Frustum(const Vector3d& position,
+                       const Quaterniond& orientation, double fovy,
+                       double aspect);
+
+    const Vector3d& getPosition() const { return _position; }
+    bool isUnbounded() const { return _planes.empty(); }
+
+    /** @return false if the box is entirely outside of the frustum. */
+    BRAYNS_API bool intersects(const Boxd& box) const;
+
+    bool operator==(const Frustum& rhs) const
+    {
+        return _position == rhs._position && _planes == rhs._planes;
+    }
+    bool operator!=(const Frustum& rhs) const { return !(*this == rhs); }
+
+private:
+    Vector3d _position;
+    // Inward normal in xyz and offset in w, a point p is inside all the
+    // planes if dot(normal, p) + w >= 0
+    std::vector<Vector4d> _planes;
+};
+} // namespace brayns
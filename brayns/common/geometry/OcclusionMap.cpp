@@ -0,0 +1,134 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "OcclusionMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace brayns
+{
+constexpr size_t OcclusionMap::TILE_SIZE;
+
+OcclusionMap::OcclusionMap(const float* depth, const Vector2ui& size,
+                           const Vector3d& position,
+                           const Quaterniond& orientation, const double fovy)
+    : _position(position)
+    , _orientation(orientation)
+    , _frameSize(size)
+{
+    if (!depth || size.x == 0 || size.y == 0)
+        return;
+
+    const double tanY = std::tan(glm::radians(fovy / 2.));
+    _tangents = {tanY * size.x / size.y, tanY};
+
+    // Finest level, from the pixels
+    Vector2ui levelSize((size.x + TILE_SIZE - 1) / TILE_SIZE,
+                        (size.y + TILE_SIZE - 1) / TILE_SIZE);
+    std::vector<float> tiles(levelSize.x * levelSize.y, 0.f);
+    for (size_t y = 0; y < size.y; ++y)
+    {
+        float* row = &tiles[(y / TILE_SIZE) * levelSize.x];
+        for (size_t x = 0; x < size.x; ++x)
+        {
+            float& tile = row[x / TILE_SIZE];
+            tile = std::max(tile, depth[x + y * size.x]);
+        }
+    }
+    _levels.push_back(std::move(tiles));
+    _sizes.push_back(levelSize);
+
+    // Coarser levels, each tile covering 2x2 tiles of the previous one
+    while (levelSize.x > 1 || levelSize.y > 1)
+    {
+        const auto& finer = _levels.back();
+        const auto finerSize = levelSize;
+        levelSize = {(levelSize.x + 1) / 2, (levelSize.y + 1) / 2};
+        std::vector<float> coarser(levelSize.x * levelSize.y, 0.f);
+        for (size_t y = 0; y < finerSize.y; ++y)
+        {
+            for (size_t x = 0; x < finerSize.x; ++x)
+            {
+                float& tile = coarser[x / 2 + (y / 2) * levelSize.x];
+                tile = std::max(tile, finer[x + y * finerSize.x]);
+            }
+        }
+        _levels.push_back(std::move(coarser));
+        _sizes.push_back(levelSize);
+    }
+}
+
+bool OcclusionMap::isOccluded(const Boxd& box) const
+{
+    if (isEmpty())
+        return false;
+
+    // Bounds of the box on the screen, in pixels
+    const auto inverse = glm::inverse(_orientation);
+    Vector2d lower(std::numeric_limits<double>::max());
+    Vector2d upper(-std::numeric_limits<double>::max());
+    for (size_t i = 0; i < 8; ++i)
+    {
+        const Vector3d corner(i & 1 ? box.getMax().x : box.getMin().x,
+                              i & 2 ? box.getMax().y : box.getMin().y,
+                              i & 4 ? box.getMax().z : box.getMin().z);
+        const auto local = glm::rotate(inverse, corner - _position);
+        // The projection is not bounded for corners behind the camera
+        if (local.z >= 0.)
+            return false;
+        const Vector2d screen(local.x / (-local.z * _tangents.x),
+                              local.y / (-local.z * _tangents.y));
+        const auto pixel = (screen + 1.) * 0.5 * Vector2d(_frameSize);
+        lower = glm::min(lower, pixel);
+        upper = glm::max(upper, pixel);
+    }
+
+    // Parts of the box outside of the frame are not visible either
+    lower = glm::max(lower, Vector2d(0.));
+    upper = glm::min(upper, Vector2d(_frameSize) - 1.);
+    if (lower.x > upper.x || lower.y > upper.y)
+        return false;
+
+    // Coarsest level where the box covers at most 2x2 tiles
+    size_t level = 0;
+    Vector2ui first(lower / double(TILE_SIZE));
+    Vector2ui last(upper / double(TILE_SIZE));
+    while (level + 1 < _levels.size() &&
+           (last.x - first.x > 1 || last.y - first.y > 1))
+    {
+        ++level;
+        first /= 2u;
+        last /= 2u;
+    }
+
+    float depth = 0.f;
+    const auto& tiles = _levels[level];
+    const auto& levelSize = _sizes[level];
+    for (size_t y = first.y; y <= last.y; ++y)
+        for (size_t x = first.x; x <= last.x; ++x)
+            depth = std::max(depth, tiles[x + y * levelSize.x]);
+
+    // Distance from the camera to the closest point of the box
+    const auto closest =
+        glm::clamp(_position, box.getMin(), box.getMax()) - _position;
+    return glm::length(closest) > depth;
+}
+} // namespace brayns
@@ -0,0 +1,72 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/types.h>
+
+#include <vector>
+
+namespace brayns
+{
+/**
+ * A coarse hierarchical depth buffer of a frame rendered with a perspective
+ * camera, used to cull the boxes hidden behind the geometry of that frame.
+ *
+ * The test is conservative for opaque geometry: a box is occluded only if the
+ * depth of all the pixels it covers is less than its distance to the camera.
+ */
+class OcclusionMap
+{
+public:
+    /** Size in pixels of the tiles of the finest level. */
+    static constexpr size_t TILE_SIZE = 8;
+
+    /** An empty map, which occludes nothing. */
+    OcclusionMap() = default;
+
+    /**
+     * @param depth the distance to the camera along the primary rays, row by
+     *              row from the bottom of the frame
+     * @param size the size of the frame in pixels
+     * @param position the position of the camera
+     * @param orientation the orientation of the camera, looking along -z
+     * @param fovy the vertical field of view in degrees
+     */
+    BRAYNS_API OcclusionMap(const float* depth, const Vector2ui& size,
+                            const Vector3d& position,
+                            const Quaterniond& orientation, double fovy);
+
+    bool isEmpty() const { return _levels.empty(); }
+
+    /** @return true if the box is hidden in the frame of the map. */
+    BRAYNS_API bool isOccluded(const Boxd& box) const;
+
+private:
+    Vector3d _position;
+    Quaterniond _orientation;
+    Vector2d _tangents;
+    Vector2ui _frameSize;
+
+    // Maximum depth per tile, from the finest level to a single tile
+    std::vector<std::vector<float>> _levels;
+    std::vector<Vector2ui> _sizes;
+};
+} // namespace brayns
@@ -0,0 +1,494 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "TriangleMeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+namespace brayns
+{
+namespace
+{
+// Weight of the planes keeping boundary edges in place
+constexpr double BOUNDARY_WEIGHT = 1000.0;
+
+// Minimum cosine between the normals of a triangle before and after a collapse
+constexpr double MIN_NORMAL_COSINE = 0.2;
+
+// Levels reducing the number of triangles by less than this are not kept
+constexpr double MIN_LEVEL_REDUCTION = 0.9;
+
+/** Symmetric 4x4 matrix of a quadric, stored as its upper triangle. */
+struct Quadric
+{
+    double m[10]{0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    Quadric() = default;
+
+    /** Quadric of the squared distance to the plane n.p + d = 0 */
+    Quadric(const Vector3d& n, const double d, const double weight)
+    {
+        m[0] = weight * n.x * n.x;
+        m[1] = weight * n.x * n.y;
+        m[2] = weight * n.x * n.z;
+        m[3] = weight * n.x * d;
+        m[4] = weight * n.y * n.y;
+        m[5] = weight * n.y * n.z;
+        m[6] = weight * n.y * d;
+        m[7] = weight * n.z * n.z;
+        m[8] = weight * n.z * d;
+        m[9] = weight * d * d;
+    }
+
+    Quadric& operator+=(const Quadric& rhs)
+    {
+        for (size_t i = 0; i < 10; ++i)
+            m[i] += rhs.m[i];
+        return *this;
+    }
+
+    double error(const Vector3d& p) const
+    {
+        return m[0] * p.x * p.x + 2 * m[1] * p.x * p.y +
+               2 * m[2] * p.x * p.z + 2 * m[3] * p.x + m[4] * p.y * p.y +
+               2 * m[5] * p.y * p.z + 2 * m[6] * p.y + m[7] * p.z * p.z +
+               2 * m[8] * p.z + m[9];
+    }
+
+    /** Position minimizing the error, false if the system is singular */
+    bool minimum(Vector3d& p) const
+    {
+        const double det = m[0] * (m[4] * m[7] - m[5] * m[5]) -
+                           m[1] * (m[1] * m[7] - m[5] * m[2]) +
+                           m[2] * (m[1] * m[5] - m[4] * m[2]);
+        const double scale = m[0] + m[4] + m[7];
+        if (std::abs(det) <= 1e-12 * scale * scale * scale)
+            return false;
+
+        const Vector3d b(-m[3], -m[6], -m[8]);
+        p.x = (b.x * (m[4] * m[7] - m[5] * m[5]) -
+               m[1] * (b.y * m[7] - m[5] * b.z) +
+               m[2] * (b.y * m[5] - m[4] * b.z)) /
+              det;
+        p.y = (m[0] * (b.y * m[7] - m[5] * b.z) -
+               b.x * (m[1] * m[7] - m[5] * m[2]) +
+               m[2] * (m[1] * b.z - b.y * m[2])) /
+              det;
+        p.z = (m[0] * (m[4] * b.z - b.y * m[5]) -
+               m[1] * (m[1] * b.z - b.y * m[2]) +
+               b.x * (m[1] * m[5] - m[4] * m[2])) /
+              det;
+        return true;
+    }
+};
+
+Quadric operator+(Quadric lhs, const Quadric& rhs)
+{
+    lhs += rhs;
+    return lhs;
+}
+
+struct Collapse
+{
+    double cost;
+    uint32_t v0;
+    uint32_t v1;
+    uint32_t stamp0;
+    uint32_t stamp1;
+    Vector3d position;
+
+    bool operator>(const Collapse& rhs) const { return cost > rhs.cost; }
+};
+
+uint64_t edgeKey(const uint32_t a, const uint32_t b)
+{
+    return (uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+}
+
+class Simplifier
+{
+public:
+    explicit Simplifier(const TriangleMesh& mesh)
+        : _hasNormals(!mesh.normals.empty() &&
+                      mesh.normals.size() == mesh.vertices.size())
+        , _hasColors(!mesh.colors.empty() &&
+                     mesh.colors.size() == mesh.vertices.size())
+        , _hasTextureCoordinates(!mesh.textureCoordinates.empty() &&
+                                 mesh.textureCoordinates.size() ==
+                                     mesh.vertices.size())
+    {
+        _weld(mesh);
+        _computeQuadrics();
+    }
+
+    TriangleMesh simplify(const size_t nbTriangles)
+    {
+        std::priority_queue<Collapse, std::vector<Collapse>,
+                            std::greater<Collapse>>
+            queue;
+        for (uint32_t t = 0; t < _triangles.size(); ++t)
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const auto a = _triangles[t][i];
+                const auto b = _triangles[t][(i + 1) % 3];
+                if (a < b || _isBoundary(a, b))
+                    queue.push(_createCollapse(a, b));
+            }
+
+        while (_nbTriangles > nbTriangles && !queue.empty())
+        {
+            const auto collapse = queue.top();
+            queue.pop();
+
+            if (_stamps[collapse.v0] != collapse.stamp0 ||
+                _stamps[collapse.v1] != collapse.stamp1)
+                continue;
+
+            if (_flips(collapse.v0, collapse.v1, collapse.position) ||
+                _flips(collapse.v1, collapse.v0, collapse.position))
+                continue;
+
+            _collapse(collapse.v0, collapse.v1, collapse.position);
+
+            for (const auto neighbour : _getNeighbours(collapse.v0))
+                queue.push(_createCollapse(collapse.v0, neighbour));
+        }
+
+        return _createMesh();
+    }
+
+private:
+    void _weld(const TriangleMesh& mesh)
+    {
+        struct Hash
+        {
+            size_t operator()(const Vector3f& v) const
+            {
+                const std::hash<float> hash;
+                return hash(v.x) ^ (hash(v.y) << 1) ^ (hash(v.z) << 2);
+            }
+        };
+        std::unordered_map<Vector3f, uint32_t, Hash> welded;
+        std::vector<uint32_t> remap(mesh.vertices.size());
+        for (size_t i = 0; i < mesh.vertices.size(); ++i)
+        {
+            const auto& vertex = mesh.vertices[i];
+            const auto it = welded.find(vertex);
+            if (it != welded.end())
+            {
+                remap[i] = it->second;
+                continue;
+            }
+            const auto index = static_cast<uint32_t>(_positions.size());
+            welded.emplace(vertex, index);
+            remap[i] = index;
+            _positions.push_back(Vector3d(vertex));
+            if (_hasNormals)
+                _normals.push_back(mesh.normals[i]);
+            if (_hasColors)
+                _colors.push_back(mesh.colors[i]);
+            if (_hasTextureCoordinates)
+                _textureCoordinates.push_back(mesh.textureCoordinates[i]);
+        }
+
+        _triangles.reserve(mesh.indices.size());
+        for (const auto& index : mesh.indices)
+        {
+            const Vector3ui triangle(remap[index.x], remap[index.y],
+                                     remap[index.z]);
+            if (triangle.x == triangle.y || triangle.y == triangle.z ||
+                triangle.x == triangle.z)
+                continue;
+            _triangles.push_back(triangle);
+        }
+        _nbTriangles = _triangles.size();
+        _removed.resize(_triangles.size(), false);
+        _stamps.resize(_positions.size(), 0);
+
+        _vertexTriangles.resize(_positions.size());
+        for (uint32_t t = 0; t < _triangles.size(); ++t)
+            for (size_t i = 0; i < 3; ++i)
+                _vertexTriangles[_triangles[t][i]].push_back(t);
+    }
+
+    void _computeQuadrics()
+    {
+        _quadrics.resize(_positions.size());
+        for (const auto& triangle : _triangles)
+            for (size_t i = 0; i < 3; ++i)
+                ++_edgeCounts[edgeKey(triangle[i], triangle[(i + 1) % 3])];
+
+        for (const auto& triangle : _triangles)
+        {
+            const auto& p0 = _positions[triangle.x];
+            const auto& p1 = _positions[triangle.y];
+            const auto& p2 = _positions[triangle.z];
+            const auto cross = glm::cross(p1 - p0, p2 - p0);
+            const auto length = glm::length(cross);
+            if (length == 0.0)
+                continue;
+            const auto normal = cross / length;
+            const Quadric quadric(normal, -glm::dot(normal, p0), 1.0);
+            for (size_t i = 0; i < 3; ++i)
+                _quadrics[triangle[i]] += quadric;
+
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const auto a = triangle[i];
+                const auto b = triangle[(i + 1) % 3];
+                if (!_isBoundary(a, b))
+                    continue;
+                const auto edge = _positions[b] - _positions[a];
+                const auto edgeNormal = glm::cross(edge, normal);
+                const auto edgeNormalLength = glm::length(edgeNormal);
+                if (edgeNormalLength == 0.0)
+                    continue;
+                const auto n = edgeNormal / edgeNormalLength;
+                const Quadric boundary(n, -glm::dot(n, _positions[a]),
+                                       BOUNDARY_WEIGHT);
+                _quadrics[a] += boundary;
+                _quadrics[b] += boundary;
+            }
+        }
+    }
+
+    bool _isBoundary(const uint32_t a, const uint32_t b) const
+    {
+        const auto it = _edgeCounts.find(edgeKey(a, b));
+        return it != _edgeCounts.end() && it->second == 1;
+    }
+
+    Collapse _createCollapse(const uint32_t v0, const uint32_t v1) const
+    {
+        const auto quadric = _quadrics[v0] + _quadrics[v1];
+        const auto& p0 = _positions[v0];
+        const auto& p1 = _positions[v1];
+
+        // Fall back to the end points and the middle of the edge if the
+        // optimal position is undefined or far away from the edge
+        Vector3d position = 0.5 * (p0 + p1);
+        double cost = quadric.error(position);
+        for (const auto& candidate : {p0, p1})
+        {
+            const auto error = quadric.error(candidate);
+            if (error < cost)
+            {
+                cost = error;
+                position = candidate;
+            }
+        }
+        Vector3d optimum;
+        if (quadric.minimum(optimum) &&
+            glm::length(optimum - 0.5 * (p0 + p1)) <= glm::length(p1 - p0))
+        {
+            const auto error = quadric.error(optimum);
+            if (error < cost)
+            {
+                cost = error;
+                position = optimum;
+            }
+        }
+        return {std::max(cost, 0.0), v0, v1, _stamps[v0], _stamps[v1],
+                position};
+    }
+
+    /** @return true if moving v to p flips a triangle not shared with other */
+    bool _flips(const uint32_t v, const uint32_t other, const Vector3d& p) const
+    {
+        for (const auto t : _vertexTriangles[v])
+        {
+            if (_removed[t])
+                continue;
+            const auto& triangle = _triangles[t];
+            if (triangle.x == other || triangle.y == other ||
+                triangle.z == other)
+                continue;
+
+            Vector3d before[3];
+            Vector3d after[3];
+            for (size_t i = 0; i < 3; ++i)
+            {
+                before[i] = _positions[triangle[i]];
+                after[i] = triangle[i] == v ? p : before[i];
+            }
+            const auto n0 =
+                glm::cross(before[1] - before[0], before[2] - before[0]);
+            const auto n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+            const auto l0 = glm::length(n0);
+            const auto l1 = glm::length(n1);
+            if (l0 > 0.0 &&
+                (l1 == 0.0 || glm::dot(n0, n1) < MIN_NORMAL_COSINE * l0 * l1))
+                return true;
+        }
+        return false;
+    }
+
+    void _collapse(const uint32_t v0, const uint32_t v1, const Vector3d& p)
+    {
+        // Interpolate the attributes at the projection of p on the edge
+        const auto edge = _positions[v1] - _positions[v0];
+        const auto length2 = glm::dot(edge, edge);
+        const float t =
+            length2 > 0.0
+                ? glm::clamp(glm::dot(p - _positions[v0], edge) / length2, 0.0,
+                             1.0)
+                : 0.f;
+        if (_hasNormals)
+        {
+            const auto normal = glm::mix(_normals[v0], _normals[v1], t);
+            const auto length = glm::length(normal);
+            if (length > 0.f)
+                _normals[v0] = normal / length;
+        }
+        if (_hasColors)
+            _colors[v0] = glm::mix(_colors[v0], _colors[v1], t);
+        if (_hasTextureCoordinates)
+            _textureCoordinates[v0] =
+                glm::mix(_textureCoordinates[v0], _textureCoordinates[v1], t);
+
+        _positions[v0] = p;
+        _quadrics[v0] += _quadrics[v1];
+
+        for (const auto t1 : _vertexTriangles[v1])
+        {
+            if (_removed[t1])
+                continue;
+            auto& triangle = _triangles[t1];
+            if (triangle.x == v0 || triangle.y == v0 || triangle.z == v0)
+            {
+                _removed[t1] = true;
+                --_nbTriangles;
+                continue;
+            }
+            for (size_t i = 0; i < 3; ++i)
+                if (triangle[i] == v1)
+                    triangle[i] = v0;
+            _vertexTriangles[v0].push_back(t1);
+        }
+        _vertexTriangles[v1].clear();
+
+        auto& triangles = _vertexTriangles[v0];
+        triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
+                                       [&](const uint32_t t0) {
+                                           return _removed[t0];
+                                       }),
+                        triangles.end());
+
+        ++_stamps[v0];
+        // Invalidate all the pending collapses of the removed vertex
+        ++_stamps[v1];
+    }
+
+    std::vector<uint32_t> _getNeighbours(const uint32_t v) const
+    {
+        std::vector<uint32_t> neighbours;
+        for (const auto t : _vertexTriangles[v])
+            for (size_t i = 0; i < 3; ++i)
+                if (_triangles[t][i] != v)
+                    neighbours.push_back(_triangles[t][i]);
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()),
+                         neighbours.end());
+        return neighbours;
+    }
+
+    TriangleMesh _createMesh() const
+    {
+        TriangleMesh mesh;
+        std::vector<uint32_t> remap(_positions.size(),
+                                    std::numeric_limits<uint32_t>::max());
+        mesh.indices.reserve(_nbTriangles);
+        for (uint32_t t = 0; t < _triangles.size(); ++t)
+        {
+            if (_removed[t])
+                continue;
+            Vector3ui triangle;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const auto v = _triangles[t][i];
+                if (remap[v] == std::numeric_limits<uint32_t>::max())
+                {
+                    remap[v] = static_cast<uint32_t>(mesh.vertices.size());
+                    mesh.vertices.push_back(Vector3f(_positions[v]));
+                    if (_hasNormals)
+                        mesh.normals.push_back(_normals[v]);
+                    if (_hasColors)
+                        mesh.colors.push_back(_colors[v]);
+                    if (_hasTextureCoordinates)
+                        mesh.textureCoordinates.push_back(
+                            _textureCoordinates[v]);
+                }
+                triangle[i] = remap[v];
+            }
+            mesh.indices.push_back(triangle);
+        }
+        return mesh;
+    }
+
+    const bool _hasNormals;
+    const bool _hasColors;
+    const bool _hasTextureCoordinates;
+
+    std::vector<Vector3d> _positions;
+    Vector3fs _normals;
+    Vector4fs _colors;
+    std::vector<Vector2f> _textureCoordinates;
+    std::vector<Quadric> _quadrics;
+    std::vector<uint32_t> _stamps;
+
+    std::vector<Vector3ui> _triangles;
+    std::vector<bool> _removed;
+    size_t _nbTriangles{0};
+
+    std::vector<std::vector<uint32_t>> _vertexTriangles;
+    std::unordered_map<uint64_t, uint32_t> _edgeCounts;
+};
+} // namespace
+
+TriangleMesh simplifyMesh(const TriangleMesh& mesh, const size_t nbTriangles)
+{
+    if (mesh.indices.size() <= nbTriangles)
+        return mesh;
+    return Simplifier(mesh).simplify(nbTriangles);
+}
+
+std::vector<TriangleMesh> createLODs(const TriangleMesh& mesh,
+                                     const size_t nbLevels,
+                                     const double reduction)
+{
+    std::vector<TriangleMesh> levels;
+    const TriangleMesh* previous = &mesh;
+    for (size_t level = 0; level < nbLevels; ++level)
+    {
+        const auto nbTriangles = previous->indices.size();
+        auto simplified =
+            simplifyMesh(*previous, static_cast<size_t>(nbTriangles * reduction));
+        if (simplified.indices.empty() ||
+            simplified.indices.size() > MIN_LEVEL_REDUCTION * nbTriangles)
+            break;
+        levels.push_back(std::move(simplified));
+        previous = &levels.back();
+    }
+    return levels;
+}
+} // namespace brayns
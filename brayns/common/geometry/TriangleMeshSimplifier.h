@@ -0,0 +1,46 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/geometry/TriangleMesh.h>
+
+namespace brayns
+{
+/**
+ * Simplify the given mesh by collapsing the edges of lowest quadric error
+ * (Garland & Heckbert) until it has at most the given number of triangles.
+ * Vertices sharing the same position are welded first, boundary edges are
+ * constrained to stay in place and collapses which would flip a triangle are
+ * rejected. Normals, colors and texture coordinates are interpolated along the
+ * collapsed edges.
+ *
+ * @return the simplified mesh, which has more triangles than requested if no
+ *         further edge could be collapsed
+ */
+TriangleMesh simplifyMesh(const TriangleMesh& mesh, size_t nbTriangles);
+
+/**
+ * Create a chain of increasingly coarse versions of the given mesh, each level
+ * keeping the given fraction of the triangles of the previous one. The chain
+ * stops early when a level cannot be reduced further.
+ */
+std::vector<TriangleMesh> createLODs(const TriangleMesh& mesh, size_t nbLevels,
+                                     double reduction);
+} // namespace brayns
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <brayns/common/PropertyMap.h>
+#include <brayns/common/macros.h>
 #include <brayns/common/types.h>
 
 #include <functional>
@@ -66,6 +67,29 @@ public:
     CallbackFn _callback;
 };
 
+/**
+ * Receives the data of a blob in consecutive chunks while it is transferred, so
+ * loaders can parse incrementally instead of waiting for the complete blob.
+ */
+class LoaderStream
+{
+public:
+    virtual ~LoaderStream() = default;
+
+    /**
+     * Process the next chunk of data. Chunks are appended in order, but may be
+     * split at arbitrary positions.
+     */
+    virtual void append(const uint8_t* data, size_t size) = 0;
+
+    /**
+     * Called once all chunks were appended.
+     *
+     * @return the model that has been created by the loader
+     */
+    virtual ModelDescriptorPtr finish() = 0;
+};
+
 /**
  * A base class for data loaders to unify loading data from blobs and files, and
  * provide progress feedback.
@@ -118,12 +142,44 @@ public:
         const std::string& filename, const LoaderProgress& callback,
         const PropertyMap& properties) const = 0;
 
+    /**
+     * Create a stream to import data which is received in chunks, e.g. from a
+     * websocket upload.
+     *
+     * @param type the file extension or type of the data to import
+     * @param name the name of the data to import
+     * @param size the total size in bytes that will be appended to the stream
+     * @param callback Callback for loader progress
+     * @param properties Properties used for loading
+     * @return the stream, or nullptr if the loader does not support streaming,
+     *         in which case the complete blob is passed to importFromBlob()
+     */
+    virtual LoaderStreamPtr createStream(
+        const std::string& type BRAYNS_UNUSED,
+        const std::string& name BRAYNS_UNUSED, const size_t size BRAYNS_UNUSED,
+        const LoaderProgress& callback BRAYNS_UNUSED,
+        const PropertyMap& properties BRAYNS_UNUSED) const
+    {
+        return nullptr;
+    }
+
     /**
      * Query the loader if it can load the given file
      */
     virtual bool isSupported(const std::string& filename,
                              const std::string& extension) const = 0;
 
+    /**
+     * @return true if the model imported from the given file only depends on
+     *         this file and the loader properties, so that the loader cache
+     *         can store it. Loaders reading other files, e.g. the morphologies
+     *         of a circuit, return false.
+     */
+    virtual bool isCacheable(const std::string& filename BRAYNS_UNUSED) const
+    {
+        return true;
+    }
+
 protected:
     Scene& _scene;
 };
@@ -0,0 +1,84 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "SpoolingLoaderStream.h"
+
+#include <brayns/common/utils/filesystem.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace
+{
+const int NO_DESCRIPTOR = -1;
+}
+
+namespace brayns
+{
+SpoolingLoaderStream::SpoolingLoaderStream(const Loader& loader,
+                                           const std::string& extension,
+                                           const LoaderProgress& callback,
+                                           const PropertyMap& properties)
+    : _loader(loader)
+    , _callback(callback)
+    , _properties(properties)
+    , _path((fs::temp_directory_path() / "brayns_spool_XXXXXX").string())
+{
+    const std::string suffix = extension.empty() ? "" : "." + extension;
+    _path += suffix;
+    _fileDescriptor = ::mkstemps(&_path[0], static_cast<int>(suffix.size()));
+    if (_fileDescriptor == NO_DESCRIPTOR)
+        throw std::runtime_error("Could not create temporary file: " +
+                                 std::string(strerror(errno)));
+}
+
+SpoolingLoaderStream::~SpoolingLoaderStream()
+{
+    if (_fileDescriptor != NO_DESCRIPTOR)
+        ::close(_fileDescriptor);
+    ::unlink(_path.c_str());
+}
+
+void SpoolingLoaderStream::append(const uint8_t* data, size_t size)
+{
+    while (size > 0)
+    {
+        const auto written = ::write(_fileDescriptor, data, size);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error("Could not write temporary file " +
+                                     _path + ": " + strerror(errno));
+        }
+        data += written;
+        size -= written;
+    }
+}
+
+ModelDescriptorPtr SpoolingLoaderStream::finish()
+{
+    ::close(_fileDescriptor);
+    _fileDescriptor = NO_DESCRIPTOR;
+    return _loader.importFromFile(_path, _callback, _properties);
+}
+}
@@ -0,0 +1,57 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/loader/Loader.h>
+
+namespace brayns
+{
+/**
+ * A loader stream which spools the received chunks to a temporary file, and
+ * imports that file with Loader::importFromFile() once complete. Meant for
+ * loaders which need random access to their data; the data is never held in
+ * memory as a whole.
+ */
+class SpoolingLoaderStream : public LoaderStream
+{
+public:
+    /**
+     * @param loader the loader to import the spooled file with
+     * @param extension the file extension of the temporary file, for loaders
+     *                  which detect the file type from it
+     * @param callback Callback for loader progress
+     * @param properties Properties used for loading
+     */
+    SpoolingLoaderStream(const Loader& loader, const std::string& extension,
+                         const LoaderProgress& callback,
+                         const PropertyMap& properties);
+    ~SpoolingLoaderStream();
+
+    void append(const uint8_t* data, size_t size) final;
+    ModelDescriptorPtr finish() final;
+
+private:
+    const Loader& _loader;
+    LoaderProgress _callback;
+    PropertyMap _properties;
+    std::string _path;
+    int _fileDescriptor{-1};
+};
+}
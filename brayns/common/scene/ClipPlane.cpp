@@ -23,5 +23,24 @@
 namespace brayns
 {
 size_t ClipPlane::_nextID = 0;
+
+bool isClipped(const Boxd& box, const ClipPlanes& clipPlanes)
+{
+    for (const auto& clipPlane : clipPlanes)
+    {
+        // The corner of the box the furthest on the visible side
+        const auto& plane = clipPlane->getPlane();
+        const Vector3d corner(plane[0] >= 0 ? box.getMax().x : box.getMin().x,
+                              plane[1] >= 0 ? box.getMax().y : box.getMin().y,
+                              plane[2] >= 0 ? box.getMax().z : box.getMin().z);
+        if (plane[0] * corner.x + plane[1] * corner.y + plane[2] * corner.z +
+                plane[3] <=
+            0)
+        {
+            return true;
+        }
+    }
+    return false;
 }
+} // namespace brayns
 
@@ -55,5 +55,11 @@ private:
     Plane _plane = {{0}};
     SERIALIZATION_FRIEND(ClipPlane);
 };
+
+/**
+ * @return true if the box is entirely on the clipped side of one of the
+ *         planes, i.e. dot(normal, p) + d <= 0 for all its points.
+ */
+BRAYNS_API bool isClipped(const Boxd& box, const ClipPlanes& clipPlanes);
 } // namespace brayns
 #endif // Model_H
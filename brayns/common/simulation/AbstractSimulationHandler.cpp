@@ -19,6 +19,10 @@
 
 #include "AbstractSimulationHandler.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace brayns
 {
 AbstractSimulationHandler::~AbstractSimulationHandler() = default;
@@ -34,11 +38,129 @@ AbstractSimulationHandler& AbstractSimulationHandler::operator=(
     _frameSize = rhs._frameSize;
     _dt = rhs._dt;
     _unit = rhs._unit;
+    _encoding = rhs._encoding;
     _frameData = rhs._frameData;
 
+    _residentFrames = {};
+    _interpolatedData.clear();
+    _interpolatedPosition = -1;
+    _encodedData.clear();
+
     return *this;
 }
 
+namespace
+{
+template <typename T>
+void _quantize(const float* __restrict in, const size_t size,
+               const Vector2d& range, T* __restrict out)
+{
+    constexpr float maxValue = std::numeric_limits<T>::max();
+    const float minimum = range.x;
+    const float extent = range.y - range.x;
+    const float scale = extent > 0.f ? maxValue / extent : 0.f;
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i)
+    {
+        const float value = std::max(0.f, (in[i] - minimum) * scale);
+        out[i] = static_cast<T>(std::min(value, maxValue) + .5f);
+    }
+}
+} // namespace
+
+size_t AbstractSimulationHandler::getBytesPerValue(
+    const SimulationDataEncoding encoding)
+{
+    switch (encoding)
+    {
+    case SimulationDataEncoding::uint16:
+        return sizeof(uint16_t);
+    case SimulationDataEncoding::uint8:
+        return sizeof(uint8_t);
+    default:
+        return sizeof(float);
+    }
+}
+
+const void* AbstractSimulationHandler::encodeFrameData(const float* data,
+                                                       const Vector2d& range)
+{
+    switch (_encoding)
+    {
+    case SimulationDataEncoding::uint16:
+        _encodedData.resize(_frameSize * sizeof(uint16_t));
+        _quantize(data, _frameSize, range,
+                  reinterpret_cast<uint16_t*>(_encodedData.data()));
+        return _encodedData.data();
+    case SimulationDataEncoding::uint8:
+        _encodedData.resize(_frameSize);
+        _quantize(data, _frameSize, range, _encodedData.data());
+        return _encodedData.data();
+    default:
+        return data;
+    }
+}
+
+void* AbstractSimulationHandler::getInterpolatedFrameData(
+    const double position)
+{
+    const auto first = static_cast<uint32_t>(std::floor(position));
+    const float weight = position - first;
+    const auto boundedFirst = _getBoundedFrame(first);
+    if (weight == 0.f || _nbFrames < 2)
+    {
+        for (auto& resident : _residentFrames)
+        {
+            if (resident.frame == boundedFirst)
+            {
+                _interpolatedPosition = boundedFirst;
+                return resident.data.data();
+            }
+        }
+        _interpolatedPosition = -1;
+        return getFrameData(first);
+    }
+
+    // The last frame is not blended with the first one when looping
+    const auto second = std::min(boundedFirst + 1, _nbFrames - 1);
+    const auto from = _getResidentFrame(boundedFirst, second);
+    const auto to = from ? _getResidentFrame(second, boundedFirst) : nullptr;
+    if (!from || !to || from->size() != to->size())
+        return nullptr;
+
+    const auto size = from->size();
+    _interpolatedData.resize(size);
+    const float* __restrict a = from->data();
+    const float* __restrict b = to->data();
+    float* __restrict out = _interpolatedData.data();
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i)
+        out[i] = a[i] + weight * (b[i] - a[i]);
+
+    _interpolatedPosition = boundedFirst + weight;
+    return out;
+}
+
+const floats* AbstractSimulationHandler::_getResidentFrame(
+    const uint32_t frame, const uint32_t neighbour)
+{
+    for (const auto& resident : _residentFrames)
+        if (resident.frame == frame)
+            return &resident.data;
+
+    // Frames are loaded by the concrete handlers, possibly asynchronously
+    auto data = static_cast<const float*>(getFrameData(frame));
+    if (!data || _currentFrame != frame)
+        return nullptr;
+
+    // Keep the neighbour, whether playing forward or backward
+    auto& resident =
+        _residentFrames[_residentFrames[0].frame == neighbour ? 1 : 0];
+    resident.frame = frame;
+    resident.data.assign(data, data + _frameSize);
+    return &resident.data;
+}
+
 uint32_t AbstractSimulationHandler::_getBoundedFrame(const uint32_t frame) const
 {
     return _nbFrames == 0 ? frame : frame % _nbFrames;
@@ -23,6 +23,8 @@
 #include <brayns/api.h>
 #include <brayns/common/types.h>
 
+#include <array>
+
 namespace brayns
 {
 /**
@@ -54,6 +56,47 @@ public:
         return _frameData.data();
     }
 
+    /**
+     * Get the simulation data for a fractional frame position, blended from
+     * the two neighbouring frames. Both frames stay resident, so playing at a
+     * fractional delta reads each frame from the report only once.
+     *
+     * @return the simulation data, or nullptr if one of the neighbouring
+     *         frames is not loaded yet.
+     */
+    void* getInterpolatedFrameData(double position);
+
+    /**
+     * @return the frame position of the data returned by the last call to
+     *         getInterpolatedFrameData(), or the current frame.
+     */
+    double getCurrentFramePosition() const
+    {
+        return _interpolatedPosition >= 0 ? _interpolatedPosition
+                                          : _currentFrame;
+    }
+
+    /**
+     * Set how the frames are stored for the renderers; integer encodings
+     * trade precision for a fraction of the memory and upload bandwidth.
+     */
+    void setEncoding(const SimulationDataEncoding encoding)
+    {
+        _encoding = encoding;
+    }
+    SimulationDataEncoding getEncoding() const { return _encoding; }
+    /** @return the size in bytes of one value with the given encoding. */
+    static size_t getBytesPerValue(SimulationDataEncoding encoding);
+
+    /**
+     * Encode frame data of getFrameSize() values with the current encoding,
+     * normalizing integer encodings to the given value range.
+     *
+     * @return the encoded data, valid until the next call; the given data
+     *         for the float32 encoding.
+     */
+    const void* encodeFrameData(const float* data, const Vector2d& range);
+
     /**
      * @brief getFrameSize return the size of the current simulation frame
      */
@@ -85,13 +128,31 @@ public:
 protected:
     uint32_t _getBoundedFrame(const uint32_t frame) const;
 
+    /**
+     * Make the frame resident in one of the interpolation slots, without
+     * evicting its neighbour.
+     */
+    const floats* _getResidentFrame(uint32_t frame, uint32_t neighbour);
+
     uint32_t _currentFrame{std::numeric_limits<uint32_t>::max()};
     uint32_t _nbFrames{0};
     uint64_t _frameSize{0};
     double _dt{0};
     std::string _unit;
+    SimulationDataEncoding _encoding{SimulationDataEncoding::float32};
 
     floats _frameData;
+
+private:
+    struct ResidentFrame
+    {
+        uint32_t frame{std::numeric_limits<uint32_t>::max()};
+        floats data;
+    };
+    std::array<ResidentFrame, 2> _residentFrames;
+    floats _interpolatedData;
+    double _interpolatedPosition{-1};
+    std::vector<uint8_t> _encodedData;
 };
 }
 #endif // ABSTRACTSIMULATIONHANDLER_H
@@ -119,6 +119,7 @@ using SDFBeziersMap = std::map<size_t, SDFBeziers>;
 
 struct TriangleMesh;
 using TriangleMeshMap = std::map<size_t, TriangleMesh>;
+using TriangleMeshLODs = std::vector<TriangleMeshMap>;
 
 struct StreamlinesData;
 using StreamlinesDataMap = std::map<size_t, StreamlinesData>;
@@ -126,9 +127,11 @@ using StreamlinesDataMap = std::map<size_t, StreamlinesData>;
 class Volume;
 class BrickedVolume;
 class SharedDataVolume;
+class PagedVolume;
 using VolumePtr = std::shared_ptr<Volume>;
 using SharedDataVolumePtr = std::shared_ptr<SharedDataVolume>;
 using BrickedVolumePtr = std::shared_ptr<BrickedVolume>;
+using PagedVolumePtr = std::shared_ptr<PagedVolume>;
 using Volumes = std::vector<VolumePtr>;
 
 class Texture2D;
@@ -232,6 +235,17 @@ enum class MemoryMode
     replicated
 };
 
+/**
+ * Storage of the simulation values uploaded to the renderers. The integer
+ * encodings are normalized to the value range of the transfer function.
+ */
+enum class SimulationDataEncoding
+{
+    float32,
+    uint16,
+    uint8
+};
+
 enum class MaterialsColorMap
 {
     random,         // Random materials including transparency, reflection,
@@ -288,6 +302,8 @@ struct Blob
 
 class Loader;
 using LoaderPtr = std::unique_ptr<Loader>;
+class LoaderStream;
+using LoaderStreamPtr = std::shared_ptr<LoaderStream>;
 
 enum class DataType
 {
@@ -381,5 +397,13 @@ inline std::vector<std::pair<std::string, DataType>> enumMap()
             {"uint32", DataType::UINT32}, {"int8", DataType::INT8},
             {"int16", DataType::INT16},   {"int32", DataType::INT32}};
 }
+
+template <>
+inline std::vector<std::pair<std::string, SimulationDataEncoding>> enumMap()
+{
+    return {{"float32", SimulationDataEncoding::float32},
+            {"uint16", SimulationDataEncoding::uint16},
+            {"uint8", SimulationDataEncoding::uint8}};
+}
 } // namespace brayns
 #endif // TYPES_H
@@ -0,0 +1,55 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace brayns
+{
+MappedFile::MappedFile(const std::string& filename)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw std::runtime_error("Failed to open file " + filename);
+
+    struct stat sb;
+    if (::fstat(fd, &sb) == -1)
+    {
+        ::close(fd);
+        throw std::runtime_error("Failed to open file " + filename);
+    }
+    _size = sb.st_size;
+    void* data = ::mmap(0, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("Failed to map file " + filename);
+    _data = static_cast<const uint8_t*>(data);
+    ::madvise(data, _size, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile()
+{
+    ::munmap((void*)_data, _size);
+}
+} // namespace brayns
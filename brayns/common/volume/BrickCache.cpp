@@ -0,0 +1,238 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "BrickCache.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace brayns
+{
+namespace
+{
+size_t voxelSize(const DataType type)
+{
+    switch (type)
+    {
+    case DataType::UINT8:
+    case DataType::INT8:
+        return 1;
+    case DataType::UINT16:
+    case DataType::INT16:
+        return 2;
+    case DataType::UINT32:
+    case DataType::INT32:
+    case DataType::FLOAT:
+        return 4;
+    case DataType::DOUBLE:
+    default:
+        return 8;
+    }
+}
+} // namespace
+
+constexpr uint32_t BrickCache::BRICK_SIZE;
+constexpr uint32_t BrickCache::COARSE_FACTOR;
+
+BrickCache::BrickCache(const std::string& filename,
+                       const Vector3ui& dimensions, const DataType type,
+                       const size_t memoryBudget)
+    : _dimensions(dimensions)
+    , _voxelSize(voxelSize(type))
+    , _brickBytes(size_t(BRICK_SIZE) * BRICK_SIZE * BRICK_SIZE * _voxelSize)
+    , _maxBricks(memoryBudget / _brickBytes)
+    , _brickCounts((dimensions + BRICK_SIZE - 1u) / BRICK_SIZE)
+    , _coarseDimensions((dimensions + COARSE_FACTOR - 1u) / COARSE_FACTOR)
+{
+    _fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if (_fileDescriptor == -1)
+        throw std::runtime_error("Failed to open volume file " + filename);
+
+    struct stat sb;
+    const size_t size = size_t(dimensions.x) * dimensions.y * dimensions.z;
+    if (::fstat(_fileDescriptor, &sb) == -1 ||
+        size_t(sb.st_size) < size * _voxelSize)
+    {
+        ::close(_fileDescriptor);
+        throw std::runtime_error("Volume file " + filename +
+                                 " is smaller than expected");
+    }
+
+    _bricks.resize(size_t(_brickCounts.x) * _brickCounts.y * _brickCounts.z,
+                   nullptr);
+    try
+    {
+        _readCoarseLevel();
+    }
+    catch (...)
+    {
+        ::close(_fileDescriptor);
+        throw;
+    }
+}
+
+BrickCache::~BrickCache()
+{
+    ::close(_fileDescriptor);
+}
+
+Boxd BrickCache::getBrickBounds(const size_t index) const
+{
+    const Vector3ui brick(index % _brickCounts.x,
+                          (index / _brickCounts.x) % _brickCounts.y,
+                          index / (size_t(_brickCounts.x) * _brickCounts.y));
+    const Vector3ui begin = brick * BRICK_SIZE;
+    const Vector3ui end = glm::min(begin + BRICK_SIZE, _dimensions);
+    return {Vector3d(begin), Vector3d(end)};
+}
+
+bool BrickCache::update(const std::vector<size_t>& bricks,
+                        const size_t maxLoads)
+{
+    // Move the requested resident bricks to the front of the LRU list, the
+    // most important one first
+    const size_t nbRequested = std::min(bricks.size(), _maxBricks);
+    std::vector<size_t> missing;
+    for (size_t i = nbRequested; i-- > 0;)
+    {
+        const auto brick = _resident.find(bricks[i]);
+        if (brick == _resident.end())
+            missing.push_back(bricks[i]);
+        else
+            _lru.splice(_lru.begin(), _lru, brick->second.lru);
+    }
+
+    // The missing bricks are in increasing order of priority
+    _nbPending = missing.size() > maxLoads ? missing.size() - maxLoads : 0;
+    missing.erase(missing.begin(), missing.begin() + _nbPending);
+    if (missing.empty())
+        return false;
+
+    // The requested bricks fit in the budget, so only other ones are evicted
+    while (_resident.size() + missing.size() > _maxBricks)
+    {
+        const auto index = _lru.back();
+        _lru.pop_back();
+        _resident.erase(index);
+        _bricks[index] = nullptr;
+    }
+
+    std::vector<uint8_ts> voxels(missing.size());
+    bool failed = false;
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(missing.size()); ++i)
+    {
+        voxels[i].resize(_brickBytes);
+        if (!_readBrick(missing[i], voxels[i].data()))
+        {
+#pragma omp atomic write
+            failed = true;
+        }
+    }
+    if (failed)
+        throw std::runtime_error("Failed to read volume bricks");
+
+    for (size_t i = 0; i < missing.size(); ++i)
+    {
+        _lru.push_front(missing[i]);
+        auto& brick = _resident[missing[i]];
+        brick.voxels = std::move(voxels[i]);
+        brick.lru = _lru.begin();
+        _bricks[missing[i]] = brick.voxels.data();
+    }
+    return true;
+}
+
+bool BrickCache::_read(uint8_t* data, size_t size, size_t offset) const
+{
+    while (size > 0)
+    {
+        const auto result = ::pread(_fileDescriptor, data, size, offset);
+        if (result <= 0)
+            return false;
+        data += result;
+        size -= result;
+        offset += result;
+    }
+    return true;
+}
+
+void BrickCache::_readCoarseLevel()
+{
+    const size_t rowSize = size_t(_dimensions.x) * _voxelSize;
+    const size_t sliceSize = rowSize * _dimensions.y;
+    const size_t coarseRowSize = size_t(_coarseDimensions.x) * _voxelSize;
+    const int64_t nbRows = int64_t(_coarseDimensions.y) * _coarseDimensions.z;
+    _coarseVoxels.resize(nbRows * coarseRowSize);
+
+    // Only one row out of COARSE_FACTOR^2 is read from the file
+    bool failed = false;
+#pragma omp parallel
+    {
+        uint8_ts row(rowSize);
+#pragma omp for
+        for (int64_t i = 0; i < nbRows; ++i)
+        {
+            const size_t y = (i % _coarseDimensions.y) * COARSE_FACTOR;
+            const size_t z = (i / _coarseDimensions.y) * COARSE_FACTOR;
+            if (!_read(row.data(), rowSize, z * sliceSize + y * rowSize))
+            {
+#pragma omp atomic write
+                failed = true;
+                continue;
+            }
+
+            auto coarseRow = _coarseVoxels.data() + i * coarseRowSize;
+            for (size_t x = 0; x < _coarseDimensions.x; ++x)
+                memcpy(coarseRow + x * _voxelSize,
+                       row.data() + x * COARSE_FACTOR * _voxelSize,
+                       _voxelSize);
+        }
+    }
+    if (failed)
+        throw std::runtime_error("Failed to read the volume coarse level");
+}
+
+bool BrickCache::_readBrick(const size_t index, uint8_t* voxels) const
+{
+    const auto bounds = getBrickBounds(index);
+    const Vector3ui begin(bounds.getMin());
+    const Vector3ui end(bounds.getMax());
+    const size_t rowSize = size_t(end.x - begin.x) * _voxelSize;
+    for (uint32_t z = begin.z; z < end.z; ++z)
+    {
+        for (uint32_t y = begin.y; y < end.y; ++y)
+        {
+            const size_t offset =
+                ((size_t(z) * _dimensions.y + y) * _dimensions.x + begin.x) *
+                _voxelSize;
+            const size_t brickOffset =
+                (size_t(z - begin.z) * BRICK_SIZE + (y - begin.y)) *
+                BRICK_SIZE * _voxelSize;
+            if (!_read(voxels + brickOffset, rowSize, offset))
+                return false;
+        }
+    }
+    return true;
+}
+} // namespace brayns
@@ -0,0 +1,125 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/types.h>
+
+#include <limits>
+#include <list>
+#include <unordered_map>
+
+namespace brayns
+{
+/**
+ * Reads the voxels of a raw volume file on demand, in cubic bricks kept in a
+ * least recently used cache bounded by a memory budget. A coarse level, made
+ * of one voxel out of COARSE_FACTOR along each axis, stays resident to stand
+ * in for the bricks which are not loaded.
+ */
+class BrickCache
+{
+public:
+    /** Number of voxels along each side of a brick, a power of two. */
+    static constexpr uint32_t BRICK_SIZE = 64;
+
+    /** Subsampling factor of the coarse level. */
+    static constexpr uint32_t COARSE_FACTOR = 8;
+
+    /**
+     * Open the given file and read the coarse level from it.
+     *
+     * @param memoryBudget the maximum size in bytes of the resident bricks
+     * @throw std::runtime_error if the file cannot be opened or is too small
+     */
+    BRAYNS_API BrickCache(const std::string& filename,
+                          const Vector3ui& dimensions, DataType type,
+                          size_t memoryBudget);
+    BRAYNS_API ~BrickCache();
+
+    BrickCache(const BrickCache&) = delete;
+    BrickCache& operator=(const BrickCache&) = delete;
+
+    /** @return the number of bricks along each axis. */
+    const Vector3ui& getBrickCounts() const { return _brickCounts; }
+    /** @return the bounds of the given brick, in voxels. */
+    BRAYNS_API Boxd getBrickBounds(size_t index) const;
+
+    /**
+     * @return the voxels of each brick, x varying first within the brick and
+     *         across the bricks, nullptr for the bricks not resident
+     */
+    const std::vector<const void*>& getBricks() const { return _bricks; }
+    const Vector3ui& getCoarseDimensions() const { return _coarseDimensions; }
+    const uint8_ts& getCoarseVoxels() const { return _coarseVoxels; }
+
+    /** @return the size of the coarse level and of the resident bricks. */
+    size_t getSizeInBytes() const
+    {
+        return _coarseVoxels.size() + _resident.size() * _brickBytes;
+    }
+
+    /**
+     * Make the given bricks resident, in decreasing order of priority. The
+     * bricks beyond the memory budget are ignored, the least recently used
+     * bricks are evicted to make room for the missing ones, which are then
+     * read in parallel.
+     *
+     * @param maxLoads the maximum number of bricks read by this update, the
+     *        most important missing ones first
+     * @return true if bricks were loaded or evicted
+     * @throw std::runtime_error if reading the file failed
+     */
+    BRAYNS_API bool update(
+        const std::vector<size_t>& bricks,
+        size_t maxLoads = std::numeric_limits<size_t>::max());
+
+    /**
+     * @return the number of bricks requested by the last update which are
+     *         still missing because of maxLoads
+     */
+    size_t getNbPending() const { return _nbPending; }
+
+private:
+    struct Brick
+    {
+        uint8_ts voxels;
+        std::list<size_t>::iterator lru;
+    };
+
+    bool _read(uint8_t* data, size_t size, size_t offset) const;
+    void _readCoarseLevel();
+    bool _readBrick(size_t index, uint8_t* voxels) const;
+
+    int _fileDescriptor{-1};
+    const Vector3ui _dimensions;
+    const size_t _voxelSize;
+    const size_t _brickBytes;
+    const size_t _maxBricks;
+    Vector3ui _brickCounts;
+    Vector3ui _coarseDimensions;
+    uint8_ts _coarseVoxels;
+    std::vector<const void*> _bricks;
+    size_t _nbPending{0};
+
+    // Most recently used bricks first
+    std::list<size_t> _lru;
+    std::unordered_map<size_t, Brick> _resident;
+};
+} // namespace brayns
@@ -0,0 +1,147 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "MacroCellGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace brayns
+{
+namespace
+{
+template <typename T>
+void _buildRanges(const T* voxels, const Vector3ui& voxelDimensions,
+                  const Vector3ui& dimensions, floats& ranges)
+{
+    const int64_t nbCells =
+        int64_t(dimensions.x) * dimensions.y * dimensions.z;
+    const size_t sliceSize = size_t(voxelDimensions.x) * voxelDimensions.y;
+
+#pragma omp parallel for
+    for (int64_t cell = 0; cell < nbCells; ++cell)
+    {
+        const Vector3ui index(cell % dimensions.x,
+                              (cell / dimensions.x) % dimensions.y,
+                              cell / (size_t(dimensions.x) * dimensions.y));
+        const Vector3ui begin = index * MacroCellGrid::CELL_SIZE;
+        const Vector3ui end =
+            glm::min(begin + MacroCellGrid::CELL_SIZE + 1u, voxelDimensions);
+
+        float minValue = std::numeric_limits<float>::max();
+        float maxValue = std::numeric_limits<float>::lowest();
+        for (uint32_t z = begin.z; z < end.z; ++z)
+        {
+            for (uint32_t y = begin.y; y < end.y; ++y)
+            {
+                const T* row =
+                    voxels + z * sliceSize + size_t(y) * voxelDimensions.x;
+                for (uint32_t x = begin.x; x < end.x; ++x)
+                {
+                    const float value = row[x];
+                    minValue = std::min(minValue, value);
+                    maxValue = std::max(maxValue, value);
+                }
+            }
+        }
+        ranges[2 * cell] = minValue;
+        ranges[2 * cell + 1] = maxValue;
+    }
+}
+} // namespace
+
+constexpr uint32_t MacroCellGrid::CELL_SIZE;
+
+void MacroCellGrid::build(const void* voxels, const Vector3ui& dimensions,
+                          const DataType type)
+{
+    // The last voxel of a cell is the first one of the next cell
+    const auto cells = glm::max(dimensions, Vector3ui(2)) - 2u;
+    _dimensions = cells / CELL_SIZE + 1u;
+    _ranges.resize(2 * size_t(_dimensions.x) * _dimensions.y * _dimensions.z);
+
+    switch (type)
+    {
+    case DataType::FLOAT:
+        _buildRanges(static_cast<const float*>(voxels), dimensions,
+                     _dimensions, _ranges);
+        break;
+    case DataType::DOUBLE:
+        _buildRanges(static_cast<const double*>(voxels), dimensions,
+                     _dimensions, _ranges);
+        break;
+    case DataType::UINT8:
+        _buildRanges(static_cast<const uint8_t*>(voxels), dimensions,
+                     _dimensions, _ranges);
+        break;
+    case DataType::UINT16:
+        _buildRanges(static_cast<const uint16_t*>(voxels), dimensions,
+                     _dimensions, _ranges);
+        break;
+    case DataType::UINT32:
+        _buildRanges(static_cast<const uint32_t*>(voxels), dimensions,
+                     _dimensions, _ranges);
+        break;
+    case DataType::INT8:
+        _buildRanges(static_cast<const int8_t*>(voxels), dimensions,
+                     _dimensions, _ranges);
+        break;
+    case DataType::INT16:
+        _buildRanges(static_cast<const int16_t*>(voxels), dimensions,
+                     _dimensions, _ranges);
+        break;
+    case DataType::INT32:
+        _buildRanges(static_cast<const int32_t*>(voxels), dimensions,
+                     _dimensions, _ranges);
+        break;
+    }
+}
+
+uint8_ts MacroCellGrid::getVisibleCells(const float* ranges,
+                                        const size_t nbCells,
+                                        const float* opacities,
+                                        const size_t nbOpacities,
+                                        const Vector2f& valueRange,
+                                        const float threshold)
+{
+    if (nbOpacities == 0)
+        throw std::runtime_error("Transfer function without opacities");
+
+    // Values outside of the range get the opacity of the closest bound
+    const auto last = nbOpacities - 1;
+    const float extent = valueRange.y - valueRange.x;
+    const float scale = extent > 0.f ? last / extent : 0.f;
+    const auto toIndex = [&](const float value, const bool roundUp) {
+        const float index = (value - valueRange.x) * scale;
+        const float clamped = std::min(std::max(index, 0.f), float(last));
+        return size_t(roundUp ? std::ceil(clamped) : std::floor(clamped));
+    };
+
+    uint8_ts visible(nbCells);
+    for (size_t cell = 0; cell < nbCells; ++cell)
+    {
+        const auto begin = opacities + toIndex(ranges[2 * cell], false);
+        const auto end = opacities + toIndex(ranges[2 * cell + 1], true) + 1;
+        visible[cell] = *std::max_element(begin, end) > threshold;
+    }
+    return visible;
+}
+} // namespace brayns
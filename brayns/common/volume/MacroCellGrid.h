@@ -0,0 +1,74 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#pragma once
+
+#include <brayns/api.h>
+#include <brayns/common/types.h>
+
+namespace brayns
+{
+/**
+ * A coarse grid over the voxels of a volume, storing the value range of each
+ * cell. Cells overlap their neighbours by one voxel, so the range covers all
+ * the voxels interpolated by a sample inside the cell. Renderers skip the
+ * cells where the transfer function is transparent over the whole range.
+ */
+class MacroCellGrid
+{
+public:
+    /** Number of voxels along each side of a cell. */
+    static constexpr uint32_t CELL_SIZE = 16;
+
+    /** Compute the value range of all the cells of the given voxels. */
+    BRAYNS_API void build(const void* voxels, const Vector3ui& dimensions,
+                          DataType type);
+
+    /** @return the number of cells along each axis. */
+    const Vector3ui& getDimensions() const { return _dimensions; }
+    /** @return the minimum and maximum value of each cell, x varying first */
+    const floats& getRanges() const { return _ranges; }
+    bool empty() const { return _ranges.empty(); }
+
+    /**
+     * @return for each cell, 1 if the transfer function has an opacity above
+     *         the threshold somewhere in the value range of the cell, else 0.
+     * @param opacities opacities sampled uniformly over the value range
+     * @param valueRange the value range of the transfer function
+     * @param threshold the opacity below which samples are not rendered
+     */
+    uint8_ts getVisibleCells(const floats& opacities,
+                             const Vector2f& valueRange,
+                             const float threshold) const
+    {
+        return getVisibleCells(_ranges.data(), _ranges.size() / 2,
+                               opacities.data(), opacities.size(), valueRange,
+                               threshold);
+    }
+
+    /** getVisibleCells() for ranges and opacities owned by an engine. */
+    BRAYNS_API static uint8_ts getVisibleCells(
+        const float* ranges, size_t nbCells, const float* opacities,
+        size_t nbOpacities, const Vector2f& valueRange, float threshold);
+
+private:
+    Vector3ui _dimensions;
+    floats _ranges;
+};
+} // namespace brayns
@@ -27,6 +27,14 @@
 
 namespace brayns
 {
+/** A rectangle of the framebuffer in pixels, from its bottom left corner. */
+struct RenderRegion
+{
+    Vector2ui position;
+    Vector2ui size;
+};
+using RenderRegions = std::vector<RenderRegion>;
+
 class FrameBuffer : public BaseObject
 {
 public:
@@ -63,6 +71,14 @@ public:
     virtual void createPixelOp(const std::string& /*name*/){};
     /** Update the current pixelop with the given properties. */
     virtual void updatePixelOp(const PropertyMap& /*properties*/){};
+    /**
+     * Render only the tiles overlapping the given regions, e.g. the displayed
+     * part of the frame; all of it if the regions are empty.
+     */
+    virtual void setRenderRegions(const RenderRegions& regions)
+    {
+        _renderRegions = regions;
+    }
     //@}
 
     BRAYNS_API FrameBuffer(const std::string& name, const Vector2ui& frameSize,
@@ -76,6 +92,7 @@ public:
         return _frameBufferFormat;
     }
     const std::string& getName() const { return _name; }
+    const RenderRegions& getRenderRegions() const { return _renderRegions; }
     void incrementAccumFrames() { ++_accumFrames; }
     size_t numAccumFrames() const { return _accumFrames; }
     freeimage::ImagePtr getImage();
@@ -86,5 +103,6 @@ protected:
     FrameBufferFormat _frameBufferFormat;
     bool _accumulation{true};
     std::atomic_size_t _accumFrames{0};
+    RenderRegions _renderRegions;
 };
 }
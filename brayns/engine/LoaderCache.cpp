@@ -0,0 +1,673 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "LoaderCache.h"
+
+#include <brayns/common/Timer.h>
+#include <brayns/common/log.h>
+#include <brayns/common/utils/filesystem.h>
+#include <brayns/engine/Material.h>
+#include <brayns/engine/Model.h>
+#include <brayns/engine/Scene.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+const std::string CACHE_MAGIC = "brayns-loader-cache";
+const size_t CACHE_VERSION = 2;
+
+template <typename T>
+void write(std::ostream& stream, const T& value)
+{
+    stream.write((const char*)&value, sizeof(T));
+}
+
+void write(std::ostream& stream, const std::string& value)
+{
+    write(stream, value.size());
+    stream.write(value.data(), value.size());
+}
+
+template <typename T>
+void write(std::ostream& stream, const std::vector<T>& values)
+{
+    write(stream, values.size());
+    stream.write((const char*)values.data(), values.size() * sizeof(T));
+}
+
+template <typename T>
+void write(std::ostream& stream, const std::map<size_t, std::vector<T>>& map)
+{
+    write(stream, map.size());
+    for (const auto& i : map)
+    {
+        write(stream, i.first);
+        write(stream, i.second);
+    }
+}
+
+/**
+ * A cache file being read, with the number of bytes left in it. Counts are
+ * checked against it, so a corrupted count neither allocates nor loops beyond
+ * the end of the file.
+ */
+struct Reader
+{
+    std::istream& stream;
+    size_t remaining;
+
+    explicit operator bool() const { return bool(stream); }
+
+    void read(char* data, const size_t size)
+    {
+        stream.read(data, size);
+        remaining -= std::min(remaining, size);
+    }
+};
+
+template <typename T>
+void read(Reader& stream, T& value)
+{
+    stream.read((char*)&value, sizeof(T));
+}
+
+/**
+ * Reads the number of elements that follow in the stream, and checks that the
+ * stream holds at least elementSize bytes per element. A failed stream, e.g. a
+ * missing cache entry, yields no elements.
+ */
+size_t readCount(Reader& stream, const size_t elementSize)
+{
+    size_t count = 0;
+    read(stream, count);
+    if (!stream)
+        return 0;
+
+    if (count > stream.remaining / std::max<size_t>(elementSize, 1))
+        throw std::runtime_error("Corrupted loader cache file");
+    return count;
+}
+
+void read(Reader& stream, std::string& value)
+{
+    const auto size = readCount(stream, 1);
+    value.resize(size);
+    stream.read(&value[0], size);
+}
+
+template <typename T>
+void read(Reader& stream, std::vector<T>& values)
+{
+    const auto size = readCount(stream, sizeof(T));
+    values.resize(size);
+    stream.read((char*)values.data(), size * sizeof(T));
+}
+
+template <typename T>
+void read(Reader& stream, std::map<size_t, std::vector<T>>& map)
+{
+    // Each entry holds at least its material ID and its size
+    const auto size = readCount(stream, 2 * sizeof(size_t));
+    for (size_t i = 0; i < size; ++i)
+    {
+        size_t materialId = 0;
+        read(stream, materialId);
+        read(stream, map[materialId]);
+    }
+}
+
+template <typename T, size_t N>
+std::string toString(const std::array<T, N>& values)
+{
+    std::stringstream stream;
+    stream << std::setprecision(17);
+    for (const auto& value : values)
+        stream << value << " ";
+    return stream.str();
+}
+
+/** @return the property value as a string, to address cache entries. */
+std::string toString(const brayns::Property& property)
+{
+    using Type = brayns::Property::Type;
+    switch (property.type)
+    {
+    case Type::Int:
+        return std::to_string(property.get<int32_t>());
+    case Type::Double:
+        return toString(std::array<double, 1>{{property.get<double>()}});
+    case Type::String:
+        return property.get<std::string>();
+    case Type::Bool:
+        return property.get<bool>() ? "true" : "false";
+    case Type::Vec2i:
+        return toString(property.get<std::array<int32_t, 2>>());
+    case Type::Vec2d:
+        return toString(property.get<std::array<double, 2>>());
+    case Type::Vec3i:
+        return toString(property.get<std::array<int32_t, 3>>());
+    case Type::Vec3d:
+        return toString(property.get<std::array<double, 3>>());
+    case Type::Vec4d:
+        return toString(property.get<std::array<double, 4>>());
+    }
+    return "";
+}
+
+void writeProperty(std::ostream& stream, const brayns::Property& property)
+{
+    using Type = brayns::Property::Type;
+    write(stream, property.name);
+    write(stream, property.type);
+    write(stream, property.metaData.label);
+    write(stream, property.metaData.description);
+    write(stream, property.enums.size());
+    for (const auto& name : property.enums)
+        write(stream, name);
+    switch (property.type)
+    {
+    case Type::Int:
+        write(stream, property.get<int32_t>());
+        break;
+    case Type::Double:
+        write(stream, property.get<double>());
+        break;
+    case Type::String:
+        write(stream, property.get<std::string>());
+        break;
+    case Type::Bool:
+        write(stream, property.get<bool>());
+        break;
+    case Type::Vec2i:
+        write(stream, property.get<std::array<int32_t, 2>>());
+        break;
+    case Type::Vec2d:
+        write(stream, property.get<std::array<double, 2>>());
+        break;
+    case Type::Vec3i:
+        write(stream, property.get<std::array<int32_t, 3>>());
+        break;
+    case Type::Vec3d:
+        write(stream, property.get<std::array<double, 3>>());
+        break;
+    case Type::Vec4d:
+        write(stream, property.get<std::array<double, 4>>());
+        break;
+    }
+}
+
+template <typename T>
+brayns::Property readProperty(Reader& stream, const std::string& name,
+                              const brayns::strings& /*enums*/,
+                              const brayns::Property::MetaData& metaData)
+{
+    T value;
+    read(stream, value);
+    return {name, value, metaData};
+}
+
+template <>
+brayns::Property readProperty<int32_t>(
+    Reader& stream, const std::string& name,
+    const brayns::strings& enums, const brayns::Property::MetaData& metaData)
+{
+    int32_t value = 0;
+    read(stream, value);
+    if (enums.empty())
+        return {name, value, metaData};
+    return {name, value, enums, metaData};
+}
+
+template <>
+brayns::Property readProperty<std::string>(
+    Reader& stream, const std::string& name,
+    const brayns::strings& enums, const brayns::Property::MetaData& metaData)
+{
+    std::string value;
+    read(stream, value);
+    if (enums.empty())
+        return {name, value, metaData};
+    return {name, value, enums, metaData};
+}
+
+brayns::Property readProperty(Reader& stream)
+{
+    using Type = brayns::Property::Type;
+    std::string name, label, description;
+    Type type;
+    read(stream, name);
+    read(stream, type);
+    read(stream, label);
+    read(stream, description);
+    const auto nbEnums = readCount(stream, sizeof(size_t));
+    brayns::strings enums(nbEnums);
+    for (auto& enumName : enums)
+        read(stream, enumName);
+
+    const brayns::Property::MetaData metaData(label, description);
+    switch (type)
+    {
+    case Type::Int:
+        return readProperty<int32_t>(stream, name, enums, metaData);
+    case Type::Double:
+        return readProperty<double>(stream, name, enums, metaData);
+    case Type::String:
+        return readProperty<std::string>(stream, name, enums, metaData);
+    case Type::Bool:
+        return readProperty<bool>(stream, name, enums, metaData);
+    case Type::Vec2i:
+        return readProperty<std::array<int32_t, 2>>(stream, name, enums,
+                                                    metaData);
+    case Type::Vec2d:
+        return readProperty<std::array<double, 2>>(stream, name, enums,
+                                                   metaData);
+    case Type::Vec3i:
+        return readProperty<std::array<int32_t, 3>>(stream, name, enums,
+                                                    metaData);
+    case Type::Vec3d:
+        return readProperty<std::array<double, 3>>(stream, name, enums,
+                                                   metaData);
+    case Type::Vec4d:
+        return readProperty<std::array<double, 4>>(stream, name, enums,
+                                                   metaData);
+    }
+    throw std::runtime_error("Invalid property type in loader cache");
+}
+
+void writeMeshes(std::ostream& stream, const brayns::TriangleMeshMap& meshes)
+{
+    write(stream, meshes.size());
+    for (const auto& i : meshes)
+    {
+        write(stream, i.first);
+        write(stream, i.second.vertices);
+        write(stream, i.second.normals);
+        write(stream, i.second.colors);
+        write(stream, i.second.indices);
+        write(stream, i.second.textureCoordinates);
+    }
+}
+
+void readMeshes(Reader& stream, brayns::TriangleMeshMap& meshes)
+{
+    // Each mesh holds at least its material ID and the size of its 5 arrays
+    const auto nbMeshes = readCount(stream, 6 * sizeof(size_t));
+    for (size_t i = 0; i < nbMeshes; ++i)
+    {
+        size_t materialId = 0;
+        read(stream, materialId);
+        auto& mesh = meshes[materialId];
+        read(stream, mesh.vertices);
+        read(stream, mesh.normals);
+        read(stream, mesh.colors);
+        read(stream, mesh.indices);
+        read(stream, mesh.textureCoordinates);
+    }
+}
+
+bool isCacheable(const brayns::ModelDescriptor& modelDescriptor)
+{
+    const auto& model = modelDescriptor.getModel();
+    return model.getVolumes().empty() && !model.getSimulationHandler() &&
+           modelDescriptor.getInstances().empty() &&
+           modelDescriptor.getProperties().empty();
+}
+
+void writeModel(std::ostream& stream,
+                const brayns::ModelDescriptor& modelDescriptor)
+{
+    const auto& model = modelDescriptor.getModel();
+
+    write(stream, modelDescriptor.getName());
+    write(stream, modelDescriptor.getMetadata().size());
+    for (const auto& i : modelDescriptor.getMetadata())
+    {
+        write(stream, i.first);
+        write(stream, i.second);
+    }
+
+    const auto& transformation = modelDescriptor.getTransformation();
+    write(stream, transformation.getTranslation());
+    write(stream, transformation.getScale());
+    write(stream, transformation.getRotation());
+    write(stream, transformation.getRotationCenter());
+
+    // Materials
+    write(stream, model.getMaterials().size());
+    for (const auto& i : model.getMaterials())
+    {
+        const auto& material = *i.second;
+        write(stream, i.first);
+        write(stream, material.getName());
+        write(stream, material.getDiffuseColor());
+        write(stream, material.getSpecularColor());
+        write(stream, material.getSpecularExponent());
+        write(stream, material.getReflectionIndex());
+        write(stream, material.getOpacity());
+        write(stream, material.getRefractionIndex());
+        write(stream, material.getEmission());
+        write(stream, material.getGlossiness());
+
+        const auto& properties = material.getPropertyMap().getProperties();
+        write(stream, properties.size());
+        for (const auto& property : properties)
+            writeProperty(stream, *property);
+
+        const auto& textures = material.getTextureDescriptors();
+        write(stream, textures.size());
+        for (const auto& texture : textures)
+        {
+            write(stream, texture.first);
+            write(stream, texture.second->filename);
+        }
+    }
+
+    // Geometry
+    write(stream, model.getSpheres());
+    write(stream, model.getCylinders());
+    write(stream, model.getCones());
+    write(stream, model.getSDFBeziers());
+
+    writeMeshes(stream, model.getTriangleMeshes());
+    write(stream, model.getTriangleMeshLODs().size());
+    for (const auto& meshes : model.getTriangleMeshLODs())
+        writeMeshes(stream, meshes);
+
+    write(stream, model.getStreamlines().size());
+    for (const auto& i : model.getStreamlines())
+    {
+        write(stream, i.first);
+        write(stream, i.second.vertex);
+        write(stream, i.second.vertexColor);
+        write(stream, i.second.indices);
+    }
+
+    const auto& sdf = model.getSDFGeometryData();
+    write(stream, sdf.geometries);
+    write(stream, sdf.geometryIndices);
+    write(stream, sdf.neighbours.size());
+    for (const auto& neighbours : sdf.neighbours)
+        write(stream, neighbours);
+    write(stream, sdf.neighboursFlat);
+}
+
+brayns::ModelDescriptorPtr readModel(Reader& stream, brayns::Scene& scene,
+                                     const std::string& path)
+{
+    auto model = scene.createModel();
+
+    std::string name;
+    read(stream, name);
+    brayns::ModelMetadata metadata;
+    auto nbElements = readCount(stream, 2 * sizeof(size_t));
+    for (size_t i = 0; i < nbElements; ++i)
+    {
+        std::string key;
+        read(stream, key);
+        read(stream, metadata[key]);
+    }
+
+    brayns::Vector3d translation, scale, rotationCenter;
+    brayns::Quaterniond rotation;
+    read(stream, translation);
+    read(stream, scale);
+    read(stream, rotation);
+    read(stream, rotationCenter);
+
+    // Materials
+    nbElements = readCount(stream, sizeof(size_t));
+    for (size_t i = 0; i < nbElements; ++i)
+    {
+        size_t materialId = 0;
+        std::string materialName;
+        brayns::Vector3d diffuseColor, specularColor;
+        double specularExponent, reflectionIndex, opacity, refractionIndex,
+            emission, glossiness;
+        read(stream, materialId);
+        read(stream, materialName);
+        read(stream, diffuseColor);
+        read(stream, specularColor);
+        read(stream, specularExponent);
+        read(stream, reflectionIndex);
+        read(stream, opacity);
+        read(stream, refractionIndex);
+        read(stream, emission);
+        read(stream, glossiness);
+
+        brayns::PropertyMap properties;
+        const auto nbProperties = readCount(stream, sizeof(size_t));
+        for (size_t j = 0; j < nbProperties; ++j)
+            properties.setProperty(readProperty(stream));
+
+        auto material =
+            model->createMaterial(materialId, materialName, properties);
+        material->setDiffuseColor(diffuseColor);
+        material->setSpecularColor(specularColor);
+        material->setSpecularExponent(specularExponent);
+        material->setReflectionIndex(reflectionIndex);
+        material->setOpacity(opacity);
+        material->setRefractionIndex(refractionIndex);
+        material->setEmission(emission);
+        material->setGlossiness(glossiness);
+
+        const auto nbTextures = readCount(stream, sizeof(size_t));
+        for (size_t j = 0; j < nbTextures; ++j)
+        {
+            brayns::TextureType type;
+            std::string filename;
+            read(stream, type);
+            read(stream, filename);
+            material->setTexture(filename, type);
+        }
+    }
+
+    // Geometry
+    read(stream, model->getSpheres());
+    read(stream, model->getCylinders());
+    read(stream, model->getCones());
+    read(stream, model->getSDFBeziers());
+
+    readMeshes(stream, model->getTriangleMeshes());
+    nbElements = readCount(stream, sizeof(size_t));
+    auto& lods = model->getTriangleMeshLODs();
+    lods.resize(nbElements);
+    for (auto& meshes : lods)
+        readMeshes(stream, meshes);
+
+    nbElements = readCount(stream, 4 * sizeof(size_t));
+    auto& streamlines = model->getStreamlines();
+    for (size_t i = 0; i < nbElements; ++i)
+    {
+        size_t materialId = 0;
+        read(stream, materialId);
+        auto& streamline = streamlines[materialId];
+        read(stream, streamline.vertex);
+        read(stream, streamline.vertexColor);
+        read(stream, streamline.indices);
+    }
+
+    auto& sdf = model->getSDFGeometryData();
+    read(stream, sdf.geometries);
+    read(stream, sdf.geometryIndices);
+    nbElements = readCount(stream, sizeof(size_t));
+    sdf.neighbours.resize(nbElements);
+    for (auto& neighbours : sdf.neighbours)
+        read(stream, neighbours);
+    read(stream, sdf.neighboursFlat);
+
+    if (!stream)
+        throw std::runtime_error("Truncated loader cache file");
+
+    model->updateBounds();
+
+    auto modelDescriptor =
+        std::make_shared<brayns::ModelDescriptor>(std::move(model), name, path,
+                                                  metadata);
+    modelDescriptor->setTransformation(
+        {translation, scale, rotation, rotationCenter});
+    return modelDescriptor;
+}
+} // namespace
+
+namespace brayns
+{
+LoaderCache::LoaderCache(const std::string& folder)
+    : _folder(folder)
+{
+}
+
+ModelDescriptorPtr LoaderCache::load(Scene& scene, const std::string& path,
+                                     const std::string& loaderName,
+                                     const PropertyMap& properties)
+{
+    if (!isEnabled())
+        return {};
+
+    Timer timer;
+    timer.start();
+
+    ModelDescriptorPtr modelDescriptor;
+    uint64_t loadingTime = 0;
+    try
+    {
+        const auto key = _createKey(path, loaderName, properties);
+        std::ifstream file(_getFilename(key),
+                           std::ios::binary | std::ios::ate);
+        const auto size = file ? size_t(file.tellg()) : 0;
+        file.seekg(0);
+        Reader reader{file, size};
+        std::string magic, fileKey;
+        size_t version = 0;
+        read(reader, magic);
+        read(reader, version);
+        if (magic == CACHE_MAGIC && version == CACHE_VERSION)
+        {
+            read(reader, fileKey);
+            read(reader, loadingTime);
+            if (fileKey == key)
+                modelDescriptor = readModel(reader, scene, path);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        BRAYNS_ERROR << "Failed to read loader cache for " << path << ": "
+                     << e.what() << std::endl;
+    }
+
+    if (!modelDescriptor)
+    {
+        ++_misses;
+        return {};
+    }
+    timer.stop();
+
+    const auto elapsed = uint64_t(timer.milliseconds());
+    if (loadingTime > elapsed)
+        _savedMilliseconds += loadingTime - elapsed;
+    ++_hits;
+
+    BRAYNS_INFO << "Loaded " << path << " from loader cache in " << elapsed
+                << " ms instead of " << loadingTime << " ms (" << _hits.load()
+                << " hits, " << _misses.load() << " misses)" << std::endl;
+    return modelDescriptor;
+}
+
+void LoaderCache::store(const ModelDescriptor& modelDescriptor,
+                        const std::string& path, const std::string& loaderName,
+                        const PropertyMap& properties,
+                        const uint64_t loadingTime)
+{
+    if (!isEnabled() || !isCacheable(modelDescriptor))
+        return;
+
+    try
+    {
+        fs::create_directories(_folder);
+
+        const auto key = _createKey(path, loaderName, properties);
+        const auto filename = _getFilename(key);
+
+        // Write to a temporary file first, so concurrent loads never read a
+        // partially written entry
+        std::stringstream threadId;
+        threadId << std::this_thread::get_id();
+        const auto tmpFilename = filename + "." + threadId.str();
+        {
+            std::ofstream file(tmpFilename, std::ios::binary);
+            write(file, CACHE_MAGIC);
+            write(file, CACHE_VERSION);
+            write(file, key);
+            write(file, loadingTime);
+            writeModel(file, modelDescriptor);
+            if (!file.good())
+                throw std::runtime_error("Failed to write " + tmpFilename);
+        }
+        fs::rename(tmpFilename, filename);
+    }
+    catch (const std::exception& e)
+    {
+        BRAYNS_ERROR << "Failed to store " << path
+                     << " in loader cache: " << e.what() << std::endl;
+    }
+}
+
+LoaderCache::Stats LoaderCache::getStats() const
+{
+    Stats stats;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.savedMilliseconds = _savedMilliseconds;
+    return stats;
+}
+
+std::string LoaderCache::_createKey(const std::string& path,
+                                    const std::string& loaderName,
+                                    const PropertyMap& properties) const
+{
+    const auto canonicalPath = fs::canonical(path);
+
+    std::vector<std::pair<std::string, std::string>> values;
+    for (const auto& property : properties.getProperties())
+        values.emplace_back(property->name, toString(*property));
+    std::sort(values.begin(), values.end());
+
+    std::stringstream key;
+    key << canonicalPath.string() << "\n"
+        << fs::last_write_time(canonicalPath).time_since_epoch().count()
+        << "\n"
+        << fs::file_size(canonicalPath) << "\n"
+        << loaderName << "\n";
+    for (const auto& value : values)
+        key << value.first << "=" << value.second << "\n";
+    return key.str();
+}
+
+std::string LoaderCache::_getFilename(const std::string& key) const
+{
+    std::stringstream filename;
+    filename << std::hex << std::setw(16) << std::setfill('0')
+             << std::hash<std::string>()(key) << ".cache";
+    return (fs::path(_folder) / filename.str()).string();
+}
+}
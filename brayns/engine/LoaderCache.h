@@ -0,0 +1,91 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/PropertyMap.h>
+#include <brayns/common/types.h>
+
+#include <atomic>
+
+namespace brayns
+{
+/**
+ * On-disk cache of the models imported from files. Entries are addressed by
+ * the file path, its modification time and size, the name of the loader and
+ * the loader properties merged with its defaults, so any change to one of
+ * those results in a new import. Geometry, materials and metadata are stored
+ * in a raw binary format which is read back without going through the loader.
+ *
+ * Models with volumes, a simulation handler, instances or descriptor
+ * properties are not cached, as those cannot be restored from their data
+ * alone. Neither are the models of loaders reading other files than the given
+ * one, @sa Loader::isCacheable().
+ */
+class LoaderCache
+{
+public:
+    struct Stats
+    {
+        size_t hits{0};
+        size_t misses{0};
+        /** Loading time saved by the hits, in milliseconds */
+        uint64_t savedMilliseconds{0};
+    };
+
+    /** @param folder the folder of the cache files, empty to disable it */
+    LoaderCache(const std::string& folder);
+
+    bool isEnabled() const { return !_folder.empty(); }
+
+    /**
+     * Load the model imported from the given file with the given loader and
+     * properties from the cache.
+     *
+     * @return the cached model, or nullptr on a cache miss
+     */
+    ModelDescriptorPtr load(Scene& scene, const std::string& path,
+                            const std::string& loaderName,
+                            const PropertyMap& properties);
+
+    /**
+     * Store the model imported from the given file with the given loader and
+     * properties in the cache, if it can be cached.
+     *
+     * @param loadingTime the time the loader took to import the model, in
+     *                    milliseconds
+     */
+    void store(const ModelDescriptor& modelDescriptor, const std::string& path,
+               const std::string& loaderName, const PropertyMap& properties,
+               uint64_t loadingTime);
+
+    Stats getStats() const;
+
+private:
+    std::string _createKey(const std::string& path,
+                           const std::string& loaderName,
+                           const PropertyMap& properties) const;
+    std::string _getFilename(const std::string& key) const;
+
+    const std::string _folder;
+    std::atomic<size_t> _hits{0};
+    std::atomic<size_t> _misses{0};
+    std::atomic<uint64_t> _savedMilliseconds{0};
+};
+}
@@ -53,6 +53,21 @@ void _unbindMaterials(const AbstractSimulationHandlerPtr& simulationHandler,
     for (const auto& material : materials)
         simulationHandler->unbind(material.second);
 }
+
+template <typename T>
+void _addDirtyMaterials(const bool allDirty,
+                        const std::set<size_t>& dirtyMaterials,
+                        const std::map<size_t, T>& geometries,
+                        std::set<size_t>& materials)
+{
+    if (!allDirty)
+    {
+        materials.insert(dirtyMaterials.begin(), dirtyMaterials.end());
+        return;
+    }
+    for (const auto& geometry : geometries)
+        materials.insert(geometry.first);
+}
 }
 ModelParams::ModelParams(const std::string& path)
     : _name(fs::path(path).stem())
@@ -205,28 +220,28 @@ bool Model::empty() const
 
 uint64_t Model::addSphere(const size_t materialId, const Sphere& sphere)
 {
-    _spheresDirty = true;
+    _dirtySphereMaterials.insert(materialId);
     _geometries->_spheres[materialId].push_back(sphere);
     return _geometries->_spheres[materialId].size() - 1;
 }
 
 uint64_t Model::addCylinder(const size_t materialId, const Cylinder& cylinder)
 {
-    _cylindersDirty = true;
+    _dirtyCylinderMaterials.insert(materialId);
     _geometries->_cylinders[materialId].push_back(cylinder);
     return _geometries->_cylinders[materialId].size() - 1;
 }
 
 uint64_t Model::addCone(const size_t materialId, const Cone& cone)
 {
-    _conesDirty = true;
+    _dirtyConeMaterials.insert(materialId);
     _geometries->_cones[materialId].push_back(cone);
     return _geometries->_cones[materialId].size() - 1;
 }
 
 uint64_t Model::addSDFBezier(const size_t materialId, const SDFBezier& bezier)
 {
-    _sdfBeziersDirty = true;
+    _dirtySDFBezierMaterials.insert(materialId);
     _geometries->_sdfBeziers[materialId].push_back(bezier);
     return _geometries->_sdfBeziers[materialId].size() - 1;
 }
@@ -259,7 +274,7 @@ void Model::addStreamline(const size_t materialId, const Streamline& streamline)
     for (const auto& color : streamline.color)
         streamlinesData.vertexColor.push_back(color);
 
-    _streamlinesDirty = true;
+    _dirtyStreamlineMaterials.insert(materialId);
 }
 
 uint64_t Model::addSDFGeometry(const size_t materialId, const SDFGeometry& geom,
@@ -302,6 +317,24 @@ bool Model::isDirty() const
     return _areGeometriesDirty() || _instancesDirty;
 }
 
+std::set<size_t> Model::getDirtyMaterials() const
+{
+    std::set<size_t> materials;
+    _addDirtyMaterials(_spheresDirty, _dirtySphereMaterials,
+                       _geometries->_spheres, materials);
+    _addDirtyMaterials(_cylindersDirty, _dirtyCylinderMaterials,
+                       _geometries->_cylinders, materials);
+    _addDirtyMaterials(_conesDirty, _dirtyConeMaterials, _geometries->_cones,
+                       materials);
+    _addDirtyMaterials(_sdfBeziersDirty, _dirtySDFBezierMaterials,
+                       _geometries->_sdfBeziers, materials);
+    _addDirtyMaterials(_triangleMeshesDirty, _dirtyTriangleMeshMaterials,
+                       _geometries->_triangleMeshes, materials);
+    _addDirtyMaterials(_streamlinesDirty, _dirtyStreamlineMaterials,
+                       _geometries->_streamlines, materials);
+    return materials;
+}
+
 void Model::setMaterialsColorMap(const MaterialsColorMap colorMap)
 {
     size_t index = 0;
@@ -428,6 +461,27 @@ MaterialPtr Model::getMaterial(const size_t materialId) const
     return it->second;
 }
 
+size_t Model::getNbTriangles(const size_t level) const
+{
+    const auto& lods = _geometries->_triangleMeshLODs;
+    if (level > lods.size())
+        return 0;
+    size_t nbTriangles = 0;
+    for (const auto& mesh : _geometries->_triangleMeshes)
+    {
+        // A material missing from a level keeps its mesh of the previous one
+        size_t nbIndices = mesh.second.indices.size();
+        for (size_t i = 0; i < level; ++i)
+        {
+            const auto it = lods[i].find(mesh.first);
+            if (it != lods[i].end())
+                nbIndices = it->second.indices.size();
+        }
+        nbTriangles += nbIndices;
+    }
+    return nbTriangles;
+}
+
 void Model::_updateSizeInBytes()
 {
     _sizeInBytes = 0;
@@ -439,15 +493,20 @@ void Model::_updateSizeInBytes()
         _sizeInBytes += cones.second.size() * sizeof(Cones);
     for (const auto& sdfBeziers : _geometries->_sdfBeziers)
         _sizeInBytes += sdfBeziers.second.size() * sizeof(SDFBeziers);
-    for (const auto& triangleMesh : _geometries->_triangleMeshes)
-    {
-        const auto& mesh = triangleMesh.second;
-        _sizeInBytes += mesh.indices.size() * sizeof(Vector3f);
-        _sizeInBytes += mesh.normals.size() * sizeof(Vector3f);
-        _sizeInBytes += mesh.colors.size() * sizeof(Vector4f);
-        _sizeInBytes += mesh.indices.size() * sizeof(Vector3ui);
-        _sizeInBytes += mesh.textureCoordinates.size() * sizeof(Vector2f);
-    }
+    const auto addMeshes = [this](const TriangleMeshMap& meshes) {
+        for (const auto& triangleMesh : meshes)
+        {
+            const auto& mesh = triangleMesh.second;
+            _sizeInBytes += mesh.vertices.size() * sizeof(Vector3f);
+            _sizeInBytes += mesh.normals.size() * sizeof(Vector3f);
+            _sizeInBytes += mesh.colors.size() * sizeof(Vector4f);
+            _sizeInBytes += mesh.indices.size() * sizeof(Vector3ui);
+            _sizeInBytes += mesh.textureCoordinates.size() * sizeof(Vector2f);
+        }
+    };
+    addMeshes(_geometries->_triangleMeshes);
+    for (const auto& meshes : _geometries->_triangleMeshLODs)
+        addMeshes(meshes);
     for (const auto& streamline : _geometries->_streamlines)
     {
         _sizeInBytes += streamline.second.indices.size() * sizeof(int32_t);
@@ -482,6 +541,7 @@ void Model::copyFrom(const Model& rhs)
     }
     _bounds = rhs._bounds;
     _bvhFlags = rhs._bvhFlags;
+    _materialTable = rhs._materialTable;
     _sizeInBytes = rhs._sizeInBytes;
 
     // reference only to save memory
@@ -499,7 +559,7 @@ void Model::copyFrom(const Model& rhs)
 
 void Model::updateBounds()
 {
-    if (_spheresDirty)
+    if (_isDirty(_spheresDirty, _dirtySphereMaterials))
     {
         _geometries->_sphereBounds.reset();
         for (const auto& spheres : _geometries->_spheres)
@@ -513,7 +573,7 @@ void Model::updateBounds()
                 }
     }
 
-    if (_cylindersDirty)
+    if (_isDirty(_cylindersDirty, _dirtyCylinderMaterials))
     {
         _geometries->_cylindersBounds.reset();
         for (const auto& cylinders : _geometries->_cylinders)
@@ -525,7 +585,7 @@ void Model::updateBounds()
                 }
     }
 
-    if (_conesDirty)
+    if (_isDirty(_conesDirty, _dirtyConeMaterials))
     {
         _geometries->_conesBounds.reset();
         for (const auto& cones : _geometries->_cones)
@@ -537,7 +597,7 @@ void Model::updateBounds()
                 }
     }
 
-    if (_sdfBeziersDirty)
+    if (_isDirty(_sdfBeziersDirty, _dirtySDFBezierMaterials))
     {
         _geometries->_sdfBeziersBounds.reset();
         for (const auto& sdfBeziers : _geometries->_sdfBeziers)
@@ -546,16 +606,23 @@ void Model::updateBounds()
                     _geometries->_sdfBeziersBounds.merge(bezierBounds(sdfBezier));
     }
 
-    if (_triangleMeshesDirty)
+    if (_isDirty(_triangleMeshesDirty, _dirtyTriangleMeshMaterials))
     {
         _geometries->_triangleMeshesBounds.reset();
         for (const auto& mesh : _geometries->_triangleMeshes)
             if (mesh.first != BOUNDINGBOX_MATERIAL_ID)
                 for (const auto& vertex : mesh.second.vertices)
                     _geometries->_triangleMeshesBounds.merge(vertex);
+
+        // Read by the level of detail selection of every frame
+        auto& nbTriangles = _geometries->_nbTrianglesPerLOD;
+        nbTriangles.clear();
+        const size_t nbLODs = _geometries->_triangleMeshLODs.size();
+        for (size_t level = 0; nbLODs > 0 && level <= nbLODs; ++level)
+            nbTriangles.push_back(getNbTriangles(level));
     }
 
-    if (_streamlinesDirty)
+    if (_isDirty(_streamlinesDirty, _dirtyStreamlineMaterials))
     {
         _geometries->_streamlinesBounds.reset();
         for (const auto& streamline : _geometries->_streamlines)
@@ -605,6 +672,13 @@ void Model::_markGeometriesClean()
     _streamlinesDirty = false;
     _sdfGeometriesDirty = false;
     _volumesDirty = false;
+
+    _dirtySphereMaterials.clear();
+    _dirtyCylinderMaterials.clear();
+    _dirtyConeMaterials.clear();
+    _dirtySDFBezierMaterials.clear();
+    _dirtyTriangleMeshMaterials.clear();
+    _dirtyStreamlineMaterials.clear();
 }
 
 MaterialPtr Model::createMaterial(const size_t materialId,
@@ -670,20 +744,39 @@ bool Model::commitSimulationData()
         _isReadyCallbackSet = true;
     }
 
-    const auto animationFrame = _animationParameters.getFrame();
+    const auto position = _animationParameters.getFramePosition();
+    const auto encoding = _simulationHandler->getEncoding();
+
+    // Integer encodings are normalized to the transfer function range
+    const auto& range = _transferFunction.getValuesRange();
+    const bool rangeChanged = encoding != SimulationDataEncoding::float32 &&
+                              range != _simulationDataRange;
 
-    if (_simulationHandler->getCurrentFrame() == animationFrame)
+    if (_simulationHandler->getCurrentFramePosition() == position &&
+        !rangeChanged)
     {
         return false;
     }
 
-    auto frameData = _simulationHandler->getFrameData(animationFrame);
+    auto frameData = _simulationHandler->getInterpolatedFrameData(position);
 
     if (!frameData)
         return false;
 
-    _commitSimulationDataImpl((float*)frameData,
-                              _simulationHandler->getFrameSize());
+    _simulationDataRange = range;
+    const auto frameSize = _simulationHandler->getFrameSize();
+    if (encoding != SimulationDataEncoding::float32)
+    {
+        const auto encoded =
+            _simulationHandler->encodeFrameData((float*)frameData, range);
+        if (_commitEncodedSimulationDataImpl(encoded, frameSize, encoding,
+                                             range))
+        {
+            return true;
+        }
+    }
+
+    _commitSimulationDataImpl((float*)frameData, frameSize);
     return true;
 }
 }
@@ -260,6 +260,15 @@ public:
         const Vector3ui& dimensions, const Vector3f& spacing,
         const DataType type) const = 0;
 
+    /**
+     * Create a volume with the given dimensions, voxel spacing and data type
+     * where the voxels are read from a file in bricks on demand via
+     * PagedVolume::mapData() and PagedVolume::prefetch().
+     */
+    BRAYNS_API virtual PagedVolumePtr createPagedVolume(
+        const Vector3ui& dimensions, const Vector3f& spacing,
+        const DataType type) const = 0;
+
     BRAYNS_API virtual void buildBoundingBox() = 0;
     //@}
 
@@ -272,6 +281,13 @@ public:
     /** @return true if the geometry Model is dirty, false otherwise */
     BRAYNS_API bool isDirty() const;
 
+    /**
+     * @return the materials whose spheres, cylinders, cones, SDF beziers,
+     *         triangle meshes or streamlines are committed again by the next
+     *         commitGeometry()
+     */
+    BRAYNS_API std::set<size_t> getDirtyMaterials() const;
+
     /**
         Returns the bounds for the Model
     */
@@ -285,6 +301,18 @@ public:
         _spheresDirty = true;
         return _geometries->_spheres;
     }
+    /**
+        Returns the spheres of one material; only the geometry of this
+        material is committed again. The material is marked dirty by the
+        call, not by the writes: a reference kept across commitGeometry()
+        must be fetched again before the next modification, otherwise the
+        modification is not committed.
+    */
+    Spheres& getSpheres(const size_t materialId)
+    {
+        _dirtySphereMaterials.insert(materialId);
+        return _geometries->_spheres[materialId];
+    }
     /**
       Adds a sphere to the model
       @param materialId Id of the material for the sphere
@@ -303,6 +331,12 @@ public:
         _cylindersDirty = true;
         return _geometries->_cylinders;
     }
+    /** Returns the cylinders of one material, @sa getSpheres(size_t) */
+    Cylinders& getCylinders(const size_t materialId)
+    {
+        _dirtyCylinderMaterials.insert(materialId);
+        return _geometries->_cylinders[materialId];
+    }
     /**
       Adds a cylinder to the model
       @param materialId Id of the material for the cylinder
@@ -320,6 +354,12 @@ public:
         _conesDirty = true;
         return _geometries->_cones;
     }
+    /** Returns the cones of one material, @sa getSpheres(size_t) */
+    Cones& getCones(const size_t materialId)
+    {
+        _dirtyConeMaterials.insert(materialId);
+        return _geometries->_cones[materialId];
+    }
     /**
       Adds a cone to the model
       @param materialId Id of the material for the cone
@@ -341,6 +381,12 @@ public:
         _sdfBeziersDirty = true;
         return _geometries->_sdfBeziers;
     }
+    /** Returns the SDFBeziers of one material, @sa getSpheres(size_t) */
+    SDFBeziers& getSDFBeziers(const size_t materialId)
+    {
+        _dirtySDFBezierMaterials.insert(materialId);
+        return _geometries->_sdfBeziers[materialId];
+    }
     /**
       Adds a SDFBezier to the model
       @param materialId Id of the material for the sdfBezier
@@ -361,11 +407,21 @@ public:
     /**
         Returns streamlines handled by the model
     */
+    const StreamlinesDataMap& getStreamlines() const
+    {
+        return _geometries->_streamlines;
+    }
     StreamlinesDataMap& getStreamlines()
     {
         _streamlinesDirty = true;
         return _geometries->_streamlines;
     }
+    /** Returns the streamlines of one material, @sa getSpheres(size_t) */
+    StreamlinesData& getStreamlines(const size_t materialId)
+    {
+        _dirtyStreamlineMaterials.insert(materialId);
+        return _geometries->_streamlines[materialId];
+    }
     /**
       Adds a SDFGeometry to the scene
       @param materialId Material of the geometry
@@ -380,6 +436,10 @@ public:
     /**
      * Returns SDF geometry data handled by the model
      */
+    const SDFGeometryData& getSDFGeometryData() const
+    {
+        return _geometries->_sdf;
+    }
     SDFGeometryData& getSDFGeometryData()
     {
         _sdfGeometriesDirty = true;
@@ -406,6 +466,41 @@ public:
         _triangleMeshesDirty = true;
         return _geometries->_triangleMeshes;
     }
+    /** Returns the triangle mesh of one material, @sa getSpheres(size_t) */
+    TriangleMesh& getTriangleMeshes(const size_t materialId)
+    {
+        _dirtyTriangleMeshMaterials.insert(materialId);
+        return _geometries->_triangleMeshes[materialId];
+    }
+
+    /**
+        Returns the coarser levels of detail of the triangle meshes, the
+        element i holding the meshes of level i + 1, level 0 being the meshes
+        returned by getTriangleMeshes(). A material missing from a level uses
+        its mesh of the previous level.
+    */
+    const TriangleMeshLODs& getTriangleMeshLODs() const
+    {
+        return _geometries->_triangleMeshLODs;
+    }
+    TriangleMeshLODs& getTriangleMeshLODs()
+    {
+        _triangleMeshesDirty = true;
+        return _geometries->_triangleMeshLODs;
+    }
+
+    /** @return the number of triangles of the given level of detail */
+    BRAYNS_API size_t getNbTriangles(size_t level = 0) const;
+
+    /**
+        Returns the number of triangles of each level of detail, level 0
+        first, as of the last commit of the geometry; empty without coarser
+        levels
+    */
+    const std::vector<size_t>& getNbTrianglesPerLOD() const
+    {
+        return _geometries->_nbTrianglesPerLOD;
+    }
 
     /** Add a volume to the model*/
     BRAYNS_API void addVolume(VolumePtr);
@@ -471,6 +566,13 @@ public:
         _bvhFlags = std::move(bvhFlags);
     }
     const std::set<BVHFlag>& getBVHFlags() const { return _bvhFlags; }
+    /**
+     * Enables the material table mode, where the engine groups primitives of
+     * the same type in one geometry and indexes their material per primitive,
+     * instead of creating one geometry per material.
+     */
+    void setMaterialTable(const bool enabled) { _materialTable = enabled; }
+    bool getMaterialTable() const { return _materialTable; }
     void updateBounds();
     /** @internal */
     void copyFrom(const Model& rhs);
@@ -490,12 +592,25 @@ protected:
                                              const Vector2d valueRange) = 0;
     virtual void _commitSimulationDataImpl(const float* frameData,
                                            const size_t frameSize) = 0;
+    /**
+     * Commit simulation data encoded by the simulation handler.
+     * @return false if the engine does not support the encoding, in which
+     *         case the float data is committed instead.
+     */
+    virtual bool _commitEncodedSimulationDataImpl(
+        const void* /*frameData*/, const size_t /*frameSize*/,
+        const SimulationDataEncoding /*encoding*/,
+        const Vector2d& /*valueRange*/)
+    {
+        return false;
+    }
 
     AnimationParameters& _animationParameters;
     VolumeParameters& _volumeParameters;
 
     AbstractSimulationHandlerPtr _simulationHandler;
     TransferFunction _transferFunction;
+    Vector2d _simulationDataRange;
 
     MaterialMap _materials;
 
@@ -506,6 +621,8 @@ protected:
         ConesMap _cones;
         SDFBeziersMap _sdfBeziers;
         TriangleMeshMap _triangleMeshes;
+        TriangleMeshLODs _triangleMeshLODs;
+        std::vector<size_t> _nbTrianglesPerLOD;
         StreamlinesDataMap _streamlines;
         SDFGeometryData _sdf;
         Volumes _volumes;
@@ -542,15 +659,45 @@ protected:
     bool _sdfGeometriesDirty{false};
     bool _volumesDirty{false};
 
+    // Materials whose geometries were modified through the per-material
+    // accessors, while the flags above mark all the materials of a type
+    std::set<size_t> _dirtySphereMaterials;
+    std::set<size_t> _dirtyCylinderMaterials;
+    std::set<size_t> _dirtyConeMaterials;
+    std::set<size_t> _dirtySDFBezierMaterials;
+    std::set<size_t> _dirtyTriangleMeshMaterials;
+    std::set<size_t> _dirtyStreamlineMaterials;
+
+    /** @return true if any material of a geometry type is dirty */
+    static bool _isDirty(const bool allDirty,
+                         const std::set<size_t>& dirtyMaterials)
+    {
+        return allDirty || !dirtyMaterials.empty();
+    }
+
+    /** @return true if the geometry of the material is dirty */
+    static bool _isDirty(const bool allDirty,
+                         const std::set<size_t>& dirtyMaterials,
+                         const size_t materialId)
+    {
+        return allDirty || dirtyMaterials.count(materialId);
+    }
+
     bool _areGeometriesDirty() const
     {
-        return _spheresDirty || _cylindersDirty || _conesDirty ||
-               _sdfBeziersDirty || _triangleMeshesDirty || _sdfGeometriesDirty;
+        return _isDirty(_spheresDirty, _dirtySphereMaterials) ||
+               _isDirty(_cylindersDirty, _dirtyCylinderMaterials) ||
+               _isDirty(_conesDirty, _dirtyConeMaterials) ||
+               _isDirty(_sdfBeziersDirty, _dirtySDFBezierMaterials) ||
+               _isDirty(_triangleMeshesDirty, _dirtyTriangleMeshMaterials) ||
+               _isDirty(_streamlinesDirty, _dirtyStreamlineMaterials) ||
+               _sdfGeometriesDirty;
     }
 
     Boxd _bounds;
     bool _instancesDirty{true};
     std::set<BVHFlag> _bvhFlags;
+    bool _materialTable{false};
     size_t _sizeInBytes{0};
 
     // Whether this model has set the AnimationParameters "is ready" callback
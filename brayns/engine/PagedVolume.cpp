@@ -0,0 +1,82 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "PagedVolume.h"
+
+#include <brayns/common/volume/BrickCache.h>
+
+#include <algorithm>
+
+namespace brayns
+{
+namespace
+{
+// Bricks read within one scene commit, the other visible ones are read by the
+// following commits so a camera move never blocks rendering for long
+const size_t MAX_BRICK_LOADS_PER_COMMIT = 16;
+} // namespace
+
+PagedVolume::~PagedVolume() = default;
+
+void PagedVolume::mapData(const std::string& filename,
+                          const size_t memoryBudget)
+{
+    _cache = std::make_unique<BrickCache>(filename, _dimensions, _dataType,
+                                          memoryBudget);
+    _frustum.reset();
+    setCoarseVoxels(_cache->getCoarseVoxels().data(),
+                    _cache->getCoarseDimensions());
+    setBricks(_cache->getBricks(), _cache->getBrickCounts());
+    _sizeInBytes = _cache->getSizeInBytes();
+}
+
+void PagedVolume::prefetch(const Frustum& frustum)
+{
+    if (!_cache ||
+        (_frustum && *_frustum == frustum && _cache->getNbPending() == 0))
+        return;
+    _frustum = std::make_unique<Frustum>(frustum);
+
+    const auto& counts = _cache->getBrickCounts();
+    const size_t nbBricks = size_t(counts.x) * counts.y * counts.z;
+    const Vector3d spacing(_spacing);
+    std::vector<std::pair<double, size_t>> visible;
+    for (size_t i = 0; i < nbBricks; ++i)
+    {
+        const auto voxels = _cache->getBrickBounds(i);
+        const Boxd bounds(voxels.getMin() * spacing,
+                          voxels.getMax() * spacing);
+        if (frustum.intersects(bounds))
+            visible.emplace_back(glm::length(bounds.getCenter() -
+                                             frustum.getPosition()),
+                                 i);
+    }
+    std::sort(visible.begin(), visible.end());
+
+    std::vector<size_t> bricks;
+    bricks.reserve(visible.size());
+    for (const auto& brick : visible)
+        bricks.push_back(brick.second);
+
+    if (_cache->update(bricks, MAX_BRICK_LOADS_PER_COMMIT))
+    {
+        setBricks(_cache->getBricks(), counts);
+        _sizeInBytes = _cache->getSizeInBytes();
+    }
+}
+} // namespace brayns
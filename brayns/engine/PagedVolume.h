@@ -0,0 +1,81 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/geometry/Frustum.h>
+#include <brayns/engine/Volume.h>
+
+namespace brayns
+{
+class BrickCache;
+
+/**
+ * A volume type where the voxels stay in a raw file and are read in bricks
+ * on demand. The bricks in view of the camera are kept in an LRU cache within
+ * a memory budget, the other regions are rendered from a coarse level.
+ */
+class PagedVolume : public virtual Volume
+{
+public:
+    /** @name API for engine-specific code */
+    //@{
+    /**
+     * Set the coarse level, made of one voxel out of
+     * BrickCache::COARSE_FACTOR along each axis.
+     */
+    virtual void setCoarseVoxels(const void* voxels,
+                                 const Vector3ui& dimensions) = 0;
+
+    /**
+     * Set the voxels of each brick of BrickCache::BRICK_SIZE^3 voxels, nullptr
+     * for the bricks which are not resident. The pointers stay valid until the
+     * next call.
+     */
+    virtual void setBricks(const std::vector<const void*>& bricks,
+                           const Vector3ui& brickCounts) = 0;
+    //@}
+
+    /**
+     * Page the voxels of the given raw file, keeping at most memoryBudget bytes
+     * of bricks in memory. Only the coarse level is read here.
+     */
+    BRAYNS_API void mapData(const std::string& filename, size_t memoryBudget);
+
+    /**
+     * Load the bricks intersecting the given frustum, the nearest ones first,
+     * and update the engine if the resident bricks changed. Only a few bricks
+     * are read per call; the volume is then modified, which resets the
+     * accumulation, and the next calls with the same frustum read the others.
+     */
+    BRAYNS_API void prefetch(const Frustum& frustum);
+
+protected:
+    PagedVolume(const Vector3ui& dimensions, const Vector3f& spacing,
+                const DataType type)
+        : Volume(dimensions, spacing, type)
+    {
+    }
+
+    ~PagedVolume();
+
+private:
+    std::unique_ptr<BrickCache> _cache;
+    std::unique_ptr<Frustum> _frustum;
+};
+} // namespace brayns
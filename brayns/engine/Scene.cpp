@@ -20,6 +20,7 @@
 
 #include "Scene.h"
 
+#include <brayns/common/Timer.h>
 #include <brayns/common/Transformation.h>
 #include <brayns/common/log.h>
 #include <brayns/common/scene/ClipPlane.h>
@@ -71,6 +72,7 @@ Scene::Scene(AnimationParameters& animationParameters,
     : _animationParameters(animationParameters)
     , _geometryParameters(geometryParameters)
     , _volumeParameters(volumeParameters)
+    , _loaderCache(geometryParameters.getLoaderCache())
 {
 }
 
@@ -127,6 +129,7 @@ size_t Scene::addModel(ModelDescriptorPtr modelDescriptor)
     const auto defaultBVHFlags = _geometryParameters.getDefaultBVHFlags();
 
     model.setBVHFlags(defaultBVHFlags);
+    model.setMaterialTable(_geometryParameters.getMaterialTable());
     model.buildBoundingBox();
 
     // Since models can be added concurrently we check if that is supported
@@ -245,9 +248,29 @@ ModelDescriptorPtr Scene::loadModel(const std::string& path,
     // HACK: Add loader name in properties for archive loader
     auto propCopy = params.getLoaderProperties();
     propCopy.setProperty({"loaderName", params.getLoaderName()});
-    auto modelDescriptor = loader.importFromFile(path, cb, propCopy);
+
+    // Cache entries are addressed by the properties the loader actually uses,
+    // its defaults being derived from the global parameters
+    const bool cacheable = loader.isCacheable(path);
+    auto cacheProperties = loader.getProperties();
+    cacheProperties.merge(propCopy);
+
+    ModelDescriptorPtr modelDescriptor;
+    if (cacheable)
+        modelDescriptor =
+            _loaderCache.load(*this, path, loader.getName(), cacheProperties);
     if (!modelDescriptor)
-        throw std::runtime_error("No model returned by loader");
+    {
+        Timer timer;
+        timer.start();
+        modelDescriptor = loader.importFromFile(path, cb, propCopy);
+        if (!modelDescriptor)
+            throw std::runtime_error("No model returned by loader");
+        timer.stop();
+        if (cacheable)
+            _loaderCache.store(*modelDescriptor, path, loader.getName(),
+                               cacheProperties, timer.milliseconds());
+    }
     *modelDescriptor = params;
     addModel(modelDescriptor);
     return modelDescriptor;
@@ -304,7 +327,7 @@ void Scene::buildDefault()
         material->setGlossiness(i == 4 ? 0.9f : 1.f);
         material->setOpacity(1.f);
 
-        auto& triangleMesh = model->getTriangleMeshes()[materialId];
+        auto& triangleMesh = model->getTriangleMeshes(materialId);
         for (size_t j = 0; j < 6; ++j)
         {
             const auto position = positions[indices[i][j]];
@@ -364,7 +387,7 @@ void Scene::buildDefault()
             {0.5f + lampInfo.x, lampInfo.y, 0.5f - lampInfo.z},
             {0.5f + lampInfo.x, lampInfo.y, 0.5f + lampInfo.z},
             {0.5f - lampInfo.x, lampInfo.y, 0.5f + lampInfo.z}};
-        auto& triangleMesh = model->getTriangleMeshes()[materialId];
+        auto& triangleMesh = model->getTriangleMeshes(materialId);
         for (size_t i = 0; i < 4; ++i)
             triangleMesh.vertices.push_back(lampPositions[i]);
         triangleMesh.indices.push_back(Vector3i(2, 1, 0));
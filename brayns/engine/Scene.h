@@ -22,10 +22,14 @@
 
 #include <brayns/api.h>
 #include <brayns/common/BaseObject.h>
+#include <brayns/common/geometry/Frustum.h>
+#include <brayns/common/geometry/OcclusionMap.h>
 #include <brayns/common/loader/LoaderRegistry.h>
 #include <brayns/common/types.h>
 #include <brayns/engine/LightManager.h>
+#include <brayns/engine/LoaderCache.h>
 
+#include <functional>
 #include <shared_mutex>
 
 SERIALIZATION_ACCESS(Scene)
@@ -60,6 +64,36 @@ public:
     /** Factory method to create an engine-specific model. */
     BRAYNS_API virtual ModelPtr createModel() const = 0;
 
+    /**
+     * Set the viewpoint used to select the level of detail of the model
+     * instances from their projected size on the next commit().
+     *
+     * @param position the position of the camera
+     * @param focalLength the size in pixels of a unit-sized object at a unit
+     *                    distance, 0 to always use the finest level
+     */
+    void setLODViewpoint(const Vector3d& position, const double focalLength)
+    {
+        _lodPosition = position;
+        _lodFocalLength = focalLength;
+    }
+
+    /**
+     * Set the view frustum of the camera, used on the next commit() to load
+     * the visible parts of paged volumes and to cull the model instances out
+     * of view.
+     */
+    void setViewFrustum(const Frustum& frustum) { _viewFrustum = frustum; }
+
+    /**
+     * Set the depth of the previous frame, used on the next commit() to cull
+     * the hidden model instances. An empty map culls nothing.
+     */
+    void setOcclusionMap(OcclusionMap occlusionMap)
+    {
+        _occlusionMap = std::move(occlusionMap);
+    }
+
     //@}
 
     /**
@@ -121,6 +155,25 @@ public:
        @return the clip planes
     */
     const ClipPlanes& getClipPlanes() const { return _clipPlanes; }
+
+    /**
+     * Tells whether the materials of a model discard all its geometry outside
+     * of the clip planes. Only the plugin defining these materials knows.
+     */
+    using ClippedByPlanesCallback = std::function<bool(const Model&)>;
+    void setClippedByPlanesCallback(const ClippedByPlanesCallback& callback)
+    {
+        _clippedByPlanesCallback = callback;
+    }
+
+    /**
+     * @return true if the geometry of the model outside of the clip planes is
+     *         discarded, allowing to cull it. False if no callback is set.
+     */
+    bool isModelClippedByPlanes(const Model& model) const
+    {
+        return _clippedByPlanesCallback && _clippedByPlanesCallback(model);
+    }
     /** @return the current size in bytes of the loaded geometry. */
     size_t getSizeInBytes() const;
 
@@ -180,6 +233,8 @@ public:
 
     /** @return the registry for all supported loaders of this scene. */
     LoaderRegistry& getLoaderRegistry() { return _loaderRegistry; }
+    /** @return the on-disk cache of the models loaded from files. */
+    const LoaderCache& getLoaderCache() const { return _loaderCache; }
     /** @internal */
     auto acquireReadAccess() const
     {
@@ -208,10 +263,17 @@ protected:
 
     LightManager _lightManager;
     ClipPlanes _clipPlanes;
+    ClippedByPlanesCallback _clippedByPlanesCallback;
 
     LoaderRegistry _loaderRegistry;
+    LoaderCache _loaderCache;
     Boxd _bounds;
 
+    Vector3d _lodPosition;
+    double _lodFocalLength{0};
+    Frustum _viewFrustum;
+    OcclusionMap _occlusionMap;
+
 private:
     SERIALIZATION_FRIEND(Scene)
 };
@@ -20,6 +20,7 @@
 
 #include "ArchiveLoader.h"
 
+#include <brayns/common/loader/SpoolingLoaderStream.h>
 #include <brayns/common/log.h>
 #include <brayns/common/utils/filesystem.h>
 #include <brayns/common/utils/utils.h>
@@ -252,6 +253,17 @@ ModelDescriptorPtr ArchiveLoader::importFromFile(
     return loadExtracted(tmpFolder.path, callback, properties);
 }
 
+LoaderStreamPtr ArchiveLoader::createStream(
+    const std::string& type, const std::string& name BRAYNS_UNUSED,
+    const size_t size BRAYNS_UNUSED, const LoaderProgress& callback,
+    const PropertyMap& properties) const
+{
+    // Extraction needs random access, spool the archive to a temporary file
+    // instead of buffering it in memory
+    return std::make_shared<SpoolingLoaderStream>(*this, type, callback,
+                                                  properties);
+}
+
 std::string ArchiveLoader::getName() const
 {
     return LOADER_NAME;
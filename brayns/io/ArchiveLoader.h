@@ -37,6 +37,8 @@ public:
 
     bool isSupported(const std::string& filename,
                      const std::string& extension) const final;
+    /** The extracted files are imported with the defaults of other loaders */
+    bool isCacheable(const std::string&) const final { return false; }
     ModelDescriptorPtr importFromBlob(
         Blob&& blob, const LoaderProgress& callback,
         const PropertyMap& properties) const final;
@@ -45,6 +47,11 @@ public:
         const std::string& filename, const LoaderProgress& callback,
         const PropertyMap& properties) const final;
 
+    LoaderStreamPtr createStream(const std::string& type,
+                                 const std::string& name, const size_t size,
+                                 const LoaderProgress& callback,
+                                 const PropertyMap& properties) const final;
+
 private:
     ModelDescriptorPtr loadExtracted(const std::string& path,
                                      const LoaderProgress& callback,
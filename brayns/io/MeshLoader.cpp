@@ -27,12 +27,17 @@
 #include <assimp/version.h>
 #include <brayns/common/log.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
-#include <numeric>
+#include <set>
 #include <unordered_map>
 
+#include <brayns/common/geometry/TriangleMeshSimplifier.h>
 #include <brayns/common/utils/filesystem.h>
 #include <brayns/common/utils/stringUtils.h>
+#include <brayns/common/utils/utils.h>
 #include <brayns/engine/Material.h>
 #include <brayns/engine/Model.h>
 #include <brayns/engine/Scene.h>
@@ -41,12 +46,18 @@
 #include "assimpImporters/PlyLoader.h"
 #endif
 #include "assimpImporters/ObjFileImporter.h"
+#include "meshReaders.h"
 
 namespace brayns
 {
 namespace
 {
 const auto PROP_GEOMETRY_QUALITY = "geometryQuality";
+const auto PROP_LOD_LEVELS = "lodLevels";
+const auto PROP_LOD_REDUCTION = "lodReduction";
+
+const int32_t DEFAULT_LOD_LEVELS = 0;
+const double DEFAULT_LOD_REDUCTION = 0.25;
 
 const auto LOADER_NAME = "mesh";
 
@@ -118,6 +129,77 @@ Assimp::Importer createImporter(const LoaderProgress& callback,
     importer.RegisterLoader(new Assimp::ObjFileImporter());
     return importer;
 }
+
+const aiScene* readFile(Assimp::Importer& importer, const std::string& fileName,
+                        const size_t quality)
+{
+    const fs::path file = fileName;
+    if (!importer.IsExtensionSupported(file.extension().c_str()))
+    {
+        std::stringstream msg;
+        msg << "File extension " << file.extension() << " is not supported";
+        throw std::runtime_error(msg.str());
+    }
+
+    std::ifstream meshFile(fileName, std::ios::in);
+    if (!meshFile.good())
+        throw std::runtime_error("Could not open file " + fileName);
+    meshFile.close();
+
+    const aiScene* aiScene = importer.ReadFile(fileName.c_str(), quality);
+
+    if (!aiScene)
+    {
+        std::stringstream msg;
+        msg << "Error parsing mesh " << fileName.c_str() << ": "
+            << importer.GetErrorString();
+        throw std::runtime_error(msg.str());
+    }
+
+    if (!aiScene->HasMeshes())
+        throw std::runtime_error("Error finding meshes in scene");
+    return aiScene;
+}
+
+/**
+ * Binary PLY and ASCII OBJ files are read without assimp when the geometry
+ * quality requests no other post-processing than triangulation and normals.
+ */
+bool readMeshDirectly(const std::string& fileName,
+                      const GeometryQuality geometryQuality,
+                      TriangleMesh& mesh)
+{
+    if (geometryQuality == GeometryQuality::medium)
+        return false;
+    return readMeshFile(fileName, geometryQuality == GeometryQuality::high,
+                        mesh);
+}
+
+template <typename T>
+void append(std::vector<T>& to, const std::vector<T>& from)
+{
+    to.insert(to.end(), from.begin(), from.end());
+}
+
+/** Appends the source mesh to the target mesh, and frees the source. */
+void mergeMesh(TriangleMesh& target, TriangleMesh&& source)
+{
+    if (target.vertices.empty())
+    {
+        target = std::move(source);
+        return;
+    }
+
+    const auto offset = Vector3ui(target.vertices.size());
+    append(target.vertices, source.vertices);
+    append(target.normals, source.normals);
+    append(target.colors, source.colors);
+    append(target.textureCoordinates, source.textureCoordinates);
+    target.indices.reserve(target.indices.size() + source.indices.size());
+    for (const auto& index : source.indices)
+        target.indices.push_back(index + offset);
+    source = TriangleMesh();
+}
 }
 
 MeshLoader::MeshLoader(Scene& scene)
@@ -132,6 +214,19 @@ MeshLoader::MeshLoader(Scene& scene, const GeometryParameters& params)
                            enumToString(params.getGeometryQuality()),
                            enumNames<brayns::GeometryQuality>(),
                            {"Geometry quality"}});
+    _defaults.setProperty({PROP_LOD_LEVELS,
+                           DEFAULT_LOD_LEVELS,
+                           0,
+                           8,
+                           {"Levels of detail",
+                            "Number of simplified versions of the meshes"}});
+    _defaults.setProperty(
+        {PROP_LOD_REDUCTION,
+         DEFAULT_LOD_REDUCTION,
+         0.01,
+         0.9,
+         {"Level of detail reduction",
+          "Fraction of the triangles kept from one level to the next"}});
 }
 
 bool MeshLoader::isSupported(const std::string& filename BRAYNS_UNUSED,
@@ -141,6 +236,16 @@ bool MeshLoader::isSupported(const std::string& filename BRAYNS_UNUSED,
     return std::find(types.begin(), types.end(), extension) != types.end();
 }
 
+bool MeshLoader::isCacheable(const std::string& filename) const
+{
+    // These formats may read their materials or buffers from other files
+    auto extension = extractExtension(filename);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   ::tolower);
+    const std::set<std::string> types = {"obj", "gltf"};
+    return types.count(extension) == 0;
+}
+
 ModelDescriptorPtr MeshLoader::importFromFile(
     const std::string& fileName, const LoaderProgress& callback,
     const PropertyMap& inProperties) const
@@ -153,9 +258,14 @@ ModelDescriptorPtr MeshLoader::importFromFile(
         stringToEnum<GeometryQuality>(properties.getProperty<std::string>(
             PROP_GEOMETRY_QUALITY, enumToString(GeometryQuality::high)));
 
+    const auto nbLODs =
+        properties.getProperty<int32_t>(PROP_LOD_LEVELS, DEFAULT_LOD_LEVELS);
+    const auto lodReduction = properties.getProperty<double>(
+        PROP_LOD_REDUCTION, DEFAULT_LOD_REDUCTION);
+
     auto model = _scene.createModel();
     auto metadata = importMesh(fileName, callback, *model, {}, NO_MATERIAL,
-                               geometryQuality);
+                               geometryQuality, nbLODs, lodReduction);
 
     Transformation transformation;
     transformation.setRotationCenter(model->getBounds().getCenter());
@@ -178,6 +288,45 @@ ModelDescriptorPtr MeshLoader::importFromBlob(
         stringToEnum<GeometryQuality>(properties.getProperty<std::string>(
             PROP_GEOMETRY_QUALITY, enumToString(GeometryQuality::high)));
 
+    const auto nbLODs =
+        properties.getProperty<int32_t>(PROP_LOD_LEVELS, DEFAULT_LOD_LEVELS);
+    const auto lodReduction = properties.getProperty<double>(
+        PROP_LOD_REDUCTION, DEFAULT_LOD_REDUCTION);
+
+    auto model = _scene.createModel();
+    ModelMetadata metadata;
+
+    TriangleMesh mesh;
+    if (geometryQuality != GeometryQuality::medium &&
+        readMesh(reinterpret_cast<const char*>(blob.data.data()),
+                 blob.data.size(), blob.type,
+                 geometryQuality == GeometryQuality::high, mesh))
+    {
+        callback.updateProgress("Post-processing...",
+                                (LOADING_FRACTION) / TOTAL_PROGRESS);
+        metadata = _postLoad(std::move(mesh), *model, Matrix4f(1), NO_MATERIAL,
+                             nbLODs, lodReduction, callback);
+    }
+    else
+        metadata = _importBlob(blob, *model, geometryQuality, nbLODs,
+                               lodReduction, callback);
+
+    Transformation transformation;
+    transformation.setRotationCenter(model->getBounds().getCenter());
+
+    auto modelDescriptor =
+        std::make_shared<ModelDescriptor>(std::move(model), blob.name,
+                                          metadata);
+    modelDescriptor->setTransformation(transformation);
+    return modelDescriptor;
+}
+
+ModelMetadata MeshLoader::_importBlob(const Blob& blob, Model& model,
+                                      const GeometryQuality geometryQuality,
+                                      const size_t nbLODs,
+                                      const double lodReduction,
+                                      const LoaderProgress& callback) const
+{
     auto importer = createImporter(callback, blob.name);
     const aiScene* aiScene =
         importer.ReadFileFromMemory(blob.data.data(), blob.data.size(),
@@ -193,19 +342,8 @@ ModelDescriptorPtr MeshLoader::importFromBlob(
     callback.updateProgress("Post-processing...",
                             (LOADING_FRACTION) / TOTAL_PROGRESS);
 
-    auto model = _scene.createModel();
-
-    auto metadata =
-        _postLoad(aiScene, *model, Matrix4f(1), NO_MATERIAL, "", callback);
-
-    Transformation transformation;
-    transformation.setRotationCenter(model->getBounds().getCenter());
-
-    auto modelDescriptor =
-        std::make_shared<ModelDescriptor>(std::move(model), blob.name,
-                                          metadata);
-    modelDescriptor->setTransformation(transformation);
-    return modelDescriptor;
+    return _postLoad(aiScene, model, Matrix4f(1), NO_MATERIAL, "", nbLODs,
+                     lodReduction, callback);
 }
 
 void MeshLoader::_createMaterials(Model& model, const aiScene* aiScene,
@@ -301,6 +439,8 @@ ModelMetadata MeshLoader::_postLoad(const aiScene* aiScene, Model& model,
                                     const Matrix4f& transformation,
                                     const size_t materialId,
                                     const std::string& folder,
+                                    const size_t nbLODs,
+                                    const double lodReduction,
                                     const LoaderProgress& callback) const
 {
     // Always create placeholder material since it is not guaranteed to exist
@@ -309,6 +449,115 @@ ModelMetadata MeshLoader::_postLoad(const aiScene* aiScene, Model& model,
     if (materialId == NO_MATERIAL)
         _createMaterials(model, aiScene, folder);
 
+    _addMeshes(aiScene, model.getTriangleMeshes(), transformation, materialId,
+               callback);
+
+    size_t numVertices = 0;
+    size_t numFaces = 0;
+    for (size_t m = 0; m < aiScene->mNumMeshes; ++m)
+    {
+        numVertices += aiScene->mMeshes[m]->mNumVertices;
+        numFaces += aiScene->mMeshes[m]->mNumFaces;
+    }
+    return _finishLoad(model, aiScene->mNumMeshes, numVertices, numFaces,
+                       nbLODs, lodReduction, callback);
+}
+
+ModelMetadata MeshLoader::_postLoad(TriangleMesh&& mesh, Model& model,
+                                    const Matrix4f& transformation,
+                                    const size_t materialId,
+                                    const size_t nbLODs,
+                                    const double lodReduction,
+                                    const LoaderProgress& callback) const
+{
+    // Always create placeholder material since it is not guaranteed to exist
+    model.createMaterial(materialId, "default");
+
+    // Same default material as the one of the assimp PLY and OBJ importers
+    size_t meshMaterialId = materialId;
+    if (materialId == NO_MATERIAL)
+    {
+        meshMaterialId = 0;
+        auto material = model.createMaterial(meshMaterialId, "DefaultMaterial");
+        material->setDiffuseColor({0.6, 0.6, 0.6});
+    }
+
+    const auto numVertices = mesh.vertices.size();
+    const auto numFaces = mesh.indices.size();
+    _addMesh(std::move(mesh), model.getTriangleMeshes(), transformation,
+             meshMaterialId);
+    return _finishLoad(model, 1, numVertices, numFaces, nbLODs, lodReduction,
+                       callback);
+}
+
+ModelMetadata MeshLoader::_finishLoad(Model& model, const size_t numMeshes,
+                                      const size_t numVertices,
+                                      const size_t numFaces,
+                                      const size_t nbLODs,
+                                      const double lodReduction,
+                                      const LoaderProgress& callback) const
+{
+    if (nbLODs > 0)
+    {
+        callback.updateProgress("Simplifying meshes...", 1.f);
+        _createLODs(model, nbLODs, lodReduction);
+    }
+
+    callback.updateProgress("Post-processing...", 1.f);
+
+    ModelMetadata metadata{{"meshes", std::to_string(numMeshes)},
+                           {"vertices", std::to_string(numVertices)},
+                           {"faces", std::to_string(numFaces)}};
+    const auto& lods = model.getTriangleMeshLODs();
+    if (!lods.empty())
+    {
+        std::string faces;
+        for (size_t level = 1; level <= lods.size(); ++level)
+            faces += (level > 1 ? " " : "") +
+                     std::to_string(model.getNbTriangles(level));
+        metadata["lod_faces"] = faces;
+    }
+    return metadata;
+}
+
+void MeshLoader::_createLODs(Model& model, const size_t nbLODs,
+                             const double lodReduction) const
+{
+    const auto& triangleMeshes =
+        static_cast<const Model&>(model).getTriangleMeshes();
+    std::vector<size_t> materialIds;
+    std::vector<const TriangleMesh*> meshes;
+    for (const auto& i : triangleMeshes)
+    {
+        materialIds.push_back(i.first);
+        meshes.push_back(&i.second);
+    }
+
+    // The meshes of each material are simplified independently
+    std::vector<std::vector<TriangleMesh>> levels(meshes.size());
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < int64_t(meshes.size()); ++i)
+        levels[i] = createLODs(*meshes[i], nbLODs, lodReduction);
+
+    // A material without a coarser level is not copied into it, its coarsest
+    // level is used instead
+    size_t nbLevels = 0;
+    for (const auto& level : levels)
+        nbLevels = std::max(nbLevels, level.size());
+
+    auto& lods = model.getTriangleMeshLODs();
+    lods.clear();
+    lods.resize(nbLevels);
+    for (size_t i = 0; i < meshes.size(); ++i)
+        for (size_t level = 0; level < levels[i].size(); ++level)
+            lods[level][materialIds[i]] = std::move(levels[i][level]);
+}
+
+void MeshLoader::_addMeshes(const aiScene* aiScene, TriangleMeshMap& meshes,
+                            const Matrix4f& transformation,
+                            const size_t materialId,
+                            const LoaderProgress& callback) const
+{
     std::unordered_map<size_t, size_t> nbVertices;
     std::unordered_map<size_t, size_t> nbFaces;
     std::unordered_map<size_t, size_t> indexOffsets;
@@ -330,16 +579,20 @@ ModelMetadata MeshLoader::_postLoad(const aiScene* aiScene, Model& model,
 
     for (const auto& i : nbVertices)
     {
-        auto& triangleMeshes = model.getTriangleMeshes()[i.first];
-        triangleMeshes.vertices.reserve(i.second);
-        triangleMeshes.normals.reserve(i.second);
-        triangleMeshes.textureCoordinates.reserve(i.second);
-        triangleMeshes.colors.reserve(i.second);
+        // Meshes of previous imports may already use the same material
+        auto& triangleMeshes = meshes[i.first];
+        const auto size = triangleMeshes.vertices.size();
+        indexOffsets[i.first] = size;
+        triangleMeshes.vertices.reserve(size + i.second);
+        triangleMeshes.normals.reserve(size + i.second);
+        triangleMeshes.textureCoordinates.reserve(size + i.second);
+        triangleMeshes.colors.reserve(size + i.second);
     }
     for (const auto& i : nbFaces)
     {
-        auto& triangleMeshes = model.getTriangleMeshes()[i.first];
-        triangleMeshes.indices.reserve(i.second);
+        auto& triangleMeshes = meshes[i.first];
+        triangleMeshes.indices.reserve(triangleMeshes.indices.size() +
+                                       i.second);
     }
 
     for (size_t m = 0; m < aiScene->mNumMeshes; ++m)
@@ -347,7 +600,7 @@ ModelMetadata MeshLoader::_postLoad(const aiScene* aiScene, Model& model,
         auto mesh = aiScene->mMeshes[m];
         auto id =
             (materialId != NO_MATERIAL ? materialId : mesh->mMaterialIndex);
-        auto& triangleMeshes = model.getTriangleMeshes()[id];
+        auto& triangleMeshes = meshes[id];
 
         for (size_t i = 0; i < mesh->mNumVertices; ++i)
         {
@@ -403,19 +656,29 @@ ModelMetadata MeshLoader::_postLoad(const aiScene* aiScene, Model& model,
                                   POST_LOADING_FRACTION)) /
                                     TOTAL_PROGRESS);
     }
+}
 
-    callback.updateProgress("Post-processing...", 1.f);
+void MeshLoader::_addMesh(TriangleMesh&& mesh, TriangleMeshMap& meshes,
+                          const Matrix4f& transformation,
+                          const size_t materialId) const
+{
+    if (transformation != Matrix4f(1))
+    {
+#pragma omp parallel for
+        for (int64_t i = 0; i < int64_t(mesh.vertices.size()); ++i)
+        {
+            auto& vertex = mesh.vertices[i];
+            vertex = Vector3f(transformation * Vector4f(vertex, 1.f));
+            if (!mesh.normals.empty())
+            {
+                auto& normal = mesh.normals[i];
+                normal = Vector3f(transformation * Vector4f(normal, 0.f));
+            }
+        }
+    }
 
-    const auto numVertices =
-        std::accumulate(nbVertices.begin(), nbVertices.end(), 0,
-                        [](auto value, auto& i) { return value + i.second; });
-    const auto numFaces =
-        std::accumulate(nbFaces.begin(), nbFaces.end(), 0,
-                        [](auto value, auto& i) { return value + i.second; });
-    ModelMetadata metadata{{"meshes", std::to_string(aiScene->mNumMeshes)},
-                           {"vertices", std::to_string(numVertices)},
-                           {"faces", std::to_string(numFaces)}};
-    return metadata;
+    // Meshes of previous imports may already use the same material
+    mergeMesh(meshes[materialId], std::move(mesh));
 }
 
 size_t MeshLoader::_getQuality(const GeometryQuality geometryQuality) const
@@ -435,37 +698,21 @@ size_t MeshLoader::_getQuality(const GeometryQuality geometryQuality) const
 ModelMetadata MeshLoader::importMesh(
     const std::string& fileName, const LoaderProgress& callback, Model& model,
     const Matrix4f& transformation, const size_t defaultMaterialId,
-    const GeometryQuality geometryQuality) const
+    const GeometryQuality geometryQuality, const size_t nbLODs,
+    const double lodReduction) const
 {
-    const fs::path file = fileName;
-
-    auto importer = createImporter(callback, fileName);
-
-    if (!importer.IsExtensionSupported(file.extension().c_str()))
+    TriangleMesh mesh;
+    if (readMeshDirectly(fileName, geometryQuality, mesh))
     {
-        std::stringstream msg;
-        msg << "File extension " << file.extension() << " is not supported";
-        throw std::runtime_error(msg.str());
+        callback.updateProgress("Post-processing...",
+                                (LOADING_FRACTION) / TOTAL_PROGRESS);
+        return _postLoad(std::move(mesh), model, transformation,
+                         defaultMaterialId, nbLODs, lodReduction, callback);
     }
 
-    std::ifstream meshFile(fileName, std::ios::in);
-    if (!meshFile.good())
-        throw std::runtime_error("Could not open file " + fileName);
-    meshFile.close();
-
+    auto importer = createImporter(callback, fileName);
     const aiScene* aiScene =
-        importer.ReadFile(fileName.c_str(), _getQuality(geometryQuality));
-
-    if (!aiScene)
-    {
-        std::stringstream msg;
-        msg << "Error parsing mesh " << fileName.c_str() << ": "
-            << importer.GetErrorString();
-        throw std::runtime_error(msg.str());
-    }
-
-    if (!aiScene->HasMeshes())
-        throw std::runtime_error("Error finding meshes in scene");
+        readFile(importer, fileName, _getQuality(geometryQuality));
 
     callback.updateProgress("Post-processing...",
                             (LOADING_FRACTION) / TOTAL_PROGRESS);
@@ -473,7 +720,132 @@ ModelMetadata MeshLoader::importMesh(
     fs::path filepath = fileName;
 
     return _postLoad(aiScene, model, transformation, defaultMaterialId,
-                     filepath.parent_path().string(), callback);
+                     filepath.parent_path().string(), nbLODs, lodReduction,
+                     callback);
+}
+
+strings MeshLoader::importMeshes(const std::vector<MeshFile>& files,
+                                 Model& model,
+                                 const GeometryQuality geometryQuality,
+                                 const LoaderProgress& callback) const
+{
+    const auto quality = _getQuality(geometryQuality);
+    const LoaderProgress noProgress;
+
+    std::vector<TriangleMeshMap> threadMeshes;
+    std::vector<strings> threadErrors;
+    std::atomic_size_t nbImported{0};
+    std::atomic_bool cancelled{false};
+    std::exception_ptr callbackException;
+
+#pragma omp parallel
+    {
+#pragma omp single
+        {
+#ifdef BRAYNS_USE_OPENMP
+            const size_t nbThreads = omp_get_num_threads();
+#else
+            const size_t nbThreads = 1;
+#endif
+            threadMeshes.resize(nbThreads);
+            threadErrors.resize(nbThreads);
+        }
+
+#ifdef BRAYNS_USE_OPENMP
+        const size_t thread = omp_get_thread_num();
+#else
+        const size_t thread = 0;
+#endif
+        auto& meshes = threadMeshes[thread];
+        auto& errors = threadErrors[thread];
+        auto importer = createImporter(noProgress, "");
+
+#pragma omp for schedule(dynamic)
+        for (int64_t i = 0; i < int64_t(files.size()); ++i)
+        {
+            if (cancelled)
+                continue;
+
+            const auto& file = files[i];
+            try
+            {
+                TriangleMesh mesh;
+                if (readMeshDirectly(file.fileName, geometryQuality, mesh))
+                    _addMesh(std::move(mesh), meshes, file.transformation,
+                             file.materialId);
+                else
+                {
+                    const aiScene* aiScene =
+                        readFile(importer, file.fileName, quality);
+                    _addMeshes(aiScene, meshes, file.transformation,
+                               file.materialId, noProgress);
+                    importer.FreeScene();
+                }
+            }
+            catch (const std::runtime_error& e)
+            {
+                errors.push_back(e.what());
+            }
+
+            // Only the main thread reports progress, which is also where
+            // cancellation is signaled
+            ++nbImported;
+            if (thread == 0)
+            {
+                try
+                {
+                    callback.updateProgress("Loading meshes...",
+                                            float(nbImported) / files.size());
+                }
+                catch (...)
+                {
+                    callbackException = std::current_exception();
+                    cancelled = true;
+                }
+            }
+        }
+    }
+
+    if (callbackException)
+        std::rethrow_exception(callbackException);
+
+    // Placeholder materials, and one merge of the thread buffers per material
+    std::set<size_t> materialIds;
+    for (const auto& file : files)
+        materialIds.insert(file.materialId);
+    const auto& materials = model.getMaterials();
+    for (const auto materialId : materialIds)
+        if (materials.find(materialId) == materials.end())
+            model.createMaterial(materialId, "default");
+
+    std::set<size_t> meshIds;
+    for (const auto& meshes : threadMeshes)
+        for (const auto& i : meshes)
+            meshIds.insert(i.first);
+
+    auto& triangleMeshes = model.getTriangleMeshes();
+    std::vector<size_t> targetIds(meshIds.begin(), meshIds.end());
+    std::vector<TriangleMesh*> targets;
+    for (const auto id : targetIds)
+        targets.push_back(&triangleMeshes[id]);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t t = 0; t < int64_t(targets.size()); ++t)
+    {
+        auto& target = *targets[t];
+        for (auto& meshes : threadMeshes)
+        {
+            auto it = meshes.find(targetIds[t]);
+            if (it == meshes.end())
+                continue;
+            mergeMesh(target, std::move(it->second));
+        }
+    }
+
+    strings errors;
+    for (auto& threadError : threadErrors)
+        errors.insert(errors.end(), threadError.begin(), threadError.end());
+    return errors;
 }
 
 std::string MeshLoader::getName() const
@@ -27,8 +27,20 @@ struct aiScene;
 
 namespace brayns
 {
+/** A mesh file to import with MeshLoader::importMeshes(). */
+struct MeshFile
+{
+    std::string fileName;
+    Matrix4f transformation;
+    size_t materialId;
+};
+
 /** Loads meshes from files using the assimp library
  * http://assimp.sourceforge.net
+ *
+ * Binary PLY and ASCII OBJ files without materials are read directly into the
+ * model with a parallel parser instead, unless the medium geometry quality
+ * requests more assimp post-processing.
  */
 class MeshLoader : public Loader
 {
@@ -42,6 +54,7 @@ public:
 
     bool isSupported(const std::string& filename,
                      const std::string& extension) const final;
+    bool isCacheable(const std::string& filename) const final;
 
     ModelDescriptorPtr importFromFile(
         const std::string& fileName, const LoaderProgress& callback,
@@ -51,11 +64,35 @@ public:
         Blob&& blob, const LoaderProgress& callback,
         const PropertyMap& properties) const final;
 
+    /**
+     * Import the given mesh file into the model.
+     *
+     * @param nbLODs the number of coarser levels of detail to create by
+     *               simplifying the meshes, 0 to disable the simplification
+     * @param lodReduction the fraction of the triangles kept from one level of
+     *                     detail to the next
+     */
     ModelMetadata importMesh(const std::string& fileName,
                              const LoaderProgress& callback, Model& model,
                              const Matrix4f& transformation,
                              const size_t defaultMaterialId,
-                             const GeometryQuality geometryQuality) const;
+                             const GeometryQuality geometryQuality,
+                             const size_t nbLODs = 0,
+                             const double lodReduction = 0.25) const;
+
+    /**
+     * Import the given mesh files concurrently into the model. Each thread
+     * reuses its own assimp importer and fills thread-local buffers, which
+     * are merged into the model once per material at the end. Placeholder
+     * materials are created for the materials of the files.
+     *
+     * @return the errors of the files which failed to load, those files are
+     *         skipped
+     * @throw the exception thrown by the callback, e.g. on cancellation
+     */
+    strings importMeshes(const std::vector<MeshFile>& files, Model& model,
+                         const GeometryQuality geometryQuality,
+                         const LoaderProgress& callback) const;
 
 private:
     PropertyMap _defaults;
@@ -63,11 +100,34 @@ private:
     void _createMaterials(Model& model, const aiScene* aiScene,
                           const std::string& folder) const;
 
+    ModelMetadata _importBlob(const Blob& blob, Model& model,
+                              const GeometryQuality geometryQuality,
+                              const size_t nbLODs, const double lodReduction,
+                              const LoaderProgress& callback) const;
+
     ModelMetadata _postLoad(const aiScene* aiScene, Model& model,
                             const Matrix4f& transformation,
                             const size_t defaultMaterial,
-                            const std::string& folder,
+                            const std::string& folder, const size_t nbLODs,
+                            const double lodReduction,
+                            const LoaderProgress& callback) const;
+    ModelMetadata _postLoad(TriangleMesh&& mesh, Model& model,
+                            const Matrix4f& transformation,
+                            const size_t defaultMaterial, const size_t nbLODs,
+                            const double lodReduction,
                             const LoaderProgress& callback) const;
+    ModelMetadata _finishLoad(Model& model, const size_t numMeshes,
+                              const size_t numVertices, const size_t numFaces,
+                              const size_t nbLODs, const double lodReduction,
+                              const LoaderProgress& callback) const;
+    void _createLODs(Model& model, const size_t nbLODs,
+                     const double lodReduction) const;
+    void _addMeshes(const aiScene* aiScene, TriangleMeshMap& meshes,
+                    const Matrix4f& transformation, const size_t materialId,
+                    const LoaderProgress& callback) const;
+    void _addMesh(TriangleMesh&& mesh, TriangleMeshMap& meshes,
+                  const Matrix4f& transformation,
+                  const size_t materialId) const;
     size_t _getQuality(const GeometryQuality geometryQuality) const;
 };
 } // namespace brayns
@@ -29,12 +29,18 @@
 #include <brayns/engine/Scene.h>
 
 #include <assert.h>
+#include <cctype>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <unordered_map>
 
 namespace
 {
 const auto PROP_RADIUS_MULTIPLIER = "radiusMultiplier";
 const auto PROP_COLOR_SCHEME = "colorScheme";
+const auto PROP_BIOLOGICAL_ASSEMBLY = "biologicalAssembly";
 const auto LOADER_NAME = "protein";
 }
 
@@ -49,20 +55,6 @@ struct PDBCellPositions
     Vector3f unknown;
 };
 
-/** Structure defining an atom as it is stored in a PDB file
- */
-struct Atom
-{
-    int processed;
-    int id;
-    int index;
-    Vector3f position;
-    float radius;
-    int materialId;
-    int chainId;
-    int residue;
-};
-
 /** Structure defining an atom radius in microns
  */
 struct AtomicRadius
@@ -315,6 +307,267 @@ static AtomicRadius atomic_radii[colorMapSize] = // atomic radii in microns
      {"OXT", 25.f, 112},
      {"P", 25.f, 113}};
 
+namespace
+{
+// Positions are converted from angstrom to nanometers
+constexpr float POSITION_SCALE = 0.01f;
+// Radii are converted from picometers
+constexpr float RADIUS_SCALE = 0.0001f;
+
+// Files are parsed in parallel in chunks of this size
+constexpr size_t CHUNK_SIZE = 1 << 20;
+
+/** Packs an upper case element symbol of up to 4 characters in a key. */
+uint32_t elementKey(const char* begin, const char* end)
+{
+    uint32_t key = 0;
+    for (auto c = begin; c != end; ++c)
+        if (*c != ' ')
+            key = (key << 8) | static_cast<unsigned char>(std::toupper(*c));
+    return key;
+}
+
+struct Element
+{
+    int32_t colorIndex{-1};
+    float radius{DEFAULT_RADIUS};
+};
+
+/** Colors and radii of the elements, indexed by their symbol. */
+const std::unordered_map<uint32_t, Element>& getElements()
+{
+    static const auto elements = [] {
+        std::unordered_map<uint32_t, Element> result;
+        for (size_t i = 0; i < colorMapSize; ++i)
+        {
+            const auto& symbol = colorMap[i].symbol;
+            if (symbol.empty())
+                continue;
+            auto& element = result[elementKey(symbol.data(),
+                                               symbol.data() + symbol.size())];
+            if (element.colorIndex < 0)
+                element.colorIndex = static_cast<int32_t>(i);
+        }
+        std::set<uint32_t> found;
+        for (size_t i = 0; i < colorMapSize; ++i)
+        {
+            const auto& symbol = atomic_radii[i].Symbol;
+            if (symbol.empty())
+                continue;
+            const auto key =
+                elementKey(symbol.data(), symbol.data() + symbol.size());
+            if (found.insert(key).second)
+                result[key].radius = atomic_radii[i].radius;
+        }
+        return result;
+    }();
+    return elements;
+}
+
+/** Parses the integer of a fixed-width field, 0 if the field is blank. */
+int32_t parseInt(const char* begin, const char* end)
+{
+    while (begin != end && *begin == ' ')
+        ++begin;
+    bool negative = false;
+    if (begin != end && (*begin == '-' || *begin == '+'))
+        negative = *begin++ == '-';
+    int32_t value = 0;
+    for (; begin != end && *begin >= '0' && *begin <= '9'; ++begin)
+        value = value * 10 + (*begin - '0');
+    return negative ? -value : value;
+}
+
+/** Parses the decimal number of a fixed-width field, without allocating. */
+float parseFloat(const char* begin, const char* end)
+{
+    char buffer[32];
+    const size_t size = std::min<size_t>(end - begin, sizeof(buffer) - 1);
+    std::copy(begin, begin + size, buffer);
+    buffer[size] = '\0';
+    return std::strtof(buffer, nullptr);
+}
+
+/** @return the offset of the first line starting at or after offset */
+size_t lineStart(const std::string& data, const size_t offset)
+{
+    if (offset == 0 || offset >= data.size())
+        return std::min(offset, data.size());
+    const auto newLine = data.find('\n', offset - 1);
+    return newLine == std::string::npos ? data.size() : newLine + 1;
+}
+
+/** First biological assembly described by the REMARK 350 records */
+struct Assembly
+{
+    std::vector<Matrix4d> operators;
+    std::vector<char> chains;
+    size_t nbChainGroups{0};
+    bool hasModels{false};
+};
+
+Assembly parseAssembly(const std::string& data)
+{
+    Assembly assembly;
+    bool firstBiomolecule = false;
+
+    // Only the header lines are copied, into the same buffer, the atom
+    // records after it are never read
+    std::string line;
+    for (size_t begin = 0; begin < data.size();)
+    {
+        auto end = data.find('\n', begin);
+        if (end == std::string::npos)
+            end = data.size();
+        line.assign(data, begin, end - begin);
+        begin = end + 1;
+
+        // Assemblies are described in the header
+        if (line.compare(0, 4, "ATOM") == 0 ||
+            line.compare(0, 6, "HETATM") == 0)
+            break;
+        if (line.compare(0, 5, "MODEL") == 0)
+        {
+            assembly.hasModels = true;
+            break;
+        }
+        if (line.compare(0, 10, "REMARK 350") != 0)
+            continue;
+
+        auto pos = line.find("BIOMOLECULE:");
+        if (pos != std::string::npos)
+        {
+            firstBiomolecule = assembly.operators.empty() &&
+                               assembly.nbChainGroups == 0 &&
+                               std::atoi(line.c_str() + pos + 12) == 1;
+            continue;
+        }
+        if (!firstBiomolecule)
+            continue;
+
+        pos = line.find("CHAINS:");
+        if (pos != std::string::npos)
+        {
+            // Continuation lines only add chains to the current group
+            if (line.find("APPLY") != std::string::npos)
+                ++assembly.nbChainGroups;
+            for (size_t i = pos + 7; i < line.size(); ++i)
+                if (std::isalnum(static_cast<unsigned char>(line[i])))
+                    assembly.chains.push_back(line[i]);
+            continue;
+        }
+
+        pos = line.find("BIOMT");
+        if (pos != std::string::npos && pos + 5 < line.size())
+        {
+            const size_t row = line[pos + 5] - '1';
+            int id = 0;
+            double values[4];
+            if (row > 2 ||
+                sscanf(line.c_str() + pos + 6, "%d %lf %lf %lf %lf", &id,
+                       &values[0], &values[1], &values[2], &values[3]) != 5)
+                continue;
+            if (row == 0)
+                assembly.operators.push_back(Matrix4d(1.));
+            if (assembly.operators.empty())
+                continue;
+            auto& matrix = assembly.operators.back();
+            for (size_t column = 0; column < 4; ++column)
+                matrix[column][row] = values[column];
+        }
+    }
+    return assembly;
+}
+
+/** Fixed-column parser of the ATOM and HETATM records */
+struct AtomParser
+{
+    ColorScheme colorScheme{ColorScheme::none};
+    float radiusMultiplier{1.f};
+    /** Applied to the atom positions, in angstrom */
+    Matrix4d transformation{1.};
+    /** The chains to load, indexed by their identifier */
+    bool chains[256]{};
+
+    void parse(const char* begin, const char* end, SpheresMap& spheres) const
+    {
+        const auto& elements = getElements();
+        const bool identity = transformation == Matrix4d(1.);
+        while (begin < end)
+        {
+            auto lineEnd =
+                static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+            if (!lineEnd)
+                lineEnd = end;
+            const auto line = begin;
+            auto length = static_cast<size_t>(lineEnd - begin);
+            begin = lineEnd + 1;
+
+            if (length > 0 && line[length - 1] == '\r')
+                --length;
+            if (!(length >= 4 && std::strncmp(line, "ATOM", 4) == 0) &&
+                !(length >= 6 && std::strncmp(line, "HETATM", 6) == 0))
+                continue;
+
+            const auto field = [line, length](const size_t first,
+                                              const size_t last) {
+                return std::make_pair(line + std::min(first, length),
+                                      line + std::min(last, length));
+            };
+
+            const char chain = length > 21 ? line[21] : ' ';
+            if (!chains[static_cast<unsigned char>(chain)])
+                continue;
+            const int32_t chainId = length > 21 ? chain - 64 : 0;
+
+            const auto residueField = field(22, 26);
+            const auto residue =
+                parseInt(residueField.first, residueField.second);
+
+            Vector3f position;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const auto coordinate = field(30 + 8 * i, 38 + 8 * i);
+                position[i] = parseFloat(coordinate.first, coordinate.second);
+            }
+            if (!identity)
+                position = Vector3f(transformation *
+                                    Vector4d(Vector3d(position), 1.));
+
+            // Material and radius of the element
+            const auto symbol = field(76, 78);
+            const auto it =
+                elements.find(elementKey(symbol.first, symbol.second));
+            size_t materialId = 0;
+            float radius = DEFAULT_RADIUS;
+            if (it != elements.end())
+            {
+                radius = it->second.radius;
+                if (it->second.colorIndex >= 0)
+                {
+                    switch (colorScheme)
+                    {
+                    case ColorScheme::protein_chains:
+                        materialId = std::abs(chainId);
+                        break;
+                    case ColorScheme::protein_residues:
+                        materialId = std::abs(residue);
+                        break;
+                    default:
+                        materialId = it->second.colorIndex;
+                        break;
+                    }
+                }
+            }
+
+            spheres[materialId].push_back(
+                {POSITION_SCALE * position,
+                 RADIUS_SCALE * radius * radiusMultiplier});
+        }
+    }
+};
+} // namespace
+
 ProteinLoader::ProteinLoader(Scene& scene, const PropertyMap& properties)
     : Loader(scene)
     , _defaults(properties)
@@ -331,6 +584,11 @@ ProteinLoader::ProteinLoader(Scene& scene, const GeometryParameters& params)
     _defaults.setProperty({PROP_RADIUS_MULTIPLIER,
                            static_cast<double>(params.getRadiusMultiplier()),
                            {"Radius multiplier"}});
+    _defaults.setProperty(
+        {PROP_BIOLOGICAL_ASSEMBLY,
+         true,
+         {"Biological assembly",
+          "Instantiate the chains with the BIOMT transformations"}});
 }
 
 bool ProteinLoader::isSupported(const std::string& filename BRAYNS_UNUSED,
@@ -341,7 +599,7 @@ bool ProteinLoader::isSupported(const std::string& filename BRAYNS_UNUSED,
 }
 
 ModelDescriptorPtr ProteinLoader::importFromFile(
-    const std::string& fileName, const LoaderProgress&,
+    const std::string& fileName, const LoaderProgress& callback,
     const PropertyMap& inProperties) const
 {
     // Fill property map since the actual property types are known now.
@@ -354,138 +612,82 @@ ModelDescriptorPtr ProteinLoader::importFromFile(
     const auto colorScheme = stringToEnum<ColorScheme>(
         properties.getProperty<std::string>(PROP_COLOR_SCHEME));
 
-    std::ifstream file(fileName.c_str());
+    const bool loadAssembly =
+        properties.getProperty<bool>(PROP_BIOLOGICAL_ASSEMBLY, true);
+
+    std::ifstream file(fileName.c_str(), std::ios::binary);
     if (!file.is_open())
         throw std::runtime_error("Could not open " + fileName);
 
-    size_t lineIndex{0};
-    std::map<size_t, Spheres> spheres;
+    callback.updateProgress("Loading " + fileName + " ...", 0.f);
+    std::string data;
+    file.seekg(0, std::ios::end);
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(&data[0], data.size());
+    file.close();
 
-    while (file.good())
+    // Only use the assembly if the file has a single model, biological
+    // assembly files already contain the transformed chains as models
+    const auto assembly = parseAssembly(data);
+    const bool instancing = loadAssembly && !assembly.hasModels &&
+                            assembly.nbChainGroups == 1 &&
+                            assembly.operators.size() > 1;
+    if (loadAssembly && assembly.nbChainGroups > 1)
+        BRAYNS_WARN << "Biological assemblies applying different "
+                       "transformations to different chains are not "
+                       "supported, loading the asymmetric unit of "
+                    << fileName << std::endl;
+
+    AtomParser parser;
+    parser.colorScheme = colorScheme;
+    parser.radiusMultiplier = static_cast<float>(radiusMultiplier);
+    if (instancing)
     {
-        std::string line;
-        std::string value;
-        std::getline(file, line);
-        if (line.find("ATOM") == 0 || line.find("HETATM") == 0)
-        {
-            // Atom
-            Atom atom;
-            atom.chainId = 0;
-            atom.residue = 0;
-            atom.processed = false;
-            atom.index = lineIndex;
-            lineIndex++;
-            std::string atomName;
-            std::string atomCode;
-            size_t i = 0;
-            while (i < line.length())
-            {
-                switch (i)
-                {
-                case 6: // ID
-                case 12:
-                case 76: // Atom name
-                case 22: // ChainID
-                case 30: // x
-                case 38: // y
-                case 46: // z
-                    value = "";
-                    break;
-                case 21:
-                    atom.chainId = (int)line.at(i) - 64;
-                    break;
-                case 11:
-                    atom.id = static_cast<int>(atoi(value.c_str()));
-                    break;
-                case 17:
-                    atomCode = value;
-                    break;
-                case 79:
-                    atomName = value;
-                    break;
-                case 26:
-                    atom.residue = static_cast<int>(atoi(value.c_str()));
-                    break;
-                case 37:
-                    atom.position[0] = static_cast<float>(atof(value.c_str()));
-                    break;
-                case 45:
-                    atom.position[1] = static_cast<float>(atof(value.c_str()));
-                    break;
-                case 53:
-                    atom.position[2] = static_cast<float>(atof(value.c_str()));
-                    break;
-                default:
-                    if (line.at(i) != ' ')
-                        value += line.at(i);
-                    break;
-                }
-                i++;
-            }
-
-            // Material
-            atom.materialId = 0;
-            i = 0;
-            bool found = false;
-            while (!found && i < colorMapSize)
-            {
-                if (atomName == colorMap[i].symbol)
-                {
-                    found = true;
-                    switch (colorScheme)
-                    {
-                    case ColorScheme::protein_chains:
-                        atom.materialId = abs(atom.chainId);
-                        break;
-                    case ColorScheme::protein_residues:
-                        atom.materialId = atom.residue;
-                        break;
-                    default:
-                        atom.materialId = static_cast<int>(i);
-                        break;
-                    }
-                }
-                ++i;
-            }
-
-            // Radius
-            atom.radius = DEFAULT_RADIUS;
-            i = 0;
-            found = false;
-            while (!found && i < colorMapSize)
-            {
-                if (atomName == atomic_radii[i].Symbol)
-                {
-                    atom.radius = atomic_radii[i].radius;
-                    found = true;
-                }
-                ++i;
-            }
-
-            // Convert position from nanometers
-            const auto center = 0.01f * atom.position;
+        parser.transformation = assembly.operators[0];
+        for (const auto chain : assembly.chains)
+            parser.chains[static_cast<unsigned char>(chain)] = true;
+    }
+    else
+        std::fill(std::begin(parser.chains), std::end(parser.chains), true);
 
-            // Convert radius from angstrom
-            const float radius = 0.0001f * atom.radius * radiusMultiplier;
+    callback.updateProgress("Parsing atoms...", 0.5f);
 
-            spheres[atom.materialId].push_back({center, radius});
-        }
+    // Parse chunks of lines in parallel and merge them in file order
+    const size_t nbChunks = std::max<size_t>(1, data.size() / CHUNK_SIZE);
+    std::vector<SpheresMap> chunks(nbChunks);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < int64_t(nbChunks); ++i)
+    {
+        const auto begin = lineStart(data, i * data.size() / nbChunks);
+        const auto end = lineStart(data, (i + 1) * data.size() / nbChunks);
+        parser.parse(data.data() + begin, data.data() + end, chunks[i]);
     }
-    file.close();
 
     auto model = _scene.createModel();
 
     // Add materials and spheres
+    auto& spheres = model->getSpheres();
+    for (auto& chunk : chunks)
+    {
+        for (auto& spheresPerMaterial : chunk)
+        {
+            auto& target = spheres[spheresPerMaterial.first];
+            if (target.empty())
+                target = std::move(spheresPerMaterial.second);
+            else
+                target.insert(target.end(), spheresPerMaterial.second.begin(),
+                              spheresPerMaterial.second.end());
+        }
+        chunk.clear();
+    }
     for (const auto& spheresPerMaterial : spheres)
     {
         const auto materialId = spheresPerMaterial.first;
-        auto material =
-            model->createMaterial(materialId, colorMap[materialId].symbol);
-        material->setDiffuseColor({colorMap[materialId].R / 255.f,
-                                   colorMap[materialId].G / 255.f,
-                                   colorMap[materialId].B / 255.f});
-        for (const auto& sphere : spheresPerMaterial.second)
-            model->addSphere(materialId, sphere);
+        const auto& color = colorMap[materialId % colorMapSize];
+        auto material = model->createMaterial(materialId, color.symbol);
+        material->setDiffuseColor(
+            {color.R / 255.f, color.G / 255.f, color.B / 255.f});
     }
 
     Transformation transformation;
@@ -493,6 +695,27 @@ ModelDescriptorPtr ProteinLoader::importFromFile(
     auto modelDescriptor =
         std::make_shared<ModelDescriptor>(std::move(model), fileName);
     modelDescriptor->setTransformation(transformation);
+
+    // The first operator is applied to the atoms, the instances of the other
+    // ones are relative to it
+    if (instancing)
+    {
+        modelDescriptor->addInstance({true, true, transformation});
+        const auto inverse = glm::inverse(assembly.operators[0]);
+        for (size_t i = 1; i < assembly.operators.size(); ++i)
+        {
+            const auto matrix = assembly.operators[i] * inverse;
+            const Quaterniond rotation = glm::quat_cast(matrix);
+            // Translation is applied before the rotation, and converted
+            // from angstrom like the atom positions
+            const Vector3d translation(
+                glm::transpose(matrix) *
+                Vector4d(double(POSITION_SCALE) * Vector3d(matrix[3]), 0.));
+            modelDescriptor->addInstance(
+                {true, false, {translation, {1, 1, 1}, rotation, {0, 0, 0}}});
+        }
+    }
+    callback.updateProgress("Done", 1.f);
     return modelDescriptor;
 }
 
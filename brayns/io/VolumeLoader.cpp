@@ -19,18 +19,31 @@
 
 #include "VolumeLoader.h"
 
+#include <brayns/common/loader/SpoolingLoaderStream.h>
+#include <brayns/common/utils/MappedFile.h>
 #include <brayns/common/utils/filesystem.h>
 #include <brayns/common/utils/stringUtils.h>
 #include <brayns/common/utils/utils.h>
+#include <brayns/engine/BrickedVolume.h>
 #include <brayns/engine/Model.h>
+#include <brayns/engine/PagedVolume.h>
 #include <brayns/engine/Scene.h>
 #include <brayns/engine/SharedDataVolume.h>
 
+#include <climits>
+#include <cmath>
+#include <cstring>
+
 #include <fstream>
+#include <future>
 #include <map>
 #include <sstream>
 #include <string>
 
+#if BRAYNS_USE_ZLIB
+#include <zlib.h>
+#endif
+
 namespace
 {
 using Property = brayns::Property;
@@ -44,6 +57,25 @@ const Property PROP_TYPE = {"type",
                             brayns::enumToString(brayns::DataType::UINT8),
                             brayns::enumNames<brayns::DataType>(),
                             {"Type"}};
+const Property PROP_CONVERT_TYPE = {"convertType",
+                                    std::string("none"),
+                                    {"none", "float", "uint8", "uint16",
+                                     "int16"},
+                                    {"Convert voxels to type"}};
+const Property PROP_DOWNSAMPLING = {"downsampling",
+                                    1,
+                                    1,
+                                    16,
+                                    {"Downsampling factor"}};
+const Property PROP_MEMORY_BUDGET = {
+    "memoryBudget",
+    0,
+    0,
+    std::numeric_limits<int32_t>::max(),
+    {"Memory budget in MB", "Larger volumes are paged, 0 to map them"}};
+
+// Number of output slices converted and uploaded as one brick
+const size_t SLICES_PER_BRICK = 16;
 }
 
 namespace brayns
@@ -153,6 +185,478 @@ Vector2f dataRangeFromType(DataType type)
         return {0, 1};
     }
 }
+
+size_t dataTypeSize(const DataType type)
+{
+    switch (type)
+    {
+    case DataType::UINT8:
+    case DataType::INT8:
+        return 1;
+    case DataType::UINT16:
+    case DataType::INT16:
+        return 2;
+    case DataType::UINT32:
+    case DataType::INT32:
+    case DataType::FLOAT:
+        return 4;
+    case DataType::DOUBLE:
+    default:
+        return 8;
+    }
+}
+
+bool isIntegral(const DataType type)
+{
+    return type != DataType::FLOAT && type != DataType::DOUBLE;
+}
+
+/** Sequential reader of the voxels of a volume data file. */
+class VoxelReader
+{
+public:
+    virtual ~VoxelReader() = default;
+
+    /** Read the next size bytes of voxels into data. */
+    virtual void read(uint8_t* data, size_t size) = 0;
+};
+
+class RawVoxelReader : public VoxelReader
+{
+public:
+    RawVoxelReader(const std::string& filename)
+        : _file(filename)
+    {
+    }
+
+    void read(uint8_t* data, const size_t size) final
+    {
+        if (_offset + size > _file.size())
+            throw std::runtime_error("Volume file is smaller than expected");
+        memcpy(data, _file.data() + _offset, size);
+        _offset += size;
+    }
+
+private:
+    MappedFile _file;
+    size_t _offset{0};
+};
+
+#if BRAYNS_USE_ZLIB
+/**
+ * Inflates a zlib or gzip compressed file, as written by MetaIO for
+ * CompressedData. Concatenated streams are inflated one after the other.
+ */
+class ZlibVoxelReader : public VoxelReader
+{
+public:
+    ZlibVoxelReader(const std::string& filename)
+        : _file(filename)
+    {
+        // Automatic zlib or gzip header detection
+        if (inflateInit2(&_stream, 15 + 32) != Z_OK)
+            throw std::runtime_error("Failed to initialize zlib");
+        _stream.next_in = const_cast<Bytef*>(_file.data());
+    }
+
+    ~ZlibVoxelReader() { inflateEnd(&_stream); }
+
+    void read(uint8_t* data, size_t size) final
+    {
+        _stream.next_out = data;
+        while (size > 0)
+        {
+            const auto avail = std::min<size_t>(size, UINT_MAX);
+            _stream.avail_out = avail;
+            while (_stream.avail_out > 0)
+            {
+                _fillInput();
+                if (_stream.avail_in == 0)
+                    throw std::runtime_error("Truncated compressed volume");
+
+                const auto result = inflate(&_stream, Z_NO_FLUSH);
+                if (result == Z_STREAM_END)
+                    inflateReset(&_stream);
+                else if (result != Z_OK)
+                    throw std::runtime_error("Failed to inflate volume: " +
+                                             std::string(_stream.msg
+                                                             ? _stream.msg
+                                                             : "corrupt data"));
+            }
+            size -= avail;
+        }
+    }
+
+private:
+    void _fillInput()
+    {
+        if (_stream.avail_in > 0)
+            return;
+        const size_t consumed = _stream.next_in - _file.data();
+        _stream.avail_in =
+            std::min<size_t>(_file.size() - consumed, UINT_MAX);
+    }
+
+    MappedFile _file;
+    z_stream _stream{};
+};
+
+/**
+ * Inflates a BGZF file, i.e. a series of independent gzip blocks which record
+ * their compressed and uncompressed sizes. The blocks covering each read are
+ * inflated in parallel.
+ */
+class BGZFVoxelReader : public VoxelReader
+{
+public:
+    /** @return true if the given file starts with a BGZF block header. */
+    static bool isBGZF(const MappedFile& file)
+    {
+        const auto data = file.data();
+        return file.size() >= 18 && data[0] == 0x1f && data[1] == 0x8b &&
+               (data[3] & 0x04) && data[12] == 'B' && data[13] == 'C';
+    }
+
+    BGZFVoxelReader(const std::string& filename)
+        : _file(filename)
+    {
+        // The block index is built from the headers and footers only
+        const auto data = _file.data();
+        size_t offset = 0;
+        size_t uncompressedOffset = 0;
+        while (offset + 18 <= _file.size())
+        {
+            const size_t size = (data[offset + 16] | data[offset + 17] << 8) + 1;
+            if (offset + size > _file.size())
+                throw std::runtime_error("Truncated compressed volume");
+            const auto footer = data + offset + size - 4;
+            const size_t uncompressedSize = uint32_t(footer[0]) |
+                                            uint32_t(footer[1]) << 8 |
+                                            uint32_t(footer[2]) << 16 |
+                                            uint32_t(footer[3]) << 24;
+            _blocks.push_back({offset, size, uncompressedOffset,
+                               uncompressedSize});
+            offset += size;
+            uncompressedOffset += uncompressedSize;
+        }
+    }
+
+    void read(uint8_t* data, const size_t size) final
+    {
+        const auto begin = _offset;
+        const auto end = _offset + size;
+        if (_blocks.empty() || end > _blocks.back().uncompressedOffset +
+                                         _blocks.back().uncompressedSize)
+            throw std::runtime_error("Truncated compressed volume");
+
+        auto first = std::upper_bound(_blocks.begin(), _blocks.end(), begin,
+                                      [](const size_t value, const Block& b) {
+                                          return value < b.uncompressedOffset;
+                                      }) -
+                     1;
+        auto last = std::lower_bound(_blocks.begin(), _blocks.end(), end,
+                                     [](const Block& b, const size_t value) {
+                                         return b.uncompressedOffset < value;
+                                     });
+        const auto nbBlocks = std::distance(first, last);
+
+        bool failed = false;
+#pragma omp parallel
+        {
+            uint8_ts buffer;
+#pragma omp for
+            for (ptrdiff_t i = 0; i < nbBlocks; ++i)
+            {
+                const auto& block = *(first + i);
+                if (block.uncompressedSize == 0)
+                    continue;
+                buffer.resize(block.uncompressedSize);
+                if (!_inflate(block, buffer.data()))
+                {
+#pragma omp atomic write
+                    failed = true;
+                    continue;
+                }
+
+                const auto from = std::max(begin, block.uncompressedOffset);
+                const auto to = std::min(end, block.uncompressedOffset +
+                                                  block.uncompressedSize);
+                memcpy(data + from - begin,
+                       buffer.data() + from - block.uncompressedOffset,
+                       to - from);
+            }
+        }
+        if (failed)
+            throw std::runtime_error("Failed to inflate volume");
+        _offset = end;
+    }
+
+private:
+    struct Block
+    {
+        size_t offset;
+        size_t size;
+        size_t uncompressedOffset;
+        size_t uncompressedSize;
+    };
+
+    bool _inflate(const Block& block, uint8_t* data) const
+    {
+        z_stream stream{};
+        if (inflateInit2(&stream, 15 + 16) != Z_OK)
+            return false;
+        stream.next_in = const_cast<Bytef*>(_file.data() + block.offset);
+        stream.avail_in = block.size;
+        stream.next_out = data;
+        stream.avail_out = block.uncompressedSize;
+        const auto result = inflate(&stream, Z_FINISH);
+        inflateEnd(&stream);
+        return result == Z_STREAM_END;
+    }
+
+    MappedFile _file;
+    std::vector<Block> _blocks;
+    size_t _offset{0};
+};
+#endif
+
+std::unique_ptr<VoxelReader> createVoxelReader(const std::string& filename,
+                                               const bool compressed)
+{
+    if (!compressed)
+        return std::make_unique<RawVoxelReader>(filename);
+#if BRAYNS_USE_ZLIB
+    if (BGZFVoxelReader::isBGZF(MappedFile(filename)))
+        return std::make_unique<BGZFVoxelReader>(filename);
+    return std::make_unique<ZlibVoxelReader>(filename);
+#else
+    throw std::runtime_error("Compressed volumes require zlib support");
+#endif
+}
+
+/** Converts a row of voxels of type T to doubles. */
+template <typename T>
+void rowToDouble(const uint8_t* voxels, const size_t count, double* values)
+{
+    const auto typed = reinterpret_cast<const T*>(voxels);
+    for (size_t i = 0; i < count; ++i)
+        values[i] = typed[i];
+}
+
+/** Converts a row of doubles to voxels of type T, clamped to its range. */
+template <typename T>
+void rowFromDouble(const double* values, const size_t count, uint8_t* voxels)
+{
+    const double lowest = std::numeric_limits<T>::lowest();
+    const double highest = std::numeric_limits<T>::max();
+    auto typed = reinterpret_cast<T*>(voxels);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto value = std::min(highest, std::max(lowest, values[i]));
+        typed[i] = std::is_integral<T>::value ? T(std::round(value)) : T(value);
+    }
+}
+
+using RowToDouble = void (*)(const uint8_t*, size_t, double*);
+using RowFromDouble = void (*)(const double*, size_t, uint8_t*);
+
+RowToDouble rowToDouble(const DataType type)
+{
+    switch (type)
+    {
+    case DataType::FLOAT:
+        return rowToDouble<float>;
+    case DataType::DOUBLE:
+        return rowToDouble<double>;
+    case DataType::UINT8:
+        return rowToDouble<uint8_t>;
+    case DataType::UINT16:
+        return rowToDouble<uint16_t>;
+    case DataType::UINT32:
+        return rowToDouble<uint32_t>;
+    case DataType::INT8:
+        return rowToDouble<int8_t>;
+    case DataType::INT16:
+        return rowToDouble<int16_t>;
+    case DataType::INT32:
+    default:
+        return rowToDouble<int32_t>;
+    }
+}
+
+RowFromDouble rowFromDouble(const DataType type)
+{
+    switch (type)
+    {
+    case DataType::FLOAT:
+        return rowFromDouble<float>;
+    case DataType::DOUBLE:
+        return rowFromDouble<double>;
+    case DataType::UINT8:
+        return rowFromDouble<uint8_t>;
+    case DataType::UINT16:
+        return rowFromDouble<uint16_t>;
+    case DataType::UINT32:
+        return rowFromDouble<uint32_t>;
+    case DataType::INT8:
+        return rowFromDouble<int8_t>;
+    case DataType::INT16:
+        return rowFromDouble<int16_t>;
+    case DataType::INT32:
+    default:
+        return rowFromDouble<int32_t>;
+    }
+}
+
+Vector2d typeLimits(const DataType type)
+{
+    switch (type)
+    {
+    case DataType::UINT8:
+        return {0, std::numeric_limits<uint8_t>::max()};
+    case DataType::UINT16:
+        return {0, std::numeric_limits<uint16_t>::max()};
+    case DataType::UINT32:
+        return {0, std::numeric_limits<uint32_t>::max()};
+    case DataType::INT8:
+        return {std::numeric_limits<int8_t>::min(),
+                std::numeric_limits<int8_t>::max()};
+    case DataType::INT16:
+        return {std::numeric_limits<int16_t>::min(),
+                std::numeric_limits<int16_t>::max()};
+    case DataType::INT32:
+        return {std::numeric_limits<int32_t>::min(),
+                std::numeric_limits<int32_t>::max()};
+    case DataType::FLOAT:
+    case DataType::DOUBLE:
+    default:
+        return {0, 1};
+    }
+}
+
+/**
+ * Reads the voxels of a volume data file slab by slab, converts them to the
+ * given type, averages blocks of downsampling^3 voxels and adds each slab as
+ * a brick to the volume. The next slab is read, and inflated if compressed,
+ * while the current one is converted.
+ *
+ * Integer voxels converted to another integer type are rescaled from the range
+ * of the source type to the one of the target type, all other conversions only
+ * clamp to the range of the target type.
+ *
+ * @return the minimum and maximum of the converted voxels
+ */
+Vector2d loadBricks(VoxelReader& reader, BrickedVolume& volume,
+                    const Vector3ui& dimensions, const DataType sourceType,
+                    const DataType targetType, const size_t downsampling,
+                    const LoaderProgress& callback)
+{
+    const Vector3ui outDimensions =
+        (dimensions + Vector3ui(downsampling - 1)) / Vector3ui(downsampling);
+    const size_t sourceSize = dataTypeSize(sourceType);
+    const size_t targetSize = dataTypeSize(targetType);
+    const size_t sourceSlice = size_t(dimensions.x) * dimensions.y * sourceSize;
+    const size_t targetRow = size_t(outDimensions.x) * targetSize;
+    const size_t slabSlices = SLICES_PER_BRICK * downsampling;
+
+    const auto toDouble = rowToDouble(sourceType);
+    const auto fromDouble = rowFromDouble(targetType);
+    double scale = 1.0;
+    double offset = 0.0;
+    if (sourceType != targetType && isIntegral(sourceType) &&
+        isIntegral(targetType))
+    {
+        const auto from = typeLimits(sourceType);
+        const auto to = typeLimits(targetType);
+        scale = (to.y - to.x) / (from.y - from.x);
+        offset = to.x - from.x * scale;
+    }
+
+    const auto readSlab = [&](uint8_ts& slab, const size_t z) {
+        const size_t slices = std::min<size_t>(slabSlices, dimensions.z - z);
+        slab.resize(slices * sourceSlice);
+        reader.read(slab.data(), slab.size());
+    };
+
+    const Vector2d emptyRange(std::numeric_limits<double>::max(),
+                              std::numeric_limits<double>::lowest());
+    Vector2d range = emptyRange;
+    uint8_ts slab, nextSlab, brick;
+    readSlab(slab, 0);
+    for (size_t z = 0; z < dimensions.z; z += slabSlices)
+    {
+        std::future<void> next;
+        if (z + slabSlices < dimensions.z)
+            next = std::async(std::launch::async, readSlab, std::ref(nextSlab),
+                              z + slabSlices);
+
+        const size_t slices = slab.size() / sourceSlice;
+        const size_t outSlices = (slices + downsampling - 1) / downsampling;
+        brick.resize(outSlices * outDimensions.y * targetRow);
+
+        const int64_t nbRows = outSlices * outDimensions.y;
+#pragma omp parallel
+        {
+            std::vector<double> values(dimensions.x);
+            std::vector<double> sums(outDimensions.x);
+            std::vector<size_t> counts(outDimensions.x);
+            Vector2d threadRange = emptyRange;
+#pragma omp for
+            for (int64_t row = 0; row < nbRows; ++row)
+            {
+                const size_t outZ = row / outDimensions.y;
+                const size_t outY = row % outDimensions.y;
+                std::fill(sums.begin(), sums.end(), 0.0);
+                std::fill(counts.begin(), counts.end(), 0);
+
+                const size_t endZ =
+                    std::min(slices, (outZ + 1) * downsampling);
+                const size_t endY = std::min<size_t>(dimensions.y,
+                                                     (outY + 1) * downsampling);
+                for (size_t sz = outZ * downsampling; sz < endZ; ++sz)
+                    for (size_t sy = outY * downsampling; sy < endY; ++sy)
+                    {
+                        toDouble(slab.data() + sz * sourceSlice +
+                                     sy * dimensions.x * sourceSize,
+                                 dimensions.x, values.data());
+                        for (size_t x = 0; x < dimensions.x; ++x)
+                        {
+                            sums[x / downsampling] += values[x];
+                            ++counts[x / downsampling];
+                        }
+                    }
+
+                for (size_t x = 0; x < outDimensions.x; ++x)
+                {
+                    sums[x] = sums[x] / counts[x] * scale + offset;
+                    threadRange.x = std::min(threadRange.x, sums[x]);
+                    threadRange.y = std::max(threadRange.y, sums[x]);
+                }
+                fromDouble(sums.data(), outDimensions.x,
+                           brick.data() + row * targetRow);
+            }
+#pragma omp critical
+            {
+                range.x = std::min(range.x, threadRange.x);
+                range.y = std::max(range.y, threadRange.y);
+            }
+        }
+
+        volume.setBrick(brick.data(),
+                        Vector3ui(0, 0, z / downsampling),
+                        Vector3ui(outDimensions.x, outDimensions.y,
+                                  outSlices));
+        callback.updateProgress("Loading voxels ...",
+                                float(z + slices) / dimensions.z);
+
+        if (next.valid())
+        {
+            next.get();
+            std::swap(slab, nextSlab);
+        }
+    }
+    return range;
+}
 }
 
 RawVolumeLoader::RawVolumeLoader(Scene& scene)
@@ -170,9 +674,22 @@ ModelDescriptorPtr RawVolumeLoader::importFromBlob(
     Blob&& blob, const LoaderProgress& callback,
     const PropertyMap& properties) const
 {
-    return _loadVolume(blob.name, callback, properties, [&blob](auto volume) {
-        volume->mapData(std::move(blob.data));
-    });
+    return _loadVolume(blob.name, callback, properties,
+                       [&blob](auto volume) {
+                           volume->mapData(std::move(blob.data));
+                       },
+                       false);
+}
+
+LoaderStreamPtr RawVolumeLoader::createStream(
+    const std::string& type, const std::string& name BRAYNS_UNUSED,
+    const size_t size BRAYNS_UNUSED, const LoaderProgress& callback,
+    const PropertyMap& properties) const
+{
+    // Spool the voxels to a temporary file which is then memory mapped by the
+    // volume, so the upload is never held in memory.
+    return std::make_shared<SpoolingLoaderStream>(*this, type, callback,
+                                                  properties);
 }
 
 ModelDescriptorPtr RawVolumeLoader::importFromFile(
@@ -180,13 +697,15 @@ ModelDescriptorPtr RawVolumeLoader::importFromFile(
     const PropertyMap& properties) const
 {
     return _loadVolume(filename, callback, properties,
-                       [filename](auto volume) { volume->mapData(filename); });
+                       [filename](auto volume) { volume->mapData(filename); },
+                       true);
 }
 
 ModelDescriptorPtr RawVolumeLoader::_loadVolume(
     const std::string& filename, const LoaderProgress& callback,
     const PropertyMap& propertiesTmp,
-    const std::function<void(SharedDataVolumePtr)>& mapData) const
+    const std::function<void(SharedDataVolumePtr)>& mapData,
+    const bool pageable) const
 {
     // Fill property map since the actual property types are known now.
     PropertyMap properties = getProperties();
@@ -205,12 +724,32 @@ ModelDescriptorPtr RawVolumeLoader::_loadVolume(
         throw std::runtime_error("Volume dimensions are empty");
 
     const auto dataRange = dataRangeFromType(type);
+    const size_t memoryBudget =
+        size_t(properties.getProperty<int32_t>(PROP_MEMORY_BUDGET.name)) *
+        1024 * 1024;
+    const size_t size = size_t(dimensions.x) * dimensions.y * dimensions.z *
+                        dataTypeSize(type);
     auto model = _scene.createModel();
-    auto volume = model->createSharedDataVolume(dimensions, spacing, type);
-    volume->setDataRange(dataRange);
 
     callback.updateProgress("Loading voxels ...", 0.5f);
-    mapData(volume);
+    VolumePtr volume;
+    if (pageable && memoryBudget > 0 && size > memoryBudget)
+    {
+        // Only the coarse level is read now, the bricks follow the camera
+        auto pagedVolume =
+            model->createPagedVolume(dimensions, spacing, type);
+        pagedVolume->setDataRange(dataRange);
+        pagedVolume->mapData(filename, memoryBudget);
+        volume = pagedVolume;
+    }
+    else
+    {
+        auto sharedVolume =
+            model->createSharedDataVolume(dimensions, spacing, type);
+        sharedVolume->setDataRange(dataRange);
+        mapData(sharedVolume);
+        volume = sharedVolume;
+    }
 
     callback.updateProgress("Adding model ...", 1.f);
     model->addVolume(volume);
@@ -241,6 +780,7 @@ PropertyMap RawVolumeLoader::getProperties() const
     pm.setProperty(PROP_DIMENSIONS);
     pm.setProperty(PROP_SPACING);
     pm.setProperty(PROP_TYPE);
+    pm.setProperty(PROP_MEMORY_BUDGET);
     return pm;
 }
 ////////////////////////////////////////////////////////////////////////////
@@ -265,8 +805,12 @@ ModelDescriptorPtr MHDVolumeLoader::importFromBlob(
 
 ModelDescriptorPtr MHDVolumeLoader::importFromFile(
     const std::string& filename, const LoaderProgress& callback,
-    const PropertyMap&) const
+    const PropertyMap& propertiesTmp) const
 {
+    // Fill property map since the actual property types are known now.
+    PropertyMap loaderProperties = getProperties();
+    loaderProperties.merge(propertiesTmp);
+
     std::string volumeFile = filename;
     const auto mhd = parseMHD(filename);
 
@@ -295,17 +839,83 @@ ModelDescriptorPtr MHDVolumeLoader::importFromFile(
     }
     volumeFile = path.string();
 
+    const auto compressed = mhd.count("CompressedData") &&
+                            string_utils::toLowercase(
+                                mhd.at("CompressedData")) == "true";
+    const auto convertType =
+        loaderProperties.getProperty<std::string>(PROP_CONVERT_TYPE.name);
+    const auto downsampling =
+        loaderProperties.getProperty<int32_t>(PROP_DOWNSAMPLING.name);
+    if (downsampling < 1)
+        throw std::runtime_error("Invalid downsampling factor");
+
+    if (compressed || convertType != "none" || downsampling > 1)
+    {
+        const auto targetType = convertType == "none"
+                                    ? type
+                                    : stringToEnum<DataType>(convertType);
+        return _loadBricks(volumeFile, compressed, toGlmVec(dimensions),
+                           toGlmVec(spacing), type, targetType, downsampling,
+                           callback);
+    }
+
     PropertyMap properties;
     properties.setProperty(
         {PROP_DIMENSIONS.name, dimensions, PROP_DIMENSIONS.metaData});
     properties.setProperty({PROP_SPACING.name, spacing, PROP_SPACING.metaData});
     properties.setProperty({PROP_TYPE.name, brayns::enumToString(type),
                             PROP_TYPE.enums, PROP_TYPE.metaData});
+    properties.setProperty(
+        {PROP_MEMORY_BUDGET.name,
+         loaderProperties.getProperty<int32_t>(PROP_MEMORY_BUDGET.name),
+         PROP_MEMORY_BUDGET.metaData});
 
     return RawVolumeLoader(_scene).importFromFile(volumeFile, callback,
                                                   properties);
 }
 
+ModelDescriptorPtr MHDVolumeLoader::_loadBricks(
+    const std::string& filename, const bool compressed,
+    const Vector3ui& dimensions, const Vector3d& spacing,
+    const DataType sourceType, const DataType targetType,
+    const size_t downsampling, const LoaderProgress& callback) const
+{
+    if (glm::compMul(dimensions) == 0)
+        throw std::runtime_error("Volume dimensions are empty");
+
+    callback.updateProgress("Parsing volume file ...", 0.f);
+    auto reader = createVoxelReader(filename, compressed);
+
+    const Vector3ui outDimensions =
+        (dimensions + Vector3ui(downsampling - 1)) / Vector3ui(downsampling);
+    const Vector3d outSpacing = spacing * double(downsampling);
+
+    auto model = _scene.createModel();
+    auto volume =
+        model->createBrickedVolume(outDimensions, outSpacing, targetType);
+    const auto range = loadBricks(*reader, *volume, dimensions, sourceType,
+                                  targetType, downsampling, callback);
+
+    // Floating point voxels keep the values of the source, whose range is
+    // unrelated to the one of their type
+    if (isIntegral(targetType))
+        volume->setDataRange(dataRangeFromType(targetType));
+    else
+        volume->setDataRange(Vector2f(range));
+
+    callback.updateProgress("Adding model ...", 1.f);
+    model->addVolume(volume);
+
+    Transformation transformation;
+    transformation.setRotationCenter(model->getBounds().getCenter());
+    auto modelDescriptor = std::make_shared<ModelDescriptor>(
+        std::move(model), filename,
+        ModelMetadata{{"dimensions", to_string(outDimensions)},
+                      {"element-spacing", to_string(outSpacing)}});
+    modelDescriptor->setTransformation(transformation);
+    return modelDescriptor;
+}
+
 std::string MHDVolumeLoader::getName() const
 {
     return "mhd-volume";
@@ -315,4 +925,13 @@ std::vector<std::string> MHDVolumeLoader::getSupportedExtensions() const
 {
     return {"mhd"};
 }
+
+PropertyMap MHDVolumeLoader::getProperties() const
+{
+    PropertyMap pm;
+    pm.setProperty(PROP_CONVERT_TYPE);
+    pm.setProperty(PROP_DOWNSAMPLING);
+    pm.setProperty(PROP_MEMORY_BUDGET);
+    return pm;
+}
 }
@@ -24,6 +24,10 @@
 namespace brayns
 {
 /** A volume loader for mhd volumes.
+ *
+ * Compressed data (CompressedData = True), voxel type conversion and
+ * downsampling are loaded slab by slab into a bricked volume; plain data is
+ * memory mapped or paged through the raw volume loader.
  */
 class MHDVolumeLoader : public Loader
 {
@@ -32,6 +36,7 @@ public:
 
     std::vector<std::string> getSupportedExtensions() const final;
     std::string getName() const final;
+    PropertyMap getProperties() const final;
 
     bool isSupported(const std::string& filename,
                      const std::string& extension) const final;
@@ -42,9 +47,19 @@ public:
     ModelDescriptorPtr importFromFile(
         const std::string& filename, const LoaderProgress& callback,
         const PropertyMap& properties) const final;
+
+private:
+    ModelDescriptorPtr _loadBricks(const std::string& filename,
+                                   bool compressed, const Vector3ui& dimensions,
+                                   const Vector3d& spacing, DataType sourceType,
+                                   DataType targetType, size_t downsampling,
+                                   const LoaderProgress& callback) const;
 };
 
 /** A volume loader for raw volumes with params for dimensions.
+ *
+ * Files larger than the memory budget are paged in bricks on demand, other
+ * files and blobs are memory mapped.
  */
 class RawVolumeLoader : public Loader
 {
@@ -65,10 +80,16 @@ public:
         const std::string& filename, const LoaderProgress& callback,
         const PropertyMap& properties) const final;
 
+    LoaderStreamPtr createStream(const std::string& type,
+                                 const std::string& name, const size_t size,
+                                 const LoaderProgress& callback,
+                                 const PropertyMap& properties) const final;
+
 private:
     ModelDescriptorPtr _loadVolume(
         const std::string& filename, const LoaderProgress& callback,
         const PropertyMap& properties,
-        const std::function<void(SharedDataVolumePtr)>& mapData) const;
+        const std::function<void(SharedDataVolumePtr)>& mapData,
+        bool pageable) const;
 };
 }
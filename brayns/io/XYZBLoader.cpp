@@ -26,6 +26,7 @@
 #include <brayns/engine/Model.h>
 #include <brayns/engine/Scene.h>
 
+#include <cstdlib>
 #include <fstream>
 #include <sstream>
 
@@ -35,133 +36,197 @@ namespace
 {
 constexpr auto ALMOST_ZERO = 1e-7f;
 constexpr auto LOADER_NAME = "xyzb";
+constexpr size_t MATERIAL_ID = 0;
+constexpr size_t FILE_CHUNK_SIZE = 1 << 20;
 
 float _computeHalfArea(const Boxf& bbox)
 {
     const auto size = bbox.getSize();
     return size[0] * size[1] + size[0] * size[2] + size[1] * size[2];
 }
-}
 
-XYZBLoader::XYZBLoader(Scene& scene)
-    : Loader(scene)
-{
-}
-
-bool XYZBLoader::isSupported(const std::string& filename BRAYNS_UNUSED,
-                             const std::string& extension) const
+/**
+ * Parses the points line by line as the chunks arrive; a line may be split
+ * across two chunks.
+ */
+class XYZBStream : public LoaderStream
 {
-    const std::set<std::string> types = {"xyz"};
-    return types.find(extension) != types.end();
-}
+public:
+    XYZBStream(Scene& scene, const std::string& name, const size_t size,
+               const LoaderProgress& callback)
+        : _model(scene.createModel())
+        , _name(name)
+        , _size(size)
+        , _callback(callback)
+    {
+        BRAYNS_INFO << "Loading xyz " << name << std::endl;
 
-ModelDescriptorPtr XYZBLoader::importFromBlob(
-    Blob&& blob, const LoaderProgress& callback,
-    const PropertyMap& properties BRAYNS_UNUSED) const
-{
-    BRAYNS_INFO << "Loading xyz " << blob.name << std::endl;
+        _model->createMaterial(MATERIAL_ID, fs::path({name}).stem());
 
-    std::stringstream stream(std::string(blob.data.begin(), blob.data.end()));
-    size_t numlines = 0;
-    {
-        numlines = std::count(std::istreambuf_iterator<char>(stream),
-                              std::istreambuf_iterator<char>(), '\n');
+        std::stringstream msg;
+        msg << "Loading " << string_utils::shortenString(name) << " ...";
+        _message = msg.str();
     }
-    stream.seekg(0);
 
-    auto model = _scene.createModel();
+    void append(const uint8_t* data, const size_t size) final
+    {
+        const auto begin = reinterpret_cast<const char*>(data);
+        const auto end = begin + size;
 
-    const auto name = fs::path({blob.name}).stem();
-    const auto materialId = 0;
-    model->createMaterial(materialId, name);
-    auto& spheres = model->getSpheres()[materialId];
+        auto lineBegin = begin;
+        for (auto lineEnd = std::find(lineBegin, end, '\n'); lineEnd != end;
+             lineEnd = std::find(lineBegin, end, '\n'))
+        {
+            _line.append(lineBegin, lineEnd);
+            _parseLine();
+            lineBegin = lineEnd + 1;
+        }
+        _line.append(lineBegin, end);
 
-    const size_t startOffset = spheres.size();
-    spheres.reserve(spheres.size() + numlines);
+        _receivedBytes += size;
+        if (_size > 0)
+            _callback.updateProgress(_message, _receivedBytes /
+                                                   static_cast<float>(_size));
+    }
 
-    Boxf bbox;
-    size_t i = 0;
-    std::string line;
-    std::stringstream msg;
-    msg << "Loading " << string_utils::shortenString(blob.name) << " ...";
-    while (std::getline(stream, line))
+    ModelDescriptorPtr finish() final
     {
-        std::vector<float> lineData;
-        std::stringstream lineStream(line);
+        if (!_line.empty())
+            _parseLine();
+
+        // Find an appropriate mean radius to avoid overlaps of the spheres, see
+        // https://en.wikipedia.org/wiki/Wigner%E2%80%93Seitz_radius
+
+        const auto numPoints = _numLines;
+        const auto volume = glm::compMul(_bbox.getSize());
+        const auto density4PI =
+            4 * M_PI * numPoints /
+            (volume > ALMOST_ZERO ? volume : _computeHalfArea(_bbox));
+
+        const double meanRadius = volume > ALMOST_ZERO
+                                      ? std::pow((3. / density4PI), 1. / 3.)
+                                      : std::sqrt(1 / density4PI);
+
+        // resize the spheres to the new mean radius
+        for (auto& sphere : _model->getSpheres(MATERIAL_ID))
+            sphere.radius = meanRadius;
+
+        Transformation transformation;
+        transformation.setRotationCenter(_model->getBounds().getCenter());
+        auto modelDescriptor =
+            std::make_shared<ModelDescriptor>(std::move(_model), _name);
+        modelDescriptor->setTransformation(transformation);
+
+        Property radiusProperty("radius", meanRadius, 0., meanRadius * 2.,
+                                {"Point size"});
+        radiusProperty.onModified([modelDesc = std::weak_ptr<ModelDescriptor>(
+                                       modelDescriptor)](const auto& property) {
+            if (auto modelDesc_ = modelDesc.lock())
+            {
+                const auto newRadius = property.template get<double>();
+                for (auto& sphere :
+                     modelDesc_->getModel().getSpheres(MATERIAL_ID))
+                    sphere.radius = newRadius;
+            }
+        });
+        PropertyMap modelProperties;
+        modelProperties.setProperty(radiusProperty);
+        modelDescriptor->setProperties(modelProperties);
+        return modelDescriptor;
+    }
 
-        float value;
-        while (lineStream >> value)
-            lineData.push_back(value);
+private:
+    void _parseLine()
+    {
+        float values[3];
+        size_t numValues = 0;
 
-        switch (lineData.size())
-        {
-        case 3:
+        const char* current = _line.c_str();
+        char* next = nullptr;
+        for (float value = std::strtof(current, &next); next != current;
+             value = std::strtof(current, &next))
         {
-            const Vector3f position(lineData[0], lineData[1], lineData[2]);
-            bbox.merge(position);
-            // The point radius used here is irrelevant as it's going to be
-            // changed later.
-            model->addSphere(materialId, {position, 1});
-            break;
+            if (numValues < 3)
+                values[numValues] = value;
+            ++numValues;
+            current = next;
         }
-        default:
+
+        if (numValues != 3)
             throw std::runtime_error("Invalid content in line " +
-                                     std::to_string(i + 1) + ": " + line);
-        }
-        callback.updateProgress(msg.str(), i++ / static_cast<float>(numlines));
+                                     std::to_string(_numLines + 1) + ": " +
+                                     _line);
+
+        const Vector3f position(values[0], values[1], values[2]);
+        _bbox.merge(position);
+        // The point radius used here is irrelevant as it's going to be
+        // changed later.
+        _model->addSphere(MATERIAL_ID, {position, 1});
+
+        ++_numLines;
+        _line.clear();
     }
 
-    // Find an appropriate mean radius to avoid overlaps of the spheres, see
-    // https://en.wikipedia.org/wiki/Wigner%E2%80%93Seitz_radius
-
-    const auto volume = glm::compMul(bbox.getSize());
-    const auto density4PI =
-        4 * M_PI * numlines /
-        (volume > ALMOST_ZERO ? volume : _computeHalfArea(bbox));
-
-    const double meanRadius = volume > ALMOST_ZERO
-                                  ? std::pow((3. / density4PI), 1. / 3.)
-                                  : std::sqrt(1 / density4PI);
-
-    // resize the spheres to the new mean radius
-    for (i = 0; i < numlines; ++i)
-        spheres[i + startOffset].radius = meanRadius;
-
-    Transformation transformation;
-    transformation.setRotationCenter(model->getBounds().getCenter());
-    auto modelDescriptor =
-        std::make_shared<ModelDescriptor>(std::move(model), blob.name);
-    modelDescriptor->setTransformation(transformation);
-
-    Property radiusProperty("radius", meanRadius, 0., meanRadius * 2.,
-                            {"Point size"});
-    radiusProperty.onModified([modelDesc = std::weak_ptr<ModelDescriptor>(
-                                   modelDescriptor)](const auto& property) {
-        if (auto modelDesc_ = modelDesc.lock())
-        {
-            const auto newRadius = property.template get<double>();
-            for (auto& sphere : modelDesc_->getModel().getSpheres()[materialId])
-                sphere.radius = newRadius;
-        }
-    });
-    PropertyMap modelProperties;
-    modelProperties.setProperty(radiusProperty);
-    modelDescriptor->setProperties(modelProperties);
-    return modelDescriptor;
+    ModelPtr _model;
+    const std::string _name;
+    const size_t _size;
+    const LoaderProgress _callback;
+    std::string _message;
+
+    std::string _line;
+    size_t _numLines{0};
+    size_t _receivedBytes{0};
+    Boxf _bbox;
+};
+}
+
+XYZBLoader::XYZBLoader(Scene& scene)
+    : Loader(scene)
+{
+}
+
+bool XYZBLoader::isSupported(const std::string& filename BRAYNS_UNUSED,
+                             const std::string& extension) const
+{
+    const std::set<std::string> types = {"xyz"};
+    return types.find(extension) != types.end();
+}
+
+LoaderStreamPtr XYZBLoader::createStream(
+    const std::string& type BRAYNS_UNUSED, const std::string& name,
+    const size_t size, const LoaderProgress& callback,
+    const PropertyMap& properties BRAYNS_UNUSED) const
+{
+    return std::make_shared<XYZBStream>(_scene, name, size, callback);
+}
+
+ModelDescriptorPtr XYZBLoader::importFromBlob(
+    Blob&& blob, const LoaderProgress& callback,
+    const PropertyMap& properties) const
+{
+    auto stream = createStream(blob.type, blob.name, blob.data.size(),
+                               callback, properties);
+    stream->append(blob.data.data(), blob.data.size());
+    return stream->finish();
 }
 
 ModelDescriptorPtr XYZBLoader::importFromFile(
     const std::string& filename, const LoaderProgress& callback,
     const PropertyMap& properties) const
 {
-    std::ifstream file(filename);
+    std::ifstream file(filename, std::ios::binary);
     if (!file.good())
         throw std::runtime_error("Could not open file " + filename);
-    return importFromBlob({"xyz",
-                           filename,
-                           {std::istreambuf_iterator<char>(file),
-                            std::istreambuf_iterator<char>()}},
-                          callback, properties);
+
+    auto stream = createStream("xyz", filename, fs::file_size(filename),
+                               callback, properties);
+    std::vector<uint8_t> chunk(FILE_CHUNK_SIZE);
+    while (file)
+    {
+        file.read(reinterpret_cast<char*>(chunk.data()), chunk.size());
+        stream->append(chunk.data(), file.gcount());
+    }
+    return stream->finish();
 }
 
 std::string XYZBLoader::getName() const
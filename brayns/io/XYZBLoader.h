@@ -42,6 +42,11 @@ public:
     ModelDescriptorPtr importFromFile(
         const std::string& filename, const LoaderProgress& callback,
         const PropertyMap& properties) const final;
+
+    LoaderStreamPtr createStream(const std::string& type,
+                                 const std::string& name, const size_t size,
+                                 const LoaderProgress& callback,
+                                 const PropertyMap& properties) const final;
 };
 }
 
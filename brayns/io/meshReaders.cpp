@@ -0,0 +1,1035 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "meshReaders.h"
+
+#include "assimpImporters/fast_atof.h"
+
+#include <brayns/common/utils/MappedFile.h>
+#include <brayns/common/utils/filesystem.h>
+#include <brayns/common/utils/stringUtils.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <sstream>
+
+namespace brayns
+{
+namespace
+{
+/** Number of bytes of OBJ text scanned by one task */
+const size_t CHUNK_SIZE = 1 << 22;
+
+const uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+bool isLittleEndian()
+{
+    const uint16_t one = 1;
+    return *reinterpret_cast<const uint8_t*>(&one) == 1;
+}
+
+/** Average of the unit normals of the triangles around each vertex */
+Vector3fs computeNormals(const Vector3fs& vertices,
+                         const std::vector<Vector3ui>& triangles)
+{
+    Vector3fs faceNormals(triangles.size());
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(triangles.size()); ++i)
+    {
+        const auto& triangle = triangles[i];
+        const auto& p0 = vertices[triangle[0]];
+        const auto normal =
+            glm::cross(vertices[triangle[1]] - p0, vertices[triangle[2]] - p0);
+        const auto length = glm::length(normal);
+        faceNormals[i] = length > 0.f ? normal / length : Vector3f(0.f);
+    }
+
+    Vector3fs normals(vertices.size(), Vector3f(0.f));
+    for (size_t i = 0; i < triangles.size(); ++i)
+        for (size_t j = 0; j < 3; ++j)
+            normals[triangles[i][j]] += faceNormals[i];
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(normals.size()); ++i)
+    {
+        const auto length = glm::length(normals[i]);
+        if (length > 0.f)
+            normals[i] /= length;
+    }
+    return normals;
+}
+
+// Binary PLY
+
+enum class PlyType
+{
+    int8,
+    uint8,
+    int16,
+    uint16,
+    int32,
+    uint32,
+    float32,
+    float64
+};
+
+bool toPlyType(const std::string& name, PlyType& type)
+{
+    static const std::map<std::string, PlyType> types = {
+        {"char", PlyType::int8},      {"int8", PlyType::int8},
+        {"uchar", PlyType::uint8},    {"uint8", PlyType::uint8},
+        {"short", PlyType::int16},    {"int16", PlyType::int16},
+        {"ushort", PlyType::uint16},  {"uint16", PlyType::uint16},
+        {"int", PlyType::int32},      {"int32", PlyType::int32},
+        {"uint", PlyType::uint32},    {"uint32", PlyType::uint32},
+        {"float", PlyType::float32},  {"float32", PlyType::float32},
+        {"double", PlyType::float64}, {"float64", PlyType::float64}};
+    const auto i = types.find(name);
+    if (i == types.end())
+        return false;
+    type = i->second;
+    return true;
+}
+
+size_t sizeOf(const PlyType type)
+{
+    switch (type)
+    {
+    case PlyType::int8:
+    case PlyType::uint8:
+        return 1;
+    case PlyType::int16:
+    case PlyType::uint16:
+        return 2;
+    case PlyType::int32:
+    case PlyType::uint32:
+    case PlyType::float32:
+        return 4;
+    case PlyType::float64:
+    default:
+        return 8;
+    }
+}
+
+/** Scale bringing color components of the given type to [0, 1] */
+float colorScale(const PlyType type)
+{
+    switch (type)
+    {
+    case PlyType::int8:
+        return 1.f / std::numeric_limits<int8_t>::max();
+    case PlyType::uint8:
+        return 1.f / std::numeric_limits<uint8_t>::max();
+    case PlyType::int16:
+        return 1.f / std::numeric_limits<int16_t>::max();
+    case PlyType::uint16:
+        return 1.f / std::numeric_limits<uint16_t>::max();
+    case PlyType::int32:
+        return 1.f / std::numeric_limits<int32_t>::max();
+    case PlyType::uint32:
+        return 1.f / std::numeric_limits<uint32_t>::max();
+    default:
+        return 1.f;
+    }
+}
+
+struct PlyProperty
+{
+    std::string name;
+    PlyType type;
+    bool isList{false};
+    PlyType countType{PlyType::uint8};
+};
+
+struct PlyElement
+{
+    std::string name;
+    size_t count{0};
+    std::vector<PlyProperty> properties;
+
+    bool hasLists() const
+    {
+        return std::any_of(properties.begin(), properties.end(),
+                           [](const PlyProperty& p) { return p.isList; });
+    }
+
+    /** Size of one record, only meaningful without lists */
+    size_t stride() const
+    {
+        size_t size = 0;
+        for (const auto& property : properties)
+            size += sizeOf(property.type);
+        return size;
+    }
+};
+
+/** Location of a scalar property in the records of an element */
+struct PlyField
+{
+    size_t offset;
+    PlyType type;
+};
+
+/**
+ * Reads the values of a binary PLY file, swapping the bytes when the file
+ * and the host endianness differ. All reads are bounds checked by the caller
+ * with check().
+ */
+class PlyReader
+{
+public:
+    PlyReader(const char* end, const bool swap)
+        : _end(end)
+        , _swap(swap)
+    {
+    }
+
+    void check(const char* data, const size_t size) const
+    {
+        if (size_t(_end - data) < size)
+            throw std::runtime_error("Unexpected end of PLY file");
+    }
+
+    void check(const char* data, const size_t count, const size_t size) const
+    {
+        if (size != 0 && count > size_t(_end - data) / size)
+            throw std::runtime_error("Unexpected end of PLY file");
+    }
+
+    double read(const char* data, const PlyType type) const
+    {
+        switch (type)
+        {
+        case PlyType::int8:
+            return _load<int8_t>(data);
+        case PlyType::uint8:
+            return _load<uint8_t>(data);
+        case PlyType::int16:
+            return _load<int16_t>(data);
+        case PlyType::uint16:
+            return _load<uint16_t>(data);
+        case PlyType::int32:
+            return _load<int32_t>(data);
+        case PlyType::uint32:
+            return _load<uint32_t>(data);
+        case PlyType::float32:
+            return _load<float>(data);
+        case PlyType::float64:
+        default:
+            return _load<double>(data);
+        }
+    }
+
+    /** Number of items of the list starting at data */
+    size_t readCount(const char* data, const PlyType type) const
+    {
+        check(data, sizeOf(type));
+        const auto count = read(data, type);
+        if (count < 0)
+            throw std::runtime_error("Invalid list size in PLY file");
+        return size_t(count);
+    }
+
+    /** Size of the record of the element starting at data */
+    size_t recordSize(const PlyElement& element, const char* data) const
+    {
+        size_t size = 0;
+        for (const auto& property : element.properties)
+        {
+            if (property.isList)
+            {
+                const auto count = readCount(data + size, property.countType);
+                size += sizeOf(property.countType);
+                check(data + size, count, sizeOf(property.type));
+                size += count * sizeOf(property.type);
+            }
+            else
+                size += sizeOf(property.type);
+        }
+        check(data, size);
+        return size;
+    }
+
+private:
+    template <typename T>
+    T _load(const char* data) const
+    {
+        T value;
+        if (_swap)
+        {
+            char bytes[sizeof(T)];
+            std::reverse_copy(data, data + sizeof(T), bytes);
+            std::memcpy(&value, bytes, sizeof(T));
+        }
+        else
+            std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    const char* _end;
+    const bool _swap;
+};
+
+/**
+ * @return false if the file is not a binary PLY file or uses unknown types,
+ *         otherwise the elements, the endianness and the offset of the data
+ */
+bool parsePlyHeader(const char* data, const size_t size,
+                    std::vector<PlyElement>& elements, bool& swap,
+                    size_t& offset)
+{
+    const std::string END_HEADER = "end_header";
+    const char* end = data + size;
+    const char* headerEnd =
+        std::search(data, end, END_HEADER.begin(), END_HEADER.end());
+    const char* dataStart = std::find(headerEnd, end, '\n');
+    if (dataStart == end)
+        throw std::runtime_error("Invalid PLY header");
+    offset = dataStart + 1 - data;
+
+    std::istringstream header(std::string(data, headerEnd));
+    std::string line;
+    std::getline(header, line);
+    if (line.compare(0, 3, "ply") != 0)
+        throw std::runtime_error("Invalid PLY header");
+
+    bool binary = false;
+    while (std::getline(header, line))
+    {
+        std::istringstream tokens(line);
+        std::string keyword;
+        tokens >> keyword;
+        if (keyword == "format")
+        {
+            std::string format;
+            tokens >> format;
+            binary = format == "binary_little_endian" ||
+                     format == "binary_big_endian";
+            swap = (format == "binary_little_endian") != isLittleEndian();
+        }
+        else if (keyword == "element")
+        {
+            PlyElement element;
+            tokens >> element.name >> element.count;
+            if (!tokens)
+                throw std::runtime_error("Invalid PLY element: " + line);
+            elements.push_back(element);
+        }
+        else if (keyword == "property")
+        {
+            if (elements.empty())
+                throw std::runtime_error("Invalid PLY property: " + line);
+            PlyProperty property;
+            std::string type;
+            tokens >> type;
+            if (type == "list")
+            {
+                std::string countType;
+                tokens >> countType >> type;
+                property.isList = true;
+                if (!toPlyType(countType, property.countType))
+                    return false;
+            }
+            tokens >> property.name;
+            if (!tokens || !toPlyType(type, property.type))
+                return false;
+            elements.back().properties.push_back(property);
+        }
+    }
+    return binary;
+}
+
+bool readPly(const char* data, const size_t size, const bool smoothNormals,
+             TriangleMesh& mesh)
+{
+    std::vector<PlyElement> elements;
+    bool swap = false;
+    size_t offset = 0;
+    if (!parsePlyHeader(data, size, elements, swap, offset))
+        return false;
+
+    // Locate the vertex and face records, skipping the other elements
+    const PlyReader reader(data + size, swap);
+    const PlyElement* vertexElement = nullptr;
+    const PlyElement* faceElement = nullptr;
+    const char* vertexData = nullptr;
+    const char* faceData = nullptr;
+    const char* position = data + offset;
+    for (const auto& element : elements)
+    {
+        if (vertexElement && faceElement)
+            break;
+        if (element.name == "vertex")
+        {
+            vertexElement = &element;
+            vertexData = position;
+        }
+        else if (element.name == "face")
+        {
+            faceElement = &element;
+            faceData = position;
+        }
+
+        if (element.hasLists())
+        {
+            for (size_t i = 0; i < element.count; ++i)
+                position += reader.recordSize(element, position);
+        }
+        else
+        {
+            reader.check(position, element.count, element.stride());
+            position += element.count * element.stride();
+        }
+    }
+
+    // Point clouds and lists of vertex attributes are left to assimp
+    if (!vertexElement || !faceElement || vertexElement->hasLists())
+        return false;
+
+    // Faces are triangles with a fixed record size in most files, which are
+    // converted in parallel; polygons require a sequential walk
+    const PlyProperty* indexProperty = nullptr;
+    bool fixedStride = true;
+    size_t listOffset = 0;
+    size_t faceStride = 0;
+    for (const auto& property : faceElement->properties)
+    {
+        if (property.isList && !indexProperty &&
+            (property.name == "vertex_indices" ||
+             property.name == "vertex_index"))
+        {
+            indexProperty = &property;
+            listOffset = faceStride;
+            faceStride +=
+                sizeOf(property.countType) + 3 * sizeOf(property.type);
+        }
+        else if (property.isList)
+            fixedStride = false;
+        else
+            faceStride += sizeOf(property.type);
+    }
+    if (!indexProperty)
+        return false;
+
+    std::map<std::string, PlyField> fields;
+    size_t stride = 0;
+    for (const auto& property : vertexElement->properties)
+    {
+        fields[property.name] = {stride, property.type};
+        stride += sizeOf(property.type);
+    }
+    const auto findFields = [&fields](const strings& names) {
+        std::vector<PlyField> found;
+        for (const auto& name : names)
+        {
+            const auto i = fields.find(name);
+            if (i == fields.end())
+                return std::vector<PlyField>();
+            found.push_back(i->second);
+        }
+        return found;
+    };
+
+    const auto positionFields = findFields({"x", "y", "z"});
+    if (positionFields.empty())
+        return false;
+    const auto normalFields = findFields({"nx", "ny", "nz"});
+    const auto colorFields = findFields({"red", "green", "blue"});
+    const auto alphaFields = findFields({"alpha"});
+    std::vector<PlyField> texCoordFields;
+    for (const auto& names : std::vector<strings>{{"u", "v"},
+                                                  {"s", "t"},
+                                                  {"texture_u", "texture_v"},
+                                                  {"texture_s", "texture_t"}})
+        if (texCoordFields.empty())
+            texCoordFields = findFields(names);
+
+    const size_t nbVertices = vertexElement->count;
+    reader.check(vertexData, nbVertices, stride);
+    mesh.vertices.resize(nbVertices);
+    if (!normalFields.empty())
+        mesh.normals.resize(nbVertices);
+    if (!colorFields.empty())
+        mesh.colors.resize(nbVertices);
+    if (!texCoordFields.empty())
+        mesh.textureCoordinates.resize(nbVertices);
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(nbVertices); ++i)
+    {
+        const char* vertex = vertexData + i * stride;
+        const auto readField = [&reader, vertex](const PlyField& field) {
+            return float(reader.read(vertex + field.offset, field.type));
+        };
+
+        mesh.vertices[i] = {readField(positionFields[0]),
+                            readField(positionFields[1]),
+                            readField(positionFields[2])};
+        if (!normalFields.empty())
+            mesh.normals[i] = {readField(normalFields[0]),
+                               readField(normalFields[1]),
+                               readField(normalFields[2])};
+        if (!colorFields.empty())
+        {
+            auto& color = mesh.colors[i];
+            for (size_t j = 0; j < 3; ++j)
+                color[j] = readField(colorFields[j]) *
+                           colorScale(colorFields[j].type);
+            color.w = alphaFields.empty() ? 1.f
+                                          : readField(alphaFields[0]) *
+                                                colorScale(alphaFields[0].type);
+        }
+        if (!texCoordFields.empty())
+            mesh.textureCoordinates[i] = {readField(texCoordFields[0]),
+                                          readField(texCoordFields[1])};
+    }
+
+    const size_t nbFaces = faceElement->count;
+    const auto countType = indexProperty->countType;
+    const auto indexType = indexProperty->type;
+    const auto indexSize = sizeOf(indexType);
+    std::atomic_bool validIndices{true};
+    const auto readIndex = [&](const char* index) {
+        const auto value = reader.read(index, indexType);
+        if (value < 0 || value >= nbVertices)
+        {
+            validIndices = false;
+            return 0u;
+        }
+        return uint32_t(value);
+    };
+
+    bool triangles =
+        fixedStride && nbFaces <= size_t(data + size - faceData) /
+                                      std::max<size_t>(faceStride, 1);
+    if (triangles)
+    {
+        std::atomic_bool polygons{false};
+        mesh.indices.resize(nbFaces);
+#pragma omp parallel for
+        for (int64_t i = 0; i < int64_t(nbFaces); ++i)
+        {
+            const char* list = faceData + i * faceStride + listOffset;
+            if (reader.read(list, countType) != 3)
+            {
+                polygons = true;
+                continue;
+            }
+            const char* indices = list + sizeOf(countType);
+            mesh.indices[i] = {readIndex(indices),
+                               readIndex(indices + indexSize),
+                               readIndex(indices + 2 * indexSize)};
+        }
+        triangles = !polygons;
+    }
+
+    if (!triangles)
+    {
+        // The indices read above may come from misaligned polygon records
+        validIndices = true;
+        mesh.indices.clear();
+        mesh.indices.reserve(nbFaces);
+        std::vector<uint32_t> polygon;
+        const char* face = faceData;
+        for (size_t i = 0; i < nbFaces; ++i)
+        {
+            size_t recordSize = 0;
+            for (const auto& property : faceElement->properties)
+            {
+                if (!property.isList)
+                {
+                    recordSize += sizeOf(property.type);
+                    continue;
+                }
+                const auto count =
+                    reader.readCount(face + recordSize, property.countType);
+                recordSize += sizeOf(property.countType);
+                const char* items = face + recordSize;
+                reader.check(items, count, sizeOf(property.type));
+                recordSize += count * sizeOf(property.type);
+                if (&property != indexProperty)
+                    continue;
+
+                polygon.clear();
+                for (size_t j = 0; j < count; ++j)
+                    polygon.push_back(readIndex(items + j * indexSize));
+            }
+            reader.check(face, recordSize);
+            face += recordSize;
+
+            for (size_t j = 2; j < polygon.size(); ++j)
+                mesh.indices.emplace_back(polygon[0], polygon[j - 1],
+                                          polygon[j]);
+        }
+    }
+
+    if (!validIndices)
+        throw std::runtime_error("Invalid vertex index in PLY file");
+
+    if (smoothNormals && mesh.normals.empty())
+        mesh.normals = computeNormals(mesh.vertices, mesh.indices);
+    return true;
+}
+
+// ASCII OBJ
+
+/** Bits of the vertex format of the OBJ faces */
+const uint32_t OBJ_TEXTURE_COORDINATES = 1;
+const uint32_t OBJ_NORMALS = 2;
+
+/**
+ * A range of lines of an OBJ file, with the number of elements it defines.
+ * The same structure holds the offsets of the chunk in the mesh arrays.
+ */
+struct ObjChunk
+{
+    const char* begin{nullptr};
+    const char* end{nullptr};
+    size_t positions{0};
+    size_t colors{0};
+    size_t textureCoordinates{0};
+    size_t normals{0};
+    size_t triangles{0};
+    /** Bit i is set if faces with vertex format i are used */
+    uint32_t faceFormats{0};
+    bool supported{true};
+};
+
+/** Elements of an OBJ file, addressed by the indices of the file */
+struct ObjData
+{
+    Vector3fs positions;
+    Vector4fs colors;
+    std::vector<Vector2f> textureCoordinates;
+    Vector3fs normals;
+    /** Position indices, when faces do not reference other attributes */
+    std::vector<Vector3ui> triangles;
+    /** Position, texture coordinate and normal indices of each corner */
+    std::vector<Vector3ui> corners;
+};
+
+inline bool isSpace(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipSpaces(const char* c, const char* end)
+{
+    while (c != end && isSpace(*c))
+        ++c;
+    return c;
+}
+
+const char* skipToken(const char* c, const char* end)
+{
+    while (c != end && !isSpace(*c))
+        ++c;
+    return c;
+}
+
+bool isKeyword(const char* begin, const char* end, const char* keyword)
+{
+    const size_t length = std::strlen(keyword);
+    return size_t(end - begin) == length &&
+           std::memcmp(begin, keyword, length) == 0;
+}
+
+size_t countTokens(const char* c, const char* end)
+{
+    size_t count = 0;
+    for (c = skipSpaces(c, end); c != end; c = skipSpaces(c, end))
+    {
+        c = skipToken(c, end);
+        ++count;
+    }
+    return count;
+}
+
+/** Calls function for each line of the chunk, without the end of line */
+template <typename Function>
+void forEachLine(const ObjChunk& chunk, const Function& function)
+{
+    for (const char* c = chunk.begin; c < chunk.end;)
+    {
+        const char* lineEnd = std::find(c, chunk.end, '\n');
+        function(c, lineEnd);
+        c = lineEnd == chunk.end ? lineEnd : lineEnd + 1;
+    }
+}
+
+std::vector<ObjChunk> splitObj(const char* data, const size_t size)
+{
+    std::vector<ObjChunk> chunks;
+    const char* end = data + size;
+    for (const char* begin = data; begin < end;)
+    {
+        const char* chunkEnd =
+            std::find(begin + std::min(CHUNK_SIZE, size_t(end - begin)), end,
+                      '\n');
+        if (chunkEnd != end)
+            ++chunkEnd;
+        ObjChunk chunk;
+        chunk.begin = begin;
+        chunk.end = chunkEnd;
+        chunks.push_back(chunk);
+        begin = chunkEnd;
+    }
+    return chunks;
+}
+
+/** First pass: count the elements of the chunk and check its features. */
+void scanObj(ObjChunk& chunk)
+{
+    forEachLine(chunk, [&chunk](const char* begin, const char* end) {
+        begin = skipSpaces(begin, end);
+        const char* keywordEnd = skipToken(begin, end);
+        if (keywordEnd == begin || *begin == '#')
+            return;
+
+        const char* last = end;
+        while (last != keywordEnd && isSpace(*(last - 1)))
+            --last;
+        if (last != keywordEnd && *(last - 1) == '\\')
+            chunk.supported = false;
+
+        if (isKeyword(begin, keywordEnd, "v"))
+        {
+            ++chunk.positions;
+            if (countTokens(keywordEnd, end) >= 6)
+                ++chunk.colors;
+        }
+        else if (isKeyword(begin, keywordEnd, "vt"))
+            ++chunk.textureCoordinates;
+        else if (isKeyword(begin, keywordEnd, "vn"))
+            ++chunk.normals;
+        else if (isKeyword(begin, keywordEnd, "f"))
+        {
+            const auto nbCorners = countTokens(keywordEnd, end);
+            if (nbCorners < 3)
+                return;
+            chunk.triangles += nbCorners - 2;
+
+            const char* corner = skipSpaces(keywordEnd, end);
+            const char* cornerEnd = skipToken(corner, end);
+            const char* slash = std::find(corner, cornerEnd, '/');
+            uint32_t format = 0;
+            if (slash != cornerEnd)
+            {
+                const char* secondSlash = std::find(slash + 1, cornerEnd, '/');
+                if (secondSlash != slash + 1)
+                    format |= OBJ_TEXTURE_COORDINATES;
+                if (secondSlash != cornerEnd && secondSlash + 1 != cornerEnd)
+                    format |= OBJ_NORMALS;
+            }
+            chunk.faceFormats |= 1u << format;
+        }
+        else if (isKeyword(begin, keywordEnd, "mtllib") ||
+                 isKeyword(begin, keywordEnd, "usemtl"))
+            chunk.supported = false;
+    });
+}
+
+bool parseFloat(const char*& c, const char* end, float& value)
+{
+    c = skipSpaces(c, end);
+    const char* tokenEnd = skipToken(c, end);
+    if (c == tokenEnd)
+        return false;
+
+    char buffer[64];
+    const size_t length = std::min(size_t(tokenEnd - c), sizeof(buffer) - 1);
+    std::memcpy(buffer, c, length);
+    buffer[length] = 0;
+    Assimp::fast_atoreal_move<float>(buffer, value);
+    c = tokenEnd;
+    return true;
+}
+
+bool parseIndex(const char*& c, const char* end, int64_t& value)
+{
+    const bool negative = c != end && *c == '-';
+    if (negative)
+        ++c;
+    const char* digits = c;
+    value = 0;
+    while (c != end && *c >= '0' && *c <= '9')
+        value = value * 10 + (*c++ - '0');
+    if (negative)
+        value = -value;
+    return c != digits;
+}
+
+/**
+ * Converts a 1-based or negative relative OBJ index to a 0-based one, given
+ * the number of elements defined so far and in total.
+ */
+uint32_t resolveIndex(const int64_t index, const size_t defined,
+                      const size_t total)
+{
+    const int64_t resolved = index > 0 ? index - 1 : int64_t(defined) + index;
+    if (index == 0 || resolved < 0 || resolved >= int64_t(total))
+        return NO_INDEX;
+    return uint32_t(resolved);
+}
+
+/** Second pass: parse the elements of the chunk at its offsets in data. */
+void parseObj(const ObjChunk& chunk, ObjChunk offsets, const ObjChunk& total,
+              const uint32_t faceFormat, ObjData& data,
+              std::atomic_bool& valid)
+{
+    const bool hasColors = total.colors > 0;
+    const bool deindexed = faceFormat != 0;
+
+    forEachLine(chunk, [&](const char* begin, const char* end) {
+        begin = skipSpaces(begin, end);
+        const char* c = skipToken(begin, end);
+        if (isKeyword(begin, c, "v"))
+        {
+            auto& position = data.positions[offsets.positions];
+            for (size_t i = 0; i < 3; ++i)
+                if (!parseFloat(c, end, position[i]))
+                    position[i] = 0.f;
+            if (hasColors)
+            {
+                auto& color = data.colors[offsets.positions];
+                color.w = 1.f;
+                for (size_t i = 0; i < 3; ++i)
+                    if (!parseFloat(c, end, color[i]))
+                        color[i] = 0.f;
+            }
+            ++offsets.positions;
+        }
+        else if (isKeyword(begin, c, "vt"))
+        {
+            auto& textureCoordinate =
+                data.textureCoordinates[offsets.textureCoordinates++];
+            for (size_t i = 0; i < 2; ++i)
+                if (!parseFloat(c, end, textureCoordinate[i]))
+                    textureCoordinate[i] = 0.f;
+        }
+        else if (isKeyword(begin, c, "vn"))
+        {
+            auto& normal = data.normals[offsets.normals++];
+            for (size_t i = 0; i < 3; ++i)
+                if (!parseFloat(c, end, normal[i]))
+                    normal[i] = 0.f;
+        }
+        else if (isKeyword(begin, c, "f"))
+        {
+            if (countTokens(c, end) < 3)
+                return;
+
+            Vector3ui first;
+            Vector3ui previous;
+            size_t nbCorners = 0;
+            for (c = skipSpaces(c, end); c != end; c = skipSpaces(c, end))
+            {
+                const char* tokenEnd = skipToken(c, end);
+                Vector3ui corner(NO_INDEX);
+                int64_t number;
+                if (parseIndex(c, tokenEnd, number))
+                    corner[0] = resolveIndex(number, offsets.positions,
+                                             total.positions);
+                if (c != tokenEnd && *c == '/')
+                {
+                    ++c;
+                    if (parseIndex(c, tokenEnd, number))
+                        corner[1] = resolveIndex(number,
+                                                 offsets.textureCoordinates,
+                                                 total.textureCoordinates);
+                    if (c != tokenEnd && *c == '/')
+                    {
+                        ++c;
+                        if (parseIndex(c, tokenEnd, number))
+                            corner[2] = resolveIndex(number, offsets.normals,
+                                                     total.normals);
+                    }
+                }
+                c = tokenEnd;
+
+                if (corner[0] == NO_INDEX ||
+                    ((faceFormat & OBJ_TEXTURE_COORDINATES) &&
+                     corner[1] == NO_INDEX) ||
+                    ((faceFormat & OBJ_NORMALS) && corner[2] == NO_INDEX))
+                {
+                    valid = false;
+                    corner = Vector3ui(0);
+                }
+
+                if (nbCorners == 0)
+                    first = corner;
+                else if (nbCorners >= 2)
+                {
+                    if (deindexed)
+                    {
+                        auto triangle = &data.corners[3 * offsets.triangles];
+                        triangle[0] = first;
+                        triangle[1] = previous;
+                        triangle[2] = corner;
+                    }
+                    else
+                        data.triangles[offsets.triangles] = {first[0],
+                                                             previous[0],
+                                                             corner[0]};
+                    ++offsets.triangles;
+                }
+                previous = corner;
+                ++nbCorners;
+            }
+        }
+    });
+}
+
+bool readObj(const char* data, const size_t size, const bool smoothNormals,
+             TriangleMesh& mesh)
+{
+    auto chunks = splitObj(data, size);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < int64_t(chunks.size()); ++i)
+        scanObj(chunks[i]);
+
+    ObjChunk total;
+    std::vector<ObjChunk> offsets(chunks.size());
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        offsets[i] = total;
+        total.positions += chunks[i].positions;
+        total.colors += chunks[i].colors;
+        total.textureCoordinates += chunks[i].textureCoordinates;
+        total.normals += chunks[i].normals;
+        total.triangles += chunks[i].triangles;
+        total.faceFormats |= chunks[i].faceFormats;
+        total.supported = total.supported && chunks[i].supported;
+    }
+
+    // Materials, partial vertex colors and faces mixing vertex formats are
+    // left to assimp
+    const auto formats = total.faceFormats;
+    if (!total.supported || total.triangles == 0 ||
+        (total.colors != 0 && total.colors != total.positions) ||
+        (formats & (formats - 1)) != 0)
+    {
+        return false;
+    }
+    uint32_t faceFormat = 0;
+    while ((1u << faceFormat) != formats)
+        ++faceFormat;
+    const bool deindexed = faceFormat != 0;
+
+    ObjData obj;
+    obj.positions.resize(total.positions);
+    obj.colors.resize(total.colors);
+    obj.textureCoordinates.resize(total.textureCoordinates);
+    obj.normals.resize(total.normals);
+    if (deindexed)
+        obj.corners.resize(3 * total.triangles);
+    else
+        obj.triangles.resize(total.triangles);
+
+    std::atomic_bool valid{true};
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < int64_t(chunks.size()); ++i)
+        parseObj(chunks[i], offsets[i], total, faceFormat, obj, valid);
+    if (!valid)
+        throw std::runtime_error("Invalid vertex index in OBJ file");
+
+    if (!deindexed)
+    {
+        mesh.vertices = std::move(obj.positions);
+        mesh.colors = std::move(obj.colors);
+        mesh.indices = std::move(obj.triangles);
+        if (smoothNormals)
+            mesh.normals = computeNormals(mesh.vertices, mesh.indices);
+        return true;
+    }
+
+    // Texture coordinates and normals have their own indices in OBJ files,
+    // so each corner of the triangles becomes a vertex of the mesh
+    const bool hasTextureCoordinates = faceFormat & OBJ_TEXTURE_COORDINATES;
+    const bool hasNormals = faceFormat & OBJ_NORMALS;
+    Vector3fs positionNormals;
+    if (smoothNormals && !hasNormals)
+    {
+        std::vector<Vector3ui> triangles(total.triangles);
+#pragma omp parallel for
+        for (int64_t i = 0; i < int64_t(triangles.size()); ++i)
+            triangles[i] = {obj.corners[3 * i][0], obj.corners[3 * i + 1][0],
+                            obj.corners[3 * i + 2][0]};
+        positionNormals = computeNormals(obj.positions, triangles);
+    }
+
+    const size_t nbVertices = obj.corners.size();
+    mesh.vertices.resize(nbVertices);
+    mesh.indices.resize(total.triangles);
+    if (!obj.colors.empty())
+        mesh.colors.resize(nbVertices);
+    if (hasTextureCoordinates)
+        mesh.textureCoordinates.resize(nbVertices);
+    if (hasNormals || !positionNormals.empty())
+        mesh.normals.resize(nbVertices);
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(nbVertices); ++i)
+    {
+        const auto& corner = obj.corners[i];
+        mesh.vertices[i] = obj.positions[corner[0]];
+        if (!obj.colors.empty())
+            mesh.colors[i] = obj.colors[corner[0]];
+        if (hasTextureCoordinates)
+            mesh.textureCoordinates[i] = obj.textureCoordinates[corner[1]];
+        if (hasNormals)
+            mesh.normals[i] = obj.normals[corner[2]];
+        else if (!positionNormals.empty())
+            mesh.normals[i] = positionNormals[corner[0]];
+        if (i % 3 == 0)
+            mesh.indices[i / 3] = Vector3ui(uint32_t(i), uint32_t(i + 1),
+                                            uint32_t(i + 2));
+    }
+    return true;
+}
+} // namespace
+
+bool readMesh(const char* data, const size_t size, const std::string& type,
+              const bool smoothNormals, TriangleMesh& mesh)
+{
+    const auto extension = string_utils::toLowercase(type);
+    if (extension == "ply")
+        return readPly(data, size, smoothNormals, mesh);
+    if (extension == "obj")
+        return readObj(data, size, smoothNormals, mesh);
+    return false;
+}
+
+bool readMeshFile(const std::string& fileName, const bool smoothNormals,
+                  TriangleMesh& mesh)
+{
+    auto extension = fs::path(fileName).extension().string();
+    if (!extension.empty())
+        extension = string_utils::toLowercase(extension.substr(1));
+    if (extension != "ply" && extension != "obj")
+        return false;
+
+    const MappedFile file(fileName);
+    return readMesh(reinterpret_cast<const char*>(file.data()), file.size(),
+                    extension, smoothNormals, mesh);
+}
+} // namespace brayns
@@ -0,0 +1,47 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <brayns/common/geometry/TriangleMesh.h>
+
+namespace brayns
+{
+/**
+ * Read a binary PLY or an ASCII OBJ mesh straight into a triangle mesh,
+ * bypassing assimp. The vertices and faces are converted in parallel, faces
+ * with more than three vertices are split into triangle fans.
+ *
+ * Only the geometry is read: files relying on features this reader does not
+ * handle (ASCII PLY, PLY point clouds, OBJ materials, mixed OBJ face formats,
+ * line continuations) are reported as unsupported and have to be imported
+ * with assimp instead.
+ *
+ * @param type the file extension, "ply" or "obj"
+ * @param smoothNormals compute smooth vertex normals if the file has none
+ * @return false if the file is not supported, true if mesh has been filled
+ * @throw std::runtime_error if the file is malformed
+ */
+bool readMesh(const char* data, size_t size, const std::string& type,
+              bool smoothNormals, TriangleMesh& mesh);
+
+/** Memory map the given file and read it with readMesh(). */
+bool readMeshFile(const std::string& fileName, bool smoothNormals,
+                  TriangleMesh& mesh);
+} // namespace brayns
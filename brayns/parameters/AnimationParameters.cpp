@@ -20,10 +20,15 @@
 
 #include "AnimationParameters.h"
 
+#include <cmath>
+
 namespace
 {
 constexpr auto PARAM_ANIMATION_FRAME = "animation-frame";
 constexpr auto PARAM_PLAY_ANIMATION = "play-animation";
+
+// Fractions closer to a frame are rounding errors of fractional deltas
+constexpr double FRAME_EPSILON = 1e-6;
 }
 
 namespace brayns
@@ -47,6 +52,7 @@ void AnimationParameters::print()
 void AnimationParameters::reset()
 {
     _updateValue(_current, 0u, false);
+    _updateValue(_fraction, 0., false);
     _updateValue(_dt, 0., false);
     _updateValue(_numFrames, 0u, false);
     _updateValue(_playing, false, false);
@@ -57,7 +63,24 @@ void AnimationParameters::reset()
         markModified();
 }
 
-void AnimationParameters::setDelta(const int32_t delta)
+void AnimationParameters::setFramePosition(const double position)
+{
+    if (_numFrames == 0)
+    {
+        setFrame(0);
+        return;
+    }
+
+    auto bounded = std::fmod(position, static_cast<double>(_numFrames));
+    if (bounded < 0)
+        bounded += _numFrames;
+    const auto frame = std::floor(bounded + FRAME_EPSILON);
+    _updateValue(_current,
+                 std::min(static_cast<uint32_t>(frame), _numFrames - 1));
+    _updateValue(_fraction, std::max(0., bounded - frame));
+}
+
+void AnimationParameters::setDelta(const double delta)
 {
     if (delta == 0)
         throw std::logic_error("Animation delta cannot be set to 0");
@@ -67,7 +90,7 @@ void AnimationParameters::setDelta(const int32_t delta)
 void AnimationParameters::update()
 {
     if (_playing && _canUpdateFrame())
-        setFrame(getFrame() + getDelta());
+        setFramePosition(getFramePosition() + getDelta());
 }
 
 void AnimationParameters::jumpFrames(int frames)
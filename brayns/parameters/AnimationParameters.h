@@ -43,11 +43,21 @@ public:
     void setFrame(uint32_t value)
     {
         _updateValue(_current, _adjustedCurrent(value));
+        _updateValue(_fraction, 0.);
     }
     uint32_t getFrame() const { return _current; }
-    /** The (frame) delta to apply for animations to select the next frame. */
-    void setDelta(const int32_t delta);
-    int32_t getDelta() const { return _delta; }
+    /**
+     * The current position of the animation in frames; the fractional part
+     * selects an interpolation between two simulation frames.
+     */
+    void setFramePosition(double position);
+    double getFramePosition() const { return _current + _fraction; }
+    /**
+     * The (frame) delta to apply for animations to select the next frame; a
+     * fractional delta plays the animation in slow motion.
+     */
+    void setDelta(const double delta);
+    double getDelta() const { return _delta; }
     void setNumFrames(const uint32_t numFrames,
                       const bool triggerCallback = true)
     {
@@ -107,7 +117,8 @@ private:
 
     uint32_t _numFrames{0};
     uint32_t _current{0};
-    int32_t _delta{1};
+    double _fraction{0};
+    double _delta{1};
     bool _playing{false};
     double _dt{0};
     std::string _unit;
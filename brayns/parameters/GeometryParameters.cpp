@@ -29,6 +29,10 @@ const std::string PARAM_GEOMETRY_QUALITY = "geometry-quality";
 const std::string PARAM_RADIUS_MULTIPLIER = "radius-multiplier";
 const std::string PARAM_MEMORY_MODE = "memory-mode";
 const std::string PARAM_DEFAULT_BVH_FLAG = "default-bvh-flag";
+const std::string PARAM_MATERIAL_TABLE = "material-table";
+const std::string PARAM_LOADER_CACHE = "loader-cache";
+const std::string PARAM_FRUSTUM_CULLING = "frustum-culling";
+const std::string PARAM_OCCLUSION_CULLING = "occlusion-culling";
 
 const std::array<std::string, 5> COLOR_SCHEMES = {
     {"none", "by-id", "protein-atoms", "protein-chains", "protein-residues"}};
@@ -65,7 +69,32 @@ GeometryParameters::GeometryParameters()
         (PARAM_DEFAULT_BVH_FLAG.c_str(),
          po::value<std::vector<std::string>>()->multitoken(),
          "Set a default flag to apply to BVH creation, one of "
-         "[dynamic|compact|robust], may appear multiple times.");
+         "[dynamic|compact|robust], may appear multiple times.")
+        //
+        (PARAM_MATERIAL_TABLE.c_str(),
+         po::bool_switch(&_materialTable)->default_value(false),
+         "Share one geometry per primitive type and index materials per "
+         "primitive instead of creating one geometry per material")
+        //
+        (PARAM_LOADER_CACHE.c_str(), po::value<std::string>(),
+         "Folder where models imported from files are cached, and loaded "
+         "from when the file and loader properties are unchanged [string]")
+        //
+        (PARAM_FRUSTUM_CULLING.c_str(),
+         po::bool_switch(&_frustumCulling)->default_value(false),
+         "Only render the model instances in the view of the camera. Culled "
+         "instances are removed from the scene for all rays: they no longer "
+         "cast shadows, occlude ambient light or show in reflections and "
+         "refractions, so only use it with renderers without secondary rays")
+        //
+        (PARAM_OCCLUSION_CULLING.c_str(),
+         po::bool_switch(&_occlusionCulling)->default_value(false),
+         "Also skip the model instances hidden behind the geometry of the "
+         "previous frame, once the camera stopped moving. Same limitations as "
+         "--frustum-culling. The depth of the previous frame is the one of the "
+         "first hit, also for transparent geometry, so instances behind "
+         "transparent surfaces are culled as well: only use it with opaque "
+         "materials");
 }
 
 void GeometryParameters::parse(const po::variables_map& vm)
@@ -107,6 +136,8 @@ void GeometryParameters::parse(const po::variables_map& vm)
             if (memoryMode == GEOMETRY_MEMORY_MODES[i])
                 _memoryMode = static_cast<MemoryMode>(i);
     }
+    if (vm.count(PARAM_LOADER_CACHE))
+        _loaderCache = vm[PARAM_LOADER_CACHE].as<std::string>();
     if (vm.count(PARAM_DEFAULT_BVH_FLAG))
     {
         const auto& bvhs =
@@ -138,5 +169,13 @@ void GeometryParameters::print()
     BRAYNS_INFO << "Memory mode                : "
                 << (_memoryMode == MemoryMode::shared ? "Shared" : "Replicated")
                 << std::endl;
+    BRAYNS_INFO << "Material table             : "
+                << (_materialTable ? "on" : "off") << std::endl;
+    BRAYNS_INFO << "Loader cache               : "
+                << (_loaderCache.empty() ? "off" : _loaderCache) << std::endl;
+    BRAYNS_INFO << "Frustum culling            : "
+                << (_frustumCulling ? "on" : "off") << std::endl;
+    BRAYNS_INFO << "Occlusion culling          : "
+                << (_occlusionCulling ? "on" : "off") << std::endl;
 }
 }
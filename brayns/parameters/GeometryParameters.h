@@ -54,12 +54,38 @@ public:
     {
         return _defaultBVHFlags;
     }
+    /**
+     * Whether models should index their materials per primitive from a single
+     * material table instead of creating one geometry per material
+     */
+    bool getMaterialTable() const { return _materialTable; }
+    /**
+     * Folder of the on-disk cache for models imported from files, empty if
+     * the cache is disabled
+     */
+    const std::string& getLoaderCache() const { return _loaderCache; }
+    /**
+     * Whether model instances outside of the view frustum are skipped. They
+     * are skipped for all rays, so secondary rays (shadows, ambient occlusion,
+     * reflections) miss them.
+     */
+    bool getFrustumCulling() const { return _frustumCulling; }
+    /**
+     * Whether model instances hidden in the depth buffer of the previous frame
+     * are skipped. The depth buffer holds the first hit, so instances behind
+     * transparent geometry are skipped too.
+     */
+    bool getOcclusionCulling() const { return _occlusionCulling; }
 
 protected:
     void parse(const po::variables_map& vm) final;
 
     // Scene
     std::set<BVHFlag> _defaultBVHFlags;
+    bool _materialTable{false};
+    std::string _loaderCache;
+    bool _frustumCulling{false};
+    bool _occlusionCulling{false};
 
     // Geometry
     ColorScheme _colorScheme{ColorScheme::none};
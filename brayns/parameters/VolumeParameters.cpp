@@ -24,6 +24,10 @@ namespace
 const std::string PARAM_VOLUME_DIMENSIONS = "volume-dimensions";
 const std::string PARAM_VOLUME_ELEMENT_SPACING = "volume-element-spacing";
 const std::string PARAM_VOLUME_OFFSET = "volume-offset";
+const std::string PARAM_VOLUME_PRE_INTEGRATION = "volume-pre-integration";
+const std::string PARAM_VOLUME_DISABLE_ADAPTIVE_SAMPLING =
+    "disable-volume-adaptive-sampling";
+const std::string PARAM_VOLUME_SAMPLING_RATE = "volume-sampling-rate";
 }
 
 namespace brayns
@@ -41,7 +45,15 @@ VolumeParameters::VolumeParameters()
         po::fixed_tokens_value<floats>(3, 3),
         "Element spacing in the volume [float float float]")(
         PARAM_VOLUME_OFFSET.c_str(), po::fixed_tokens_value<floats>(3, 3),
-        "Volume offset [float float float]");
+        "Volume offset [float float float]")(
+        PARAM_VOLUME_PRE_INTEGRATION.c_str(),
+        po::bool_switch(&_preIntegration)->default_value(false),
+        "Pre-integrate the transfer function between samples")(
+        PARAM_VOLUME_DISABLE_ADAPTIVE_SAMPLING.c_str(),
+        po::bool_switch()->default_value(false),
+        "Disable skipping of transparent regions and adaptive sampling")(
+        PARAM_VOLUME_SAMPLING_RATE.c_str(), po::value<double>(&_samplingRate),
+        "Volume sampling rate [float]");
 }
 
 void VolumeParameters::parse(const po::variables_map& vm)
@@ -61,6 +73,7 @@ void VolumeParameters::parse(const po::variables_map& vm)
         auto values = vm[PARAM_VOLUME_OFFSET].as<floats>();
         _offset = Vector3f(values[0], values[1], values[2]);
     }
+    _adaptiveSampling = !vm[PARAM_VOLUME_DISABLE_ADAPTIVE_SAMPLING].as<bool>();
     markModified();
 }
 
@@ -70,5 +83,10 @@ void VolumeParameters::print()
     BRAYNS_INFO << "Dimensions      : " << _dimensions << std::endl;
     BRAYNS_INFO << "Element spacing : " << _elementSpacing << std::endl;
     BRAYNS_INFO << "Offset          : " << _offset << std::endl;
+    BRAYNS_INFO << "Pre-integration : " << asString(_preIntegration)
+                << std::endl;
+    BRAYNS_INFO << "Adaptive        : " << asString(_adaptiveSampling)
+                << std::endl;
+    BRAYNS_INFO << "Sampling rate   : " << _samplingRate << std::endl;
 }
 }
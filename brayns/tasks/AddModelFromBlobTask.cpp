@@ -35,8 +35,10 @@ AddModelFromBlobTask::AddModelFromBlobTask(const BinaryParam& param,
     : _param(param)
 {
     _checkValidity(engine);
+    _createStream(engine);
 
-    _blob.reserve(param.size);
+    if (!_stream)
+        _blob.reserve(param.size);
 
     LoadModelFunctor functor{engine, param};
     functor.setCancelToken(_cancelToken);
@@ -48,7 +50,12 @@ AddModelFromBlobTask::AddModelFromBlobTask(const BinaryParam& param,
 
     // load data, return model descriptor or stop if blob receive was invalid
     _finishTasks.emplace_back(_errorEvent.get_task());
-    _finishTasks.emplace_back(_chunkEvent.get_task().then(std::move(functor)));
+    if (_stream)
+        _finishTasks.emplace_back(
+            _streamEvent.get_task().then(std::move(functor)));
+    else
+        _finishTasks.emplace_back(
+            _chunkEvent.get_task().then(std::move(functor)));
     _task = async::when_any(_finishTasks)
                 .then([&engine](async::when_any_result<
                                 std::vector<async::task<ModelDescriptorPtr>>>
@@ -61,25 +68,78 @@ AddModelFromBlobTask::AddModelFromBlobTask(const BinaryParam& param,
 void AddModelFromBlobTask::appendBlob(const std::string& blob)
 {
     // if more bytes than expected are received, error and stop
-    if (_blob.size() + blob.size() > _param.size)
+    if (_receivedBytes + blob.size() > _param.size)
     {
         _errorEvent.set_exception(
             std::make_exception_ptr(INVALID_BINARY_RECEIVE));
         return;
     }
 
-    _blob.insert(_blob.end(), blob.begin(), blob.end());
+    if (_stream)
+        _appendToStream(blob);
+    else
+        _blob.insert(_blob.end(), blob.begin(), blob.end());
 
     _receivedBytes += blob.size();
     std::stringstream msg;
     msg << "Receiving " << _param.getName() << " ...";
     progress.update(msg.str(), _progressBytes());
 
+    if (_receivedBytes < _param.size)
+        return;
+
     // if blob is complete, start the loading
-    if (_blob.size() == _param.size)
+    if (_stream)
+    {
+        // Finish loading once all chunks were processed by the stream; a
+        // failed chunk skips the remaining ones and stops the task.
+        _streamTask.then([this](async::task<void> appended) {
+            try
+            {
+                appended.get();
+                _streamEvent.set(_stream);
+            }
+            catch (const std::exception& e)
+            {
+                _errorEvent.set_exception(
+                    std::make_exception_ptr(LOADING_BINARY_FAILED(e.what())));
+            }
+        });
+    }
+    else
         _chunkEvent.set({_param.type, _param.getName(), std::move(_blob)});
 }
 
+void AddModelFromBlobTask::_createStream(Engine& engine)
+{
+    const auto& registry = engine.getScene().getLoaderRegistry();
+    const auto& loader =
+        registry.getSuitableLoader("", _param.type, _param.getLoaderName());
+
+    // HACK: Add loader name in properties for archive loader
+    auto properties = _param.getLoaderProperties();
+    properties.setProperty({"loaderName", _param.getLoaderName()});
+
+    const LoaderProgress callback(
+        [& progress = progress, w = CHUNK_PROGRESS_WEIGHT ](
+            const std::string& msg, const float amount) {
+            progress.update(msg, w + (amount * (1.f - w)));
+        });
+
+    _stream = loader.createStream(_param.type, _param.getName(), _param.size,
+                                  callback, properties);
+}
+
+void AddModelFromBlobTask::_appendToStream(const std::string& blob)
+{
+    // Chunks are processed in order in the background, while the next ones
+    // are received.
+    _streamTask = _streamTask.then([stream = _stream, chunk = blob] {
+        stream->append(reinterpret_cast<const uint8_t*>(chunk.data()),
+                       chunk.size());
+    });
+}
+
 void AddModelFromBlobTask::_checkValidity(Engine& engine)
 {
     if (_param.type.empty() || _param.size == 0)
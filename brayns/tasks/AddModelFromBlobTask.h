@@ -48,6 +48,10 @@ struct BinaryParam : ModelParams
 /**
  * A task which receives a file blob, triggers loading of the received blob
  * and adds the loaded model to the engines' scene.
+ *
+ * If the loader supports streaming, each received chunk is passed to the loader
+ * stream in the background while the next chunks are still being received,
+ * and the blob is never buffered as a whole.
  */
 class AddModelFromBlobTask : public Task<ModelDescriptorPtr>
 {
@@ -58,10 +62,14 @@ public:
 
 private:
     void _checkValidity(Engine& engine);
+    void _createStream(Engine& engine);
+    void _appendToStream(const std::string& blob);
     void _cancel() final
     {
         _chunkEvent.set_exception(
             std::make_exception_ptr(async::task_canceled()));
+        _streamEvent.set_exception(
+            std::make_exception_ptr(async::task_canceled()));
     }
     float _progressBytes() const
     {
@@ -69,6 +77,9 @@ private:
     }
 
     async::event_task<Blob> _chunkEvent;
+    async::event_task<LoaderStreamPtr> _streamEvent;
+    LoaderStreamPtr _stream;
+    async::task<void> _streamTask{async::make_task()};
     async::event_task<ModelDescriptorPtr> _errorEvent;
     std::vector<async::task<ModelDescriptorPtr>> _finishTasks;
     uint8_ts _blob;
@@ -44,6 +44,11 @@ ModelDescriptorPtr LoadModelFunctor::operator()(Blob&& blob)
     return _performLoad([&] { return _loadData(std::move(blob), _params); });
 }
 
+ModelDescriptorPtr LoadModelFunctor::operator()(LoaderStreamPtr stream)
+{
+    return _performLoad([&] { return _loadData(std::move(stream), _params); });
+}
+
 ModelDescriptorPtr LoadModelFunctor::operator()()
 {
     const auto& path = _params.getPath();
@@ -78,6 +83,17 @@ ModelDescriptorPtr LoadModelFunctor::_loadData(const std::string& path,
     return _engine.getScene().loadModel(path, params, {_getProgressFunc()});
 }
 
+ModelDescriptorPtr LoadModelFunctor::_loadData(LoaderStreamPtr stream,
+                                               const ModelParams& params)
+{
+    auto modelDescriptor = stream->finish();
+    if (!modelDescriptor)
+        throw std::runtime_error("No model returned by loader");
+    *modelDescriptor = params;
+    _engine.getScene().addModel(modelDescriptor);
+    return modelDescriptor;
+}
+
 void LoadModelFunctor::_updateProgress(const std::string& message,
                                        const size_t increment)
 {
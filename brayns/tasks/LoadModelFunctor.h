@@ -37,6 +37,7 @@ public:
     LoadModelFunctor(Engine& engine, const ModelParams& params);
     LoadModelFunctor(LoadModelFunctor&&) = default;
     ModelDescriptorPtr operator()(Blob&& blob);
+    ModelDescriptorPtr operator()(LoaderStreamPtr stream);
     ModelDescriptorPtr operator()();
 
 private:
@@ -46,6 +47,8 @@ private:
     ModelDescriptorPtr _loadData(Blob&& blob, const ModelParams& params);
     ModelDescriptorPtr _loadData(const std::string& path,
                                  const ModelParams& params);
+    ModelDescriptorPtr _loadData(LoaderStreamPtr stream,
+                                 const ModelParams& params);
 
     void _updateProgress(const std::string& message, const size_t increment);
 
@@ -82,29 +82,31 @@ void OptiXModel::commitGeometry()
     size_t nbSpheres = 0;
     size_t nbCylinders = 0;
     size_t nbCones = 0;
-    if (_spheresDirty)
-        for (const auto& spheres : _geometries->_spheres)
+    for (const auto& spheres : _geometries->_spheres)
+        if (_isDirty(_spheresDirty, _dirtySphereMaterials, spheres.first))
         {
             nbSpheres += spheres.second.size();
             _commitSpheres(spheres.first);
         }
 
-    if (_cylindersDirty)
-        for (const auto& cylinders : _geometries->_cylinders)
+    for (const auto& cylinders : _geometries->_cylinders)
+        if (_isDirty(_cylindersDirty, _dirtyCylinderMaterials,
+                     cylinders.first))
         {
             nbCylinders += cylinders.second.size();
             _commitCylinders(cylinders.first);
         }
 
-    if (_conesDirty)
-        for (const auto& cones : _geometries->_cones)
+    for (const auto& cones : _geometries->_cones)
+        if (_isDirty(_conesDirty, _dirtyConeMaterials, cones.first))
         {
             nbCones += cones.second.size();
             _commitCones(cones.first);
         }
 
-    if (_triangleMeshesDirty)
-        for (const auto& meshes : _geometries->_triangleMeshes)
+    for (const auto& meshes : _geometries->_triangleMeshes)
+        if (_isDirty(_triangleMeshesDirty, _dirtyTriangleMeshMaterials,
+                     meshes.first))
             _commitMeshes(meshes.first);
 
     updateBounds();
@@ -354,6 +356,15 @@ BrickedVolumePtr OptiXModel::createBrickedVolume(
     return nullptr;
 }
 
+/** @copydoc Model::createPagedVolume */
+PagedVolumePtr OptiXModel::createPagedVolume(
+    const Vector3ui& /*dimensions*/, const Vector3f& /*spacing*/,
+    const DataType /*type*/) const
+{
+    throw std::runtime_error("Not implemented");
+    return nullptr;
+}
+
 void OptiXModel::_commitTransferFunctionImpl(const Vector3fs& colors,
                                              const floats& opacities,
                                              const Vector2d valueRange)
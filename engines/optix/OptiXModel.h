@@ -54,6 +54,11 @@ public:
         const Vector3ui& dimensions, const Vector3f& spacing,
         const DataType type) const final;
 
+    /** @copydoc Model::createPagedVolume */
+    virtual PagedVolumePtr createPagedVolume(
+        const Vector3ui& dimensions, const Vector3f& spacing,
+        const DataType type) const final;
+
     ::optix::GeometryGroup getGeometryGroup() const { return _geometryGroup; }
     ::optix::GeometryGroup getBoundingBoxGroup() const
     {
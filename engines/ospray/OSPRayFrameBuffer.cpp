@@ -92,7 +92,7 @@ void OSPRayFrameBuffer::_recreate()
     if (_pixelOp)
         ospSetPixelOp(_frameBuffer, _pixelOp);
     osphelper::set(_frameBuffer, "name", getName());
-    ospCommit(_frameBuffer);
+    _setRenderRegions(_frameBuffer, 1);
 
     _recreateSubsamplingBuffer();
 
@@ -112,7 +112,7 @@ void OSPRayFrameBuffer::_recreateSubsamplingBuffer()
                               OSP_FB_COLOR | OSP_FB_DEPTH);
         if (_pixelOp)
             ospSetPixelOp(_subsamplingFrameBuffer, _pixelOp);
-        ospCommit(_subsamplingFrameBuffer);
+        _setRenderRegions(_subsamplingFrameBuffer, _subsamplingFactor);
     }
 }
 
@@ -211,6 +211,48 @@ void OSPRayFrameBuffer::setSubsampling(size_t factor)
     _recreateSubsamplingBuffer();
 }
 
+void OSPRayFrameBuffer::setRenderRegions(const RenderRegions& regions)
+{
+    FrameBuffer::setRenderRegions(regions);
+
+    auto lock = getScopeLock();
+    _setRenderRegions(_frameBuffer, 1);
+    if (_subsamplingFrameBuffer)
+        _setRenderRegions(_subsamplingFrameBuffer, _subsamplingFactor);
+
+    // Tiles entering the regions did not accumulate so far
+    clear();
+}
+
+void OSPRayFrameBuffer::_setRenderRegions(OSPFrameBuffer frameBuffer,
+                                          const size_t factor)
+{
+    // Read by the renderers and pixel ops as {lower x, lower y, upper x,
+    // upper y} pixels, see ispc/render/utils/RenderRegions.h
+    if (_renderRegions.empty())
+        ospSetObject(frameBuffer, "renderRegions", nullptr);
+    else
+    {
+        std::vector<int32_t> regions;
+        regions.reserve(4 * _renderRegions.size());
+        for (const auto& region : _renderRegions)
+        {
+            // Round outwards for the subsampled frame
+            const Vector2ui lower = region.position / uint32_t(factor);
+            const Vector2ui upper =
+                (region.position + region.size + uint32_t(factor - 1)) /
+                uint32_t(factor);
+            regions.insert(regions.end(), {int32_t(lower.x), int32_t(lower.y),
+                                           int32_t(upper.x), int32_t(upper.y)});
+        }
+        auto data =
+            ospNewData(_renderRegions.size(), OSP_INT4, regions.data());
+        ospSetData(frameBuffer, "renderRegions", data);
+        ospRelease(data);
+    }
+    ospCommit(frameBuffer);
+}
+
 void OSPRayFrameBuffer::createPixelOp(const std::string& name)
 {
     if (_pixelOp)
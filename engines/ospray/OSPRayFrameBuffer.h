@@ -55,10 +55,12 @@ public:
     OSPFrameBuffer impl() { return _currentFB(); }
     void createPixelOp(const std::string& name) final;
     void updatePixelOp(const PropertyMap& properties) final;
+    void setRenderRegions(const RenderRegions& regions) final;
 
 private:
     void _recreate();
     void _recreateSubsamplingBuffer();
+    void _setRenderRegions(OSPFrameBuffer frameBuffer, size_t factor);
     void _unmapUnsafe();
     void _mapUnsafe();
     bool _useSubsampling() const;
@@ -28,6 +28,9 @@
 #include <brayns/engine/Scene.h>
 #include <brayns/parameters/AnimationParameters.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace brayns
 {
 namespace
@@ -41,6 +44,80 @@ OSPData allocateVectorData(const std::vector<VecT>& vec,
     return ospNewData(totBytes / ospray::sizeOf(ospType), ospType, vec.data(),
                       memoryManagementFlags);
 }
+
+/** @param newData creates the OSPData of a vector, given its type */
+template <typename NewData>
+void setMeshData(OSPGeometry geometry, const TriangleMesh& mesh,
+                 const NewData& newData)
+{
+    OSPData vertices = newData(mesh.vertices, OSP_FLOAT3);
+    ospSetObject(geometry, "position", vertices);
+    ospRelease(vertices);
+
+    OSPData indices = newData(mesh.indices, OSP_INT3);
+    ospSetObject(geometry, "index", indices);
+    ospRelease(indices);
+
+    if (!mesh.normals.empty())
+    {
+        OSPData normals = newData(mesh.normals, OSP_FLOAT3);
+        ospSetObject(geometry, "vertex.normal", normals);
+        ospRelease(normals);
+    }
+
+    if (!mesh.colors.empty())
+    {
+        OSPData colors = newData(mesh.colors, OSP_FLOAT3A);
+        ospSetObject(geometry, "vertex.color", colors);
+        ospRelease(colors);
+    }
+
+    if (!mesh.textureCoordinates.empty())
+    {
+        OSPData texCoords = newData(mesh.textureCoordinates, OSP_FLOAT2);
+        ospSetObject(geometry, "vertex.texcoord", texCoords);
+        ospRelease(texCoords);
+    }
+
+    osphelper::set(geometry, "alpha_type", 0);
+    osphelper::set(geometry, "alpha_component", 4);
+}
+
+void setMeshData(OSPGeometry geometry, const TriangleMesh& mesh,
+                 const size_t memoryManagementFlags)
+{
+    setMeshData(geometry, mesh,
+                [memoryManagementFlags](const auto& vec,
+                                        const OSPDataType type) {
+                    return allocateVectorData(vec, type,
+                                              memoryManagementFlags);
+                });
+}
+
+template <typename T>
+void addSource(std::vector<std::pair<const void*, size_t>>& sources,
+               const std::vector<T>& vec)
+{
+    if (!vec.empty())
+        sources.emplace_back(vec.data(), vec.size() * sizeof(T));
+}
+
+template <typename T>
+void freeVector(std::vector<T>& vec)
+{
+    std::vector<T>().swap(vec);
+}
+
+template <typename T>
+size_t primitiveCount(const std::vector<T>& primitives)
+{
+    return primitives.size();
+}
+
+size_t primitiveCount(const TriangleMesh& mesh)
+{
+    return mesh.indices.size();
+}
 } // namespace
 
 OSPRayModel::OSPRayModel(AnimationParameters& animationParameters,
@@ -55,7 +132,8 @@ OSPRayModel::OSPRayModel(AnimationParameters& animationParameters,
 OSPRayModel::~OSPRayModel()
 {
     ospRelease(_ospTransferFunction);
-    ospRelease(_ospSimulationData);
+    for (auto& buffer : _simulationBuffers)
+        ospRelease(buffer.ospData);
 
     const auto releaseAndClearGeometry = [](auto& geometryMap) {
         for (auto geom : geometryMap)
@@ -70,6 +148,18 @@ OSPRayModel::~OSPRayModel()
     releaseAndClearGeometry(_ospStreamlines);
     releaseAndClearGeometry(_ospSDFGeometries);
 
+    ospRelease(_ospIndexedSpheres);
+    ospRelease(_ospIndexedCylinders);
+    ospRelease(_ospIndexedCones);
+    ospRelease(_ospIndexedMeshes);
+    ospRelease(_ospMaterialTable);
+
+    for (auto& geometries : _ospMeshLODs)
+        releaseAndClearGeometry(geometries);
+    releaseAndClearGeometry(_ospMeshLODBase);
+    for (auto model : _lodModels)
+        ospRelease(model);
+
     ospRelease(_primaryModel);
     ospRelease(_secondaryModel);
     ospRelease(_boundingBoxModel);
@@ -152,9 +242,15 @@ OSPGeometry& OSPRayModel::_createGeometry(GeometryMap& map,
     {
         ospRemoveGeometry(_primaryModel, geometry);
         ospRelease(geometry);
+        _geometryBuffers.erase(geometry);
     }
     geometry = ospNewGeometry(name);
+    _setMaterial(geometry, materialId);
+    return geometry;
+}
 
+void OSPRayModel::_setMaterial(OSPGeometry geometry, const size_t materialId)
+{
     auto matIt = _materials.find(materialId);
     if (matIt != _materials.end())
     {
@@ -162,16 +258,22 @@ OSPGeometry& OSPRayModel::_createGeometry(GeometryMap& map,
         if (material->getOSPMaterial())
             ospSetMaterial(geometry, material->getOSPMaterial());
     }
-
-    return geometry;
 }
 
-void OSPRayModel::_commitSpheres(const size_t materialId)
+template <typename T>
+OSPData OSPRayModel::_newData(const std::vector<T>& vec,
+                              const OSPDataType type) const
 {
-    auto& geometry = _createGeometry(_ospSpheres, materialId, "spheres");
+    const auto it = _stagedBuffers.find(vec.data());
+    if (it == _stagedBuffers.end())
+        return allocateVectorData(vec, type, _memoryManagementFlags);
+    return ospNewData(vec.size() * sizeof(T) / ospray::sizeOf(type), type,
+                      it->second, OSP_DATA_SHARED_BUFFER);
+}
 
-    auto data = allocateVectorData(_geometries->_spheres.at(materialId),
-                                   OSP_FLOAT, _memoryManagementFlags);
+void OSPRayModel::_commitSpheres(OSPGeometry geometry, const size_t materialId)
+{
+    auto data = _newData(_geometries->_spheres.at(materialId), OSP_FLOAT);
 
     ospSetObject(geometry, "spheres", data);
     ospRelease(data);
@@ -183,16 +285,12 @@ void OSPRayModel::_commitSpheres(const size_t materialId)
     osphelper::set(geometry, "bytes_per_sphere",
                    static_cast<int>(sizeof(Sphere)));
     ospCommit(geometry);
-
-    _addGeometryToModel(geometry, materialId);
 }
 
-void OSPRayModel::_commitCylinders(const size_t materialId)
+void OSPRayModel::_commitCylinders(OSPGeometry geometry,
+                                   const size_t materialId)
 {
-    auto& geometry = _createGeometry(_ospCylinders, materialId, "cylinders");
-
-    auto data = allocateVectorData(_geometries->_cylinders.at(materialId),
-                                   OSP_FLOAT, _memoryManagementFlags);
+    auto data = _newData(_geometries->_cylinders.at(materialId), OSP_FLOAT);
     ospSetObject(geometry, "cylinders", data);
     ospRelease(data);
 
@@ -205,107 +303,55 @@ void OSPRayModel::_commitCylinders(const size_t materialId)
     osphelper::set(geometry, "bytes_per_cylinder",
                    static_cast<int>(sizeof(Cylinder)));
     ospCommit(geometry);
-
-    _addGeometryToModel(geometry, materialId);
 }
 
-void OSPRayModel::_commitCones(const size_t materialId)
+void OSPRayModel::_commitCones(OSPGeometry geometry, const size_t materialId)
 {
-    auto& geometry = _createGeometry(_ospCones, materialId, "cones");
-    auto data = allocateVectorData(_geometries->_cones.at(materialId),
-                                   OSP_FLOAT, _memoryManagementFlags);
+    auto data = _newData(_geometries->_cones.at(materialId), OSP_FLOAT);
 
     ospSetObject(geometry, "cones", data);
     ospRelease(data);
 
     ospCommit(geometry);
-
-    _addGeometryToModel(geometry, materialId);
 }
 
-void OSPRayModel::_commitSDFBeziers(const size_t materialId)
+void OSPRayModel::_commitSDFBeziers(OSPGeometry geometry,
+                                    const size_t materialId)
 {
-    auto& geometry = _createGeometry(_ospSDFBeziers, materialId, "sdfbeziers");
-    auto data = allocateVectorData(_geometries->_sdfBeziers.at(materialId),
-                                   OSP_FLOAT, _memoryManagementFlags);
+    auto data = _newData(_geometries->_sdfBeziers.at(materialId), OSP_FLOAT);
 
     ospSetObject(geometry, "sdfbeziers", data);
     ospRelease(data);
 
     ospCommit(geometry);
-
-    _addGeometryToModel(geometry, materialId);
 }
 
-void OSPRayModel::_commitMeshes(const size_t materialId)
+void OSPRayModel::_commitMeshes(OSPGeometry geometry, const size_t materialId)
 {
-    auto& geometry = _createGeometry(_ospMeshes, materialId, "trianglemesh");
-    auto& triangleMesh = _geometries->_triangleMeshes.at(materialId);
-
-    OSPData vertices = allocateVectorData(triangleMesh.vertices, OSP_FLOAT3,
-                                          _memoryManagementFlags);
-    ospSetObject(geometry, "position", vertices);
-    ospRelease(vertices);
-
-    OSPData indices = allocateVectorData(triangleMesh.indices, OSP_INT3,
-                                         _memoryManagementFlags);
-    ospSetObject(geometry, "index", indices);
-    ospRelease(indices);
-
-    if (!triangleMesh.normals.empty())
-    {
-        OSPData normals = allocateVectorData(triangleMesh.normals, OSP_FLOAT3,
-                                             _memoryManagementFlags);
-        ospSetObject(geometry, "vertex.normal", normals);
-        ospRelease(normals);
-    }
-
-    if (!triangleMesh.colors.empty())
-    {
-        OSPData colors = allocateVectorData(triangleMesh.colors, OSP_FLOAT3A,
-                                            _memoryManagementFlags);
-        ospSetObject(geometry, "vertex.color", colors);
-        ospRelease(colors);
-    }
-
-    if (!triangleMesh.textureCoordinates.empty())
-    {
-        OSPData texCoords =
-            allocateVectorData(triangleMesh.textureCoordinates, OSP_FLOAT2,
-                               _memoryManagementFlags);
-        ospSetObject(geometry, "vertex.texcoord", texCoords);
-        ospRelease(texCoords);
-    }
-
-    osphelper::set(geometry, "alpha_type", 0);
-    osphelper::set(geometry, "alpha_component", 4);
-
+    setMeshData(geometry, _geometries->_triangleMeshes.at(materialId),
+                [this](const auto& vec, const OSPDataType type) {
+                    return _newData(vec, type);
+                });
     ospCommit(geometry);
-
-    ospAddGeometry(_primaryModel, geometry);
 }
 
-void OSPRayModel::_commitStreamlines(const size_t materialId)
+void OSPRayModel::_commitStreamlines(OSPGeometry geometry,
+                                     const size_t materialId)
 {
-    auto& geometry =
-        _createGeometry(_ospStreamlines, materialId, "streamlines");
-    auto& data = _geometries->_streamlines[materialId];
+    const auto& data = _geometries->_streamlines.at(materialId);
 
     {
-        OSPData vertex =
-            allocateVectorData(data.vertex, OSP_FLOAT4, _memoryManagementFlags);
+        OSPData vertex = _newData(data.vertex, OSP_FLOAT4);
         ospSetObject(geometry, "vertex", vertex);
         ospRelease(vertex);
     }
     {
-        OSPData vertexColor = allocateVectorData(data.vertexColor, OSP_FLOAT4,
-                                                 _memoryManagementFlags);
+        OSPData vertexColor = _newData(data.vertexColor, OSP_FLOAT4);
         ospSetObject(geometry, "vertex.color", vertexColor);
         ospRelease(vertexColor);
     }
     {
-        OSPData index =
-            allocateVectorData(data.indices, OSP_INT, _memoryManagementFlags);
+        OSPData index = _newData(data.indices, OSP_INT);
         ospSetObject(geometry, "index", index);
         ospRelease(index);
     }
@@ -314,8 +360,86 @@ void OSPRayModel::_commitStreamlines(const size_t materialId)
     osphelper::set(geometry, "smooth", true);
 
     ospCommit(geometry);
+}
 
-    ospAddGeometry(_primaryModel, geometry);
+void OSPRayModel::_commitGeometries(const std::vector<GeometryCommit>& commits)
+{
+    _stageBuffers(commits);
+
+    // The OSPRay API is not thread safe, all geometries are committed by the
+    // calling thread
+    for (const auto& commit : commits)
+    {
+        (this->*commit.commit)(commit.geometry, commit.materialId);
+        if (commit.primaryModelOnly)
+            ospAddGeometry(_primaryModel, commit.geometry);
+        else
+            _addGeometryToModel(commit.geometry, commit.materialId);
+    }
+    _stagedBuffers.clear();
+}
+
+void OSPRayModel::_stageBuffers(const std::vector<GeometryCommit>& commits)
+{
+    // Shared buffers are not copied at all
+    if (_isBufferShared())
+        return;
+
+    // The bounding box and secondary models keep the OSPRay copies, as their
+    // geometries are not detached when created again
+    std::vector<std::pair<const void*, size_t>> sources;
+    std::vector<OSPGeometry> owners;
+    for (const auto& commit : commits)
+    {
+        const auto id = commit.materialId;
+        if (id == BOUNDINGBOX_MATERIAL_ID || id == SECONDARY_MODEL_MATERIAL_ID)
+            continue;
+
+        const auto nbSources = sources.size();
+        if (commit.commit == &OSPRayModel::_commitSpheres)
+            addSource(sources, _geometries->_spheres.at(id));
+        else if (commit.commit == &OSPRayModel::_commitCylinders)
+            addSource(sources, _geometries->_cylinders.at(id));
+        else if (commit.commit == &OSPRayModel::_commitCones)
+            addSource(sources, _geometries->_cones.at(id));
+        else if (commit.commit == &OSPRayModel::_commitSDFBeziers)
+            addSource(sources, _geometries->_sdfBeziers.at(id));
+        else if (commit.commit == &OSPRayModel::_commitMeshes)
+        {
+            const auto& mesh = _geometries->_triangleMeshes.at(id);
+            addSource(sources, mesh.vertices);
+            addSource(sources, mesh.indices);
+            addSource(sources, mesh.normals);
+            addSource(sources, mesh.colors);
+            addSource(sources, mesh.textureCoordinates);
+        }
+        else if (commit.commit == &OSPRayModel::_commitStreamlines)
+        {
+            const auto& streamlines = _geometries->_streamlines.at(id);
+            addSource(sources, streamlines.vertex);
+            addSource(sources, streamlines.vertexColor);
+            addSource(sources, streamlines.indices);
+        }
+        owners.resize(sources.size(), commit.geometry);
+        _geometryBuffers[commit.geometry] =
+            std::vector<HostBuffer>(sources.size() - nbSources);
+    }
+
+    std::vector<char*> copies(sources.size());
+    std::map<OSPGeometry, size_t> nbCopies;
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        auto& buffer = _geometryBuffers[owners[i]][nbCopies[owners[i]]++];
+        buffer.reset(new char[sources[i].second]);
+        copies[i] = buffer.get();
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < int64_t(sources.size()); ++i)
+        std::memcpy(copies[i], sources[i].first, sources[i].second);
+
+    for (size_t i = 0; i < sources.size(); ++i)
+        _stagedBuffers[sources[i].first] = copies[i];
 }
 
 void OSPRayModel::_commitSDFGeometries()
@@ -348,6 +472,7 @@ void OSPRayModel::_commitSDFGeometries()
     auto neighbourData = allocateVectorData(_geometries->_sdf.neighboursFlat,
                                             OSP_ULONG, _memoryManagementFlags);
 
+    std::vector<std::pair<size_t, OSPGeometry>> geometries;
     for (const auto& mat : _materials)
     {
         const size_t materialId = mat.first;
@@ -356,12 +481,17 @@ void OSPRayModel::_commitSDFGeometries()
             _geometries->_sdf.geometryIndices.end())
             continue;
 
-        auto& geometry =
-            _createGeometry(_ospSDFGeometries, materialId, "sdfgeometries");
+        geometries.emplace_back(materialId,
+                                _createGeometry(_ospSDFGeometries, materialId,
+                                                "sdfgeometries"));
+    }
 
-        auto data =
-            allocateVectorData(_geometries->_sdf.geometryIndices[materialId],
-                               OSP_ULONG, _memoryManagementFlags);
+    for (const auto& entry : geometries)
+    {
+        auto geometry = entry.second;
+        auto data = allocateVectorData(
+            _geometries->_sdf.geometryIndices.at(entry.first), OSP_ULONG,
+            _memoryManagementFlags);
         ospSetObject(geometry, "sdfgeometries", data);
         ospRelease(data);
 
@@ -369,7 +499,6 @@ void OSPRayModel::_commitSDFGeometries()
         ospSetData(geometry, "geometries", globalData);
 
         ospCommit(geometry);
-
         ospAddGeometry(_primaryModel, geometry);
     }
 
@@ -377,13 +506,420 @@ void OSPRayModel::_commitSDFGeometries()
     ospRelease(neighbourData);
 }
 
-void OSPRayModel::_setBVHFlags()
+bool OSPRayModel::_isInMaterialTable(const size_t materialId) const
+{
+    return _materialTable && materialId != BOUNDINGBOX_MATERIAL_ID &&
+           materialId != SECONDARY_MODEL_MATERIAL_ID;
+}
+
+int32_t OSPRayModel::_getMaterialIndex(const size_t materialId) const
+{
+    // Unknown materials point to the last, empty, entry of the table
+    const auto it = _materialIndices.find(materialId);
+    if (it == _materialIndices.end())
+        return static_cast<int32_t>(_materialIndices.size());
+    return it->second;
+}
+
+void OSPRayModel::_releaseIndexedGeometry(OSPGeometry& geometry)
+{
+    if (!geometry)
+        return;
+    ospRemoveGeometry(_primaryModel, geometry);
+    ospRelease(geometry);
+    geometry = nullptr;
+}
+
+bool OSPRayModel::_isBufferShared() const
+{
+    return _memoryManagementFlags & OSP_DATA_SHARED_BUFFER;
+}
+
+template <typename T>
+size_t OSPRayModel::_getIndexedSources(
+    const std::map<size_t, T>& primitives,
+    std::vector<IndexedSource<T>>& sources) const
+{
+    size_t size = 0;
+    for (const auto& entry : primitives)
+    {
+        if (!_isInMaterialTable(entry.first))
+            continue;
+        sources.push_back(
+            {&entry.second, size, _getMaterialIndex(entry.first)});
+        size += primitiveCount(entry.second);
+    }
+    return size;
+}
+
+OSPGeometry OSPRayModel::_createIndexedGeometry(OSPGeometry& geometry,
+                                                const char* name)
 {
-    osphelper::set(_primaryModel, "dynamicScene",
+    _releaseIndexedGeometry(geometry);
+    geometry = ospNewGeometry(name);
+    if (_ospMaterialTable)
+        ospSetData(geometry, "materialList", _ospMaterialTable);
+    return geometry;
+}
+
+void OSPRayModel::_commitMaterialTable()
+{
+    _materialIndices.clear();
+    std::vector<OSPMaterial> materials;
+    materials.reserve(_materials.size() + 1);
+    for (const auto& kv : _materials)
+    {
+        if (!_isInMaterialTable(kv.first))
+            continue;
+        _materialIndices[kv.first] = static_cast<int32_t>(materials.size());
+        const auto& material = static_cast<OSPRayMaterial&>(*kv.second);
+        materials.push_back(material.getOSPMaterial());
+    }
+    materials.push_back(nullptr);
+
+    ospRelease(_ospMaterialTable);
+    _ospMaterialTable =
+        ospNewData(materials.size(), OSP_OBJECT, materials.data());
+    ospCommit(_ospMaterialTable);
+
+    for (auto geometry : {_ospIndexedSpheres, _ospIndexedCylinders,
+                          _ospIndexedCones, _ospIndexedMeshes})
+    {
+        if (!geometry)
+            continue;
+        ospSetData(geometry, "materialList", _ospMaterialTable);
+        ospCommit(geometry);
+    }
+}
+
+void OSPRayModel::_commitIndexedSpheres()
+{
+    // The spheres of all materials are packed in parallel at the offsets
+    // computed beforehand
+    std::vector<IndexedSource<Spheres>> sources;
+    const auto size = _getIndexedSources(_geometries->_spheres, sources);
+    _indexedSpheres.clear();
+    _indexedSpheres.resize(size);
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(sources.size()); ++i)
+    {
+        auto out = _indexedSpheres.begin() + sources[i].offset;
+        for (const auto& sphere : *sources[i].data)
+            *out++ = {sphere, sources[i].materialIndex};
+    }
+    if (_indexedSpheres.empty())
+    {
+        _releaseIndexedGeometry(_ospIndexedSpheres);
+        return;
+    }
+
+    auto geometry = _createIndexedGeometry(_ospIndexedSpheres, "spheres");
+    auto data =
+        allocateVectorData(_indexedSpheres, OSP_FLOAT, _memoryManagementFlags);
+    ospSetObject(geometry, "spheres", data);
+    ospRelease(data);
+
+    osphelper::set(geometry, "offset_center",
+                   static_cast<int>(offsetof(Sphere, center)));
+    osphelper::set(geometry, "offset_radius",
+                   static_cast<int>(offsetof(Sphere, radius)));
+    osphelper::set(geometry, "offset_materialID",
+                   static_cast<int>(offsetof(IndexedSphere, materialIndex)));
+    osphelper::set(geometry, "bytes_per_sphere",
+                   static_cast<int>(sizeof(IndexedSphere)));
+    ospCommit(geometry);
+
+    ospAddGeometry(_primaryModel, geometry);
+
+    // OSPRay keeps its own copy unless the buffer is shared
+    if (!_isBufferShared())
+        freeVector(_indexedSpheres);
+}
+
+void OSPRayModel::_commitIndexedCylinders()
+{
+    std::vector<IndexedSource<Cylinders>> sources;
+    const auto size = _getIndexedSources(_geometries->_cylinders, sources);
+    _indexedCylinders.clear();
+    _indexedCylinders.resize(size);
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(sources.size()); ++i)
+    {
+        auto out = _indexedCylinders.begin() + sources[i].offset;
+        for (const auto& cylinder : *sources[i].data)
+            *out++ = {cylinder, sources[i].materialIndex};
+    }
+    if (_indexedCylinders.empty())
+    {
+        _releaseIndexedGeometry(_ospIndexedCylinders);
+        return;
+    }
+
+    auto geometry = _createIndexedGeometry(_ospIndexedCylinders, "cylinders");
+    auto data = allocateVectorData(_indexedCylinders, OSP_FLOAT,
+                                   _memoryManagementFlags);
+    ospSetObject(geometry, "cylinders", data);
+    ospRelease(data);
+
+    osphelper::set(geometry, "offset_v0",
+                   static_cast<int>(offsetof(Cylinder, center)));
+    osphelper::set(geometry, "offset_v1",
+                   static_cast<int>(offsetof(Cylinder, up)));
+    osphelper::set(geometry, "offset_radius",
+                   static_cast<int>(offsetof(Cylinder, radius)));
+    osphelper::set(geometry, "offset_materialID",
+                   static_cast<int>(offsetof(IndexedCylinder, materialIndex)));
+    osphelper::set(geometry, "bytes_per_cylinder",
+                   static_cast<int>(sizeof(IndexedCylinder)));
+    ospCommit(geometry);
+
+    ospAddGeometry(_primaryModel, geometry);
+
+    if (!_isBufferShared())
+        freeVector(_indexedCylinders);
+}
+
+void OSPRayModel::_commitIndexedCones()
+{
+    std::vector<IndexedSource<Cones>> sources;
+    const auto size = _getIndexedSources(_geometries->_cones, sources);
+    _indexedCones.clear();
+    _indexedCones.resize(size);
+    _indexedConeMaterials.clear();
+    _indexedConeMaterials.resize(size);
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(sources.size()); ++i)
+    {
+        const auto& cones = *sources[i].data;
+        const auto offset = sources[i].offset;
+        std::copy(cones.begin(), cones.end(), _indexedCones.begin() + offset);
+        std::fill_n(_indexedConeMaterials.begin() + offset, cones.size(),
+                    sources[i].materialIndex);
+    }
+    if (_indexedCones.empty())
+    {
+        _releaseIndexedGeometry(_ospIndexedCones);
+        return;
+    }
+
+    auto geometry = _createIndexedGeometry(_ospIndexedCones, "cones");
+    auto data =
+        allocateVectorData(_indexedCones, OSP_FLOAT, _memoryManagementFlags);
+    ospSetObject(geometry, "cones", data);
+    ospRelease(data);
+
+    auto materials = allocateVectorData(_indexedConeMaterials, OSP_INT,
+                                        _memoryManagementFlags);
+    ospSetObject(geometry, "prim.materialID", materials);
+    ospRelease(materials);
+
+    ospCommit(geometry);
+
+    ospAddGeometry(_primaryModel, geometry);
+
+    if (!_isBufferShared())
+    {
+        freeVector(_indexedCones);
+        freeVector(_indexedConeMaterials);
+    }
+}
+
+void OSPRayModel::_commitIndexedMeshes()
+{
+    auto& mesh = _indexedMesh;
+    mesh = TriangleMesh();
+    _indexedMeshMaterials.clear();
+
+    std::vector<IndexedSource<TriangleMesh>> sources;
+    const auto nbIndices =
+        _getIndexedSources(_geometries->_triangleMeshes, sources);
+
+    // Normals are only kept if all meshes provide them, missing colors and
+    // texture coordinates are padded with neutral values.
+    bool hasNormals = true;
+    bool hasColors = false;
+    bool hasTextureCoordinates = false;
+    std::vector<size_t> vertexOffsets;
+    size_t nbVertices = 0;
+    for (const auto& source : sources)
+    {
+        const auto& triangleMesh = *source.data;
+        hasNormals = hasNormals && !triangleMesh.normals.empty();
+        hasColors = hasColors || !triangleMesh.colors.empty();
+        hasTextureCoordinates = hasTextureCoordinates ||
+                                !triangleMesh.textureCoordinates.empty();
+        vertexOffsets.push_back(nbVertices);
+        nbVertices += triangleMesh.vertices.size();
+    }
+
+    mesh.vertices.resize(nbVertices);
+    mesh.indices.resize(nbIndices);
+    _indexedMeshMaterials.resize(nbIndices);
+    if (hasNormals)
+        mesh.normals.resize(nbVertices);
+    if (hasColors)
+        mesh.colors.resize(nbVertices, Vector4f(1.f));
+    if (hasTextureCoordinates)
+        mesh.textureCoordinates.resize(nbVertices, Vector2f(0.f));
+
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(sources.size()); ++i)
+    {
+        const auto& triangleMesh = *sources[i].data;
+        const auto vertexOffset = vertexOffsets[i];
+        const auto indexOffset = sources[i].offset;
+        const auto offset = Vector3ui(static_cast<uint32_t>(vertexOffset));
+
+        std::copy(triangleMesh.vertices.begin(), triangleMesh.vertices.end(),
+                  mesh.vertices.begin() + vertexOffset);
+        std::transform(triangleMesh.indices.begin(),
+                       triangleMesh.indices.end(),
+                       mesh.indices.begin() + indexOffset,
+                       [offset](const Vector3ui& index) {
+                           return index + offset;
+                       });
+        std::fill_n(_indexedMeshMaterials.begin() + indexOffset,
+                    triangleMesh.indices.size(), sources[i].materialIndex);
+
+        if (hasNormals)
+            std::copy(triangleMesh.normals.begin(), triangleMesh.normals.end(),
+                      mesh.normals.begin() + vertexOffset);
+        if (hasColors)
+            std::copy(triangleMesh.colors.begin(), triangleMesh.colors.end(),
+                      mesh.colors.begin() + vertexOffset);
+        if (hasTextureCoordinates)
+            std::copy(triangleMesh.textureCoordinates.begin(),
+                      triangleMesh.textureCoordinates.end(),
+                      mesh.textureCoordinates.begin() + vertexOffset);
+    }
+    if (mesh.indices.empty())
+    {
+        _releaseIndexedGeometry(_ospIndexedMeshes);
+        return;
+    }
+
+    auto geometry = _createIndexedGeometry(_ospIndexedMeshes, "trianglemesh");
+    setMeshData(geometry, mesh, _memoryManagementFlags);
+
+    OSPData materials = allocateVectorData(_indexedMeshMaterials, OSP_INT,
+                                           _memoryManagementFlags);
+    ospSetObject(geometry, "prim.materialID", materials);
+    ospRelease(materials);
+
+    ospCommit(geometry);
+
+    ospAddGeometry(_primaryModel, geometry);
+
+    if (!_isBufferShared())
+    {
+        mesh = TriangleMesh();
+        freeVector(_indexedMeshMaterials);
+    }
+}
+
+void OSPRayModel::_commitLODs()
+{
+    // The coarser models share all other geometries of the primary model,
+    // which are created again when modified
+    if (!_areGeometriesDirty())
+        return;
+
+    if (_isDirty(_triangleMeshesDirty, _dirtyTriangleMeshMaterials))
+    {
+        for (auto& geometries : _ospMeshLODs)
+            for (auto geometry : geometries)
+                ospRelease(geometry.second);
+        _ospMeshLODs.clear();
+        for (auto geometry : _ospMeshLODBase)
+            ospRelease(geometry.second);
+        _ospMeshLODBase.clear();
+
+        for (const auto& meshes : _geometries->_triangleMeshLODs)
+        {
+            GeometryMap geometries;
+            for (const auto& mesh : meshes)
+            {
+                auto geometry = ospNewGeometry("trianglemesh");
+                _setMaterial(geometry, mesh.first);
+                setMeshData(geometry, mesh.second, _memoryManagementFlags);
+                ospCommit(geometry);
+                geometries[mesh.first] = geometry;
+            }
+            _ospMeshLODs.push_back(geometries);
+        }
+    }
+
+    for (auto model : _lodModels)
+        ospRelease(model);
+    _lodModels.clear();
+
+    for (size_t level = 1; level <= _ospMeshLODs.size(); ++level)
+    {
+        auto model = ospNewModel();
+        for (const auto& map : {_ospSpheres, _ospCylinders, _ospCones,
+                                _ospSDFBeziers, _ospStreamlines,
+                                _ospSDFGeometries})
+            for (const auto& geometry : map)
+                if (geometry.first != BOUNDINGBOX_MATERIAL_ID &&
+                    geometry.first != SECONDARY_MODEL_MATERIAL_ID)
+                    ospAddGeometry(model, geometry.second);
+        for (auto geometry :
+             {_ospIndexedSpheres, _ospIndexedCylinders, _ospIndexedCones})
+            if (geometry)
+                ospAddGeometry(model, geometry);
+        for (const auto& mesh : _geometries->_triangleMeshes)
+        {
+            if (mesh.first == BOUNDINGBOX_MATERIAL_ID ||
+                mesh.first == SECONDARY_MODEL_MATERIAL_ID)
+                continue;
+            auto geometry = _getLODMesh(level, mesh.first);
+            if (geometry)
+                ospAddGeometry(model, geometry);
+        }
+
+        _setBVHFlags(model);
+        ospCommit(model);
+        _lodModels.push_back(model);
+    }
+}
+
+OSPGeometry OSPRayModel::_getLODMesh(const size_t level,
+                                     const size_t materialId)
+{
+    // A material missing from a level uses the geometry of its previous level
+    for (size_t i = level; i > 0; --i)
+    {
+        const auto& geometries = _ospMeshLODs[i - 1];
+        const auto it = geometries.find(materialId);
+        if (it != geometries.end())
+            return it->second;
+    }
+
+    if (!_isInMaterialTable(materialId))
+    {
+        const auto it = _ospMeshes.find(materialId);
+        return it == _ospMeshes.end() ? nullptr : it->second;
+    }
+
+    auto& geometry = _ospMeshLODBase[materialId];
+    if (!geometry)
+    {
+        geometry = ospNewGeometry("trianglemesh");
+        _setMaterial(geometry, materialId);
+        setMeshData(geometry, _geometries->_triangleMeshes.at(materialId),
+                    _memoryManagementFlags);
+        ospCommit(geometry);
+    }
+    return geometry;
+}
+
+void OSPRayModel::_setBVHFlags(OSPModel model)
+{
+    osphelper::set(model, "dynamicScene",
                    static_cast<int>(_bvhFlags.count(BVHFlag::dynamic)));
-    osphelper::set(_primaryModel, "compactMode",
+    osphelper::set(model, "compactMode",
                    static_cast<int>(_bvhFlags.count(BVHFlag::compact)));
-    osphelper::set(_primaryModel, "robustMode",
+    osphelper::set(model, "robustMode",
                    static_cast<int>(_bvhFlags.count(BVHFlag::robust)));
 }
 
@@ -405,49 +941,92 @@ void OSPRayModel::commitGeometry()
     for (auto material : _materials)
         material.second->commit();
 
-    // Group geometry
-    if (_spheresDirty)
+    if (_materialTable)
+        _commitMaterialTable();
+
+    // Group geometry; only the geometries of the modified materials are
+    // created again, the indexed ones hold all materials
+    std::vector<GeometryCommit> commits;
+    if (_isDirty(_spheresDirty, _dirtySphereMaterials))
     {
+        if (_materialTable)
+            _commitIndexedSpheres();
         for (const auto& spheres : _geometries->_spheres)
-            _commitSpheres(spheres.first);
+            if (!_isInMaterialTable(spheres.first) &&
+                _isDirty(_spheresDirty, _dirtySphereMaterials, spheres.first))
+                commits.push_back(
+                    {_createGeometry(_ospSpheres, spheres.first, "spheres"),
+                     spheres.first, &OSPRayModel::_commitSpheres, false});
     }
 
-    if (_cylindersDirty)
+    if (_isDirty(_cylindersDirty, _dirtyCylinderMaterials))
     {
+        if (_materialTable)
+            _commitIndexedCylinders();
         for (const auto& cylinders : _geometries->_cylinders)
-            _commitCylinders(cylinders.first);
+            if (!_isInMaterialTable(cylinders.first) &&
+                _isDirty(_cylindersDirty, _dirtyCylinderMaterials,
+                         cylinders.first))
+                commits.push_back({_createGeometry(_ospCylinders,
+                                                   cylinders.first,
+                                                   "cylinders"),
+                                   cylinders.first,
+                                   &OSPRayModel::_commitCylinders, false});
     }
 
-    if (_conesDirty)
+    if (_isDirty(_conesDirty, _dirtyConeMaterials))
     {
+        if (_materialTable)
+            _commitIndexedCones();
         for (const auto& cones : _geometries->_cones)
-            _commitCones(cones.first);
+            if (!_isInMaterialTable(cones.first) &&
+                _isDirty(_conesDirty, _dirtyConeMaterials, cones.first))
+                commits.push_back(
+                    {_createGeometry(_ospCones, cones.first, "cones"),
+                     cones.first, &OSPRayModel::_commitCones, false});
     }
 
-    if (_sdfBeziersDirty)
-    {
-        for (const auto& sdfBeziers : _geometries->_sdfBeziers)
-            _commitSDFBeziers(sdfBeziers.first);
-    }
+    for (const auto& sdfBeziers : _geometries->_sdfBeziers)
+        if (_isDirty(_sdfBeziersDirty, _dirtySDFBezierMaterials,
+                     sdfBeziers.first))
+            commits.push_back({_createGeometry(_ospSDFBeziers,
+                                               sdfBeziers.first, "sdfbeziers"),
+                               sdfBeziers.first,
+                               &OSPRayModel::_commitSDFBeziers, false});
 
-    if (_triangleMeshesDirty)
+    if (_isDirty(_triangleMeshesDirty, _dirtyTriangleMeshMaterials))
     {
+        if (_materialTable)
+            _commitIndexedMeshes();
         for (const auto& meshes : _geometries->_triangleMeshes)
-            _commitMeshes(meshes.first);
+            if (!_isInMaterialTable(meshes.first) &&
+                _isDirty(_triangleMeshesDirty, _dirtyTriangleMeshMaterials,
+                         meshes.first))
+                commits.push_back({_createGeometry(_ospMeshes, meshes.first,
+                                                   "trianglemesh"),
+                                   meshes.first, &OSPRayModel::_commitMeshes,
+                                   true});
     }
 
-    if (_streamlinesDirty)
-    {
-        for (const auto& streamlines : _geometries->_streamlines)
-            _commitStreamlines(streamlines.first);
-    }
+    for (const auto& streamlines : _geometries->_streamlines)
+        if (_isDirty(_streamlinesDirty, _dirtyStreamlineMaterials,
+                     streamlines.first))
+            commits.push_back({_createGeometry(_ospStreamlines,
+                                               streamlines.first,
+                                               "streamlines"),
+                               streamlines.first,
+                               &OSPRayModel::_commitStreamlines, true});
+
+    _commitGeometries(commits);
 
     if (_sdfGeometriesDirty)
         _commitSDFGeometries();
 
+    _commitLODs();
+
     updateBounds();
     _markGeometriesClean();
-    _setBVHFlags();
+    _setBVHFlags(_primaryModel);
 
     // handled by the scene
     _instancesDirty = false;
@@ -465,7 +1044,15 @@ void OSPRayModel::commitMaterials(const std::string& renderer)
     if (renderer.empty())
         throw std::runtime_error(
             "Materials cannot be instanced with an empty renderer name");
-    if (_renderer != renderer)
+    if (_renderer == renderer)
+    {
+        // Commit materials that were modified since the last frame, e.g. by
+        // bulk updates, in one pass on the render thread. Unmodified
+        // materials are skipped by commit().
+        for (auto kv : _materials)
+            kv.second->commit();
+    }
+    else
     {
         for (auto kv : _materials)
         {
@@ -497,6 +1084,22 @@ void OSPRayModel::commitMaterials(const std::string& renderer)
                 ++geomIt;
             }
         }
+
+        for (const auto& geometries : _ospMeshLODs)
+            for (const auto& geometry : geometries)
+            {
+                _setMaterial(geometry.second, geometry.first);
+                ospCommit(geometry.second);
+            }
+        for (const auto& geometry : _ospMeshLODBase)
+        {
+            _setMaterial(geometry.second, geometry.first);
+            ospCommit(geometry.second);
+        }
+
+        // The material objects were recreated for the new renderer
+        if (_materialTable)
+            _commitMaterialTable();
     }
 }
 
@@ -523,6 +1126,15 @@ BrickedVolumePtr OSPRayModel::createBrickedVolume(const Vector3ui& dimensions,
                                                  _ospTransferFunction);
 }
 
+PagedVolumePtr OSPRayModel::createPagedVolume(const Vector3ui& dimensions,
+                                              const Vector3f& spacing,
+                                              const DataType type) const
+{
+    return std::make_shared<OSPRayPagedVolume>(dimensions, spacing, type,
+                                               _volumeParameters,
+                                               _ospTransferFunction);
+}
+
 void OSPRayModel::_commitTransferFunctionImpl(const Vector3fs& colors,
                                               const floats& opacities,
                                               const Vector2d valueRange)
@@ -547,9 +1159,43 @@ void OSPRayModel::_commitTransferFunctionImpl(const Vector3fs& colors,
 void OSPRayModel::_commitSimulationDataImpl(const float* frameData,
                                             const size_t frameSize)
 {
-    ospRelease(_ospSimulationData);
-    _ospSimulationData =
-        ospNewData(frameSize, OSP_FLOAT, frameData, _memoryManagementFlags);
-    ospCommit(_ospSimulationData);
+    _uploadSimulationData(frameData, frameSize, OSP_FLOAT,
+                          frameSize * sizeof(float));
+    _simulationDataEncoding = SimulationDataEncoding::float32;
+}
+
+bool OSPRayModel::_commitEncodedSimulationDataImpl(
+    const void* frameData, const size_t frameSize,
+    const SimulationDataEncoding encoding, const Vector2d& /*valueRange*/)
+{
+    // The renderers decode the bytes according to the encoding
+    const auto numBytes =
+        frameSize * AbstractSimulationHandler::getBytesPerValue(encoding);
+    _uploadSimulationData(frameData, numBytes, OSP_UCHAR, numBytes);
+    _simulationDataEncoding = encoding;
+    return true;
+}
+
+void OSPRayModel::_uploadSimulationData(const void* data,
+                                        const size_t numItems,
+                                        const OSPDataType type,
+                                        const size_t numBytes)
+{
+    // The data object is only recreated when the frame layout changes
+    auto& buffer = _simulationBuffers[1 - _frontSimulationBuffer];
+    if (!buffer.ospData || buffer.type != type ||
+        buffer.data.size() != numBytes)
+    {
+        ospRelease(buffer.ospData);
+        buffer.data = std::vector<uint8_t>(numBytes);
+        buffer.type = type;
+        buffer.ospData = ospNewData(numItems, type, buffer.data.data(),
+                                    OSP_DATA_SHARED_BUFFER);
+    }
+    memcpy(buffer.data.data(), data, numBytes);
+    ospCommit(buffer.ospData);
+
+    _frontSimulationBuffer = 1 - _frontSimulationBuffer;
+    _ospSimulationData = buffer.ospData;
 }
 } // namespace brayns
@@ -24,6 +24,9 @@
 
 #include <ospray.h>
 
+#include <array>
+#include <memory>
+
 namespace brayns
 {
 class OSPRayModel : public Model
@@ -41,16 +44,47 @@ public:
     OSPModel getPrimaryModel() const { return _primaryModel; }
     OSPModel getSecondaryModel() const { return _secondaryModel; }
     OSPModel getBoundingBoxModel() const { return _boundingBoxModel; }
+
+    /** @return the sphere geometry of a material, nullptr if there is none */
+    OSPGeometry getSpheresGeometry(const size_t materialId) const
+    {
+        const auto it = _ospSpheres.find(materialId);
+        return it == _ospSpheres.end() ? nullptr : it->second;
+    }
+
+    /**
+     * @return the model using the meshes of the given level of detail, the
+     *         primary model for level 0 or if there are no coarser levels
+     */
+    OSPModel getLODModel(const size_t level) const
+    {
+        if (level == 0 || level > _lodModels.size())
+            return _primaryModel;
+        return _lodModels[level - 1];
+    }
     SharedDataVolumePtr createSharedDataVolume(const Vector3ui& dimensions,
                                                const Vector3f& spacing,
                                                const DataType type) const final;
     BrickedVolumePtr createBrickedVolume(const Vector3ui& dimensions,
                                          const Vector3f& spacing,
                                          const DataType type) const final;
+    PagedVolumePtr createPagedVolume(const Vector3ui& dimensions,
+                                     const Vector3f& spacing,
+                                     const DataType type) const final;
 
     void buildBoundingBox() final;
 
     OSPData simulationData() const { return _ospSimulationData; }
+    /** @return the encoding of simulationData(). */
+    SimulationDataEncoding simulationDataEncoding() const
+    {
+        return _simulationDataEncoding;
+    }
+    /** @return the value range the integer simulation data maps to. */
+    const Vector2d& simulationDataRange() const
+    {
+        return _simulationDataRange;
+    }
     OSPTransferFunction transferFunction() const
     {
         return _ospTransferFunction;
@@ -62,33 +96,87 @@ protected:
                                      const Vector2d valueRange) final;
     void _commitSimulationDataImpl(const float* frameData,
                                    const size_t frameSize) final;
+    bool _commitEncodedSimulationDataImpl(
+        const void* frameData, const size_t frameSize,
+        const SimulationDataEncoding encoding,
+        const Vector2d& valueRange) final;
 
 private:
     using GeometryMap = std::map<size_t, OSPGeometry>;
 
     OSPGeometry& _createGeometry(GeometryMap& map, size_t materialID,
                                  const char* name);
-    void _commitSpheres(const size_t materialId);
-    void _commitCylinders(const size_t materialId);
-    void _commitCones(const size_t materialId);
-    void _commitSDFBeziers(const size_t materialId);
-    void _commitMeshes(const size_t materialId);
-    void _commitStreamlines(const size_t materialId);
+    void _setMaterial(OSPGeometry geometry, const size_t materialId);
+    void _commitSpheres(OSPGeometry geometry, const size_t materialId);
+    void _commitCylinders(OSPGeometry geometry, const size_t materialId);
+    void _commitCones(OSPGeometry geometry, const size_t materialId);
+    void _commitSDFBeziers(OSPGeometry geometry, const size_t materialId);
+    void _commitMeshes(OSPGeometry geometry, const size_t materialId);
+    void _commitStreamlines(OSPGeometry geometry, const size_t materialId);
     void _commitSDFGeometries();
+
+    /** A created geometry, which data are set by the commit function */
+    struct GeometryCommit
+    {
+        OSPGeometry geometry;
+        size_t materialId;
+        void (OSPRayModel::*commit)(OSPGeometry, size_t);
+        bool primaryModelOnly;
+    };
+    void _commitGeometries(const std::vector<GeometryCommit>& commits);
+    void _stageBuffers(const std::vector<GeometryCommit>& commits);
+    template <typename T>
+    OSPData _newData(const std::vector<T>& vec, OSPDataType type) const;
     void _addGeometryToModel(const OSPGeometry geometry,
                              const size_t materialId);
-    void _setBVHFlags();
+    void _commitLODs();
+    OSPGeometry _getLODMesh(size_t level, size_t materialId);
+    void _uploadSimulationData(const void* data, size_t numItems,
+                               OSPDataType type, size_t numBytes);
+    void _setBVHFlags(OSPModel model);
+
+    // Material table mode
+    bool _isInMaterialTable(const size_t materialId) const;
+    int32_t _getMaterialIndex(const size_t materialId) const;
+    OSPGeometry _createIndexedGeometry(OSPGeometry& geometry,
+                                       const char* name);
+    void _releaseIndexedGeometry(OSPGeometry& geometry);
+    bool _isBufferShared() const;
+    void _commitMaterialTable();
+    void _commitIndexedSpheres();
+    void _commitIndexedCylinders();
+    void _commitIndexedCones();
+    void _commitIndexedMeshes();
 
     // Models
     OSPModel _primaryModel{nullptr};
     OSPModel _secondaryModel{nullptr};
     OSPModel _boundingBoxModel{nullptr};
 
+    // Levels of detail: the coarser meshes and one model per level. The base
+    // meshes are those of level 0 in material table mode, where the primary
+    // model only holds the indexed mesh.
+    std::vector<GeometryMap> _ospMeshLODs;
+    GeometryMap _ospMeshLODBase;
+    std::vector<OSPModel> _lodModels;
+
     // Bounding box
     size_t _boudingBoxMaterialId{0};
 
-    // Simulation model
+    // Simulation model: frames are copied alternately in two persistent
+    // buffers, the renderer keeps reading the front one until it is committed
+    // with the other one
+    struct SimulationBuffer
+    {
+        std::vector<uint8_t> data;
+        OSPDataType type{OSP_UNKNOWN};
+        OSPData ospData{nullptr};
+    };
+    std::array<SimulationBuffer, 2> _simulationBuffers;
+    size_t _frontSimulationBuffer{0};
     OSPData _ospSimulationData{nullptr};
+    SimulationDataEncoding _simulationDataEncoding{
+        SimulationDataEncoding::float32};
 
     OSPTransferFunction _ospTransferFunction{nullptr};
 
@@ -101,8 +189,57 @@ private:
     std::map<size_t, OSPGeometry> _ospStreamlines;
     std::map<size_t, OSPGeometry> _ospSDFGeometries;
 
+    // Material table: one geometry per primitive type, each primitive indexing
+    // the shared list of materials. Bounding box and secondary model materials
+    // keep their own geometries.
+    struct IndexedSphere
+    {
+        Sphere sphere;
+        int32_t materialIndex;
+    };
+    struct IndexedCylinder
+    {
+        Cylinder cylinder;
+        int32_t materialIndex;
+    };
+
+    /** The primitives of one material and their position in the table */
+    template <typename T>
+    struct IndexedSource
+    {
+        const T* data;
+        size_t offset;
+        int32_t materialIndex;
+    };
+    template <typename T>
+    size_t _getIndexedSources(const std::map<size_t, T>& primitives,
+                              std::vector<IndexedSource<T>>& sources) const;
+
+    OSPData _ospMaterialTable{nullptr};
+    std::map<size_t, int32_t> _materialIndices;
+
+    std::vector<IndexedSphere> _indexedSpheres;
+    std::vector<IndexedCylinder> _indexedCylinders;
+    Cones _indexedCones;
+    ints _indexedConeMaterials;
+    TriangleMesh _indexedMesh;
+    ints _indexedMeshMaterials;
+
+    OSPGeometry _ospIndexedSpheres{nullptr};
+    OSPGeometry _ospIndexedCylinders{nullptr};
+    OSPGeometry _ospIndexedCones{nullptr};
+    OSPGeometry _ospIndexedMeshes{nullptr};
+
     size_t _memoryManagementFlags{OSP_DATA_SHARED_BUFFER};
 
+    // Replicated memory mode: the data of the per-material geometries are
+    // copied on all threads before the serial OSPRay calls, which share these
+    // copies instead of copying again. The copies live as long as their
+    // geometry.
+    using HostBuffer = std::unique_ptr<char[]>;
+    std::map<OSPGeometry, std::vector<HostBuffer>> _geometryBuffers;
+    std::map<const void*, const char*> _stagedBuffers;
+
     std::string _renderer;
 
     MaterialPtr createMaterialImpl(const PropertyMap& properties = {}) final;
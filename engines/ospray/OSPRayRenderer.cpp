@@ -99,6 +99,10 @@ void OSPRayRenderer::commit()
             ospSetObject(_renderer, "secondaryModel",
                          model.getSecondaryModel());
             ospSetData(_renderer, "simulationData", model.simulationData());
+            osphelper::set(_renderer, "simulationDataEncoding",
+                           static_cast<int>(model.simulationDataEncoding()));
+            osphelper::set(_renderer, "simulationDataRange",
+                           Vector2f(model.simulationDataRange()));
             ospSetObject(_renderer, "transferFunction",
                          model.transferFunction());
         }
@@ -115,12 +119,15 @@ void OSPRayRenderer::commit()
             planes.push_back(clipPlane->getPlane());
 
         setClipPlanes(planes);
+        osphelper::set(_renderer, "clipRayIntervals",
+                       scene->isClippedByPlanes());
 
         _camera->setClipPlanes(planes);
         _camera->commit();
     }
 
-    osphelper::set(_renderer, "timestamp", static_cast<float>(ap.getFrame()));
+    osphelper::set(_renderer, "timestamp",
+                   static_cast<float>(ap.getFramePosition()));
     osphelper::set(_renderer, "randomNumber", rand() % 10000);
     osphelper::set(_renderer, "bgColor", Vector3f(rp.getBackgroundColor()));
     osphelper::set(_renderer, "varianceThreshold",
@@ -28,6 +28,7 @@
 #include <brayns/common/Transformation.h>
 #include <brayns/common/light/Light.h>
 #include <brayns/common/log.h>
+#include <brayns/common/scene/ClipPlane.h>
 #include <brayns/engine/Model.h>
 
 #include <brayns/parameters/GeometryParameters.h>
@@ -35,6 +36,34 @@
 
 namespace brayns
 {
+namespace
+{
+// Triangles per pixel of projected size squared above which a coarser level
+// of detail is used
+constexpr double LOD_TRIANGLES_PER_PIXEL = 1.0;
+
+size_t selectLOD(const std::vector<size_t>& nbTriangles, const Boxd& bounds,
+                 const Vector3d& position, const double focalLength)
+{
+    if (focalLength <= 0.0)
+        return 0;
+
+    const auto size = glm::length(bounds.getSize());
+    const auto distance =
+        glm::length(bounds.getCenter() - position) - 0.5 * size;
+    if (distance <= 0.0)
+        return 0;
+
+    const auto projectedSize = size * focalLength / distance;
+    const auto maxTriangles =
+        LOD_TRIANGLES_PER_PIXEL * projectedSize * projectedSize;
+    size_t level = 0;
+    while (level + 1 < nbTriangles.size() && nbTriangles[level] > maxTriangles)
+        ++level;
+    return level;
+}
+} // namespace
+
 OSPRayScene::OSPRayScene(AnimationParameters& animationParameters,
                          GeometryParameters& geometryParameters,
                          VolumeParameters& volumeParameters)
@@ -78,8 +107,10 @@ void OSPRayScene::commit()
     const bool rebuildScene = isModified();
     const bool addRemoveVolumes =
         _commitVolumeAndTransferFunction(modelDescriptors);
+    const bool lodChanged = _updateLODLevels(modelDescriptors);
+    const bool cullingChanged = _updateCulledInstances(modelDescriptors);
 
-    if (!rebuildScene && !addRemoveVolumes)
+    if (!rebuildScene && !addRemoveVolumes && !lodChanged && !cullingChanged)
     {
         // check for dirty models aka their geometry has been altered
         bool doUpdate = false;
@@ -104,6 +135,12 @@ void OSPRayScene::commit()
         ospRelease(_rootModel);
     _rootModel = ospNewModel();
 
+    // Instances entirely outside of the clip planes are culled if their
+    // geometry is clipped anyway
+    const auto& clipPlanes = getClipPlanes();
+    _clippedByPlanes = !clipPlanes.empty();
+    size_t nbCulledInstances = 0;
+
     for (auto modelDescriptor : modelDescriptors)
     {
         if (!modelDescriptor->getEnabled())
@@ -122,6 +159,11 @@ void OSPRayScene::commit()
         impl.commitGeometry();
         impl.logInformation();
 
+        const bool clippedByPlanes =
+            !clipPlanes.empty() && isModelClippedByPlanes(impl);
+        if (modelDescriptor->getVisible() && !clippedByPlanes)
+            _clippedByPlanes = false;
+
         // add volumes to root model, because scivis renderer does not consider
         // volumes from instances
         if (modelDescriptor->getVisible())
@@ -135,6 +177,9 @@ void OSPRayScene::commit()
             }
         }
 
+        const auto lodLevels = _lodLevels.find(modelDescriptor->getModelID());
+        const auto culled =
+            _culledInstances.find(modelDescriptor->getModelID());
         const auto& instances = modelDescriptor->getInstances();
         for (size_t i = 0; i < instances.size(); ++i)
         {
@@ -161,12 +206,32 @@ void OSPRayScene::commit()
             }
 
             if (modelDescriptor->getVisible() && instance.getVisible())
-                addInstance(_rootModel, impl.getPrimaryModel(),
+            {
+                if (culled != _culledInstances.end() && culled->second[i])
+                {
+                    ++nbCulledInstances;
+                    continue;
+                }
+                if (clippedByPlanes &&
+                    isClipped(transformBox(impl.getBounds(), instanceTransform),
+                              clipPlanes))
+                {
+                    ++nbCulledInstances;
+                    continue;
+                }
+
+                const size_t level =
+                    lodLevels == _lodLevels.end() ? 0 : lodLevels->second[i];
+                addInstance(_rootModel, impl.getLODModel(level),
                             instanceTransform);
+            }
         }
 
         impl.markInstancesClean();
     }
+    if (nbCulledInstances > 0)
+        BRAYNS_DEBUG << nbCulledInstances
+                     << " instance(s) culled" << std::endl;
     BRAYNS_DEBUG << "Committing root models" << std::endl;
 
     ospCommit(_rootModel);
@@ -174,6 +239,86 @@ void OSPRayScene::commit()
     _computeBounds();
 }
 
+bool OSPRayScene::_updateLODLevels(const ModelDescriptors& modelDescriptors)
+{
+    std::map<size_t, std::vector<size_t>> lodLevels;
+    for (const auto& modelDescriptor : modelDescriptors)
+    {
+        // The counts of dirty models are updated later in the commit, the
+        // levels follow at the next frame
+        const auto& model = modelDescriptor->getModel();
+        const auto& nbTriangles = model.getNbTrianglesPerLOD();
+        if (nbTriangles.empty())
+            continue;
+
+        // First instance uses model transformation
+        const auto& instances = modelDescriptor->getInstances();
+        auto& levels = lodLevels[modelDescriptor->getModelID()];
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            const auto& transformation =
+                i == 0 ? modelDescriptor->getTransformation()
+                       : instances[i].getTransformation();
+            levels.push_back(selectLOD(nbTriangles,
+                                       transformBox(model.getBounds(),
+                                                    transformation),
+                                       _lodPosition, _lodFocalLength));
+        }
+    }
+
+    if (lodLevels == _lodLevels)
+        return false;
+    _lodLevels = std::move(lodLevels);
+    return true;
+}
+
+bool OSPRayScene::_updateCulledInstances(
+    const ModelDescriptors& modelDescriptors)
+{
+    // Culled instances are left out of the OSPRay model, so secondary rays
+    // miss them too, and the occlusion map holds the depth of the first hit,
+    // transparent or not. Both are documented limitations of the options.
+    std::map<size_t, std::vector<bool>> culledInstances;
+    const bool frustumCulling = _geometryParameters.getFrustumCulling() &&
+                                !_viewFrustum.isUnbounded();
+    const bool occlusionCulling = _geometryParameters.getOcclusionCulling() &&
+                                  !_occlusionMap.isEmpty();
+    if (frustumCulling || occlusionCulling)
+    {
+        for (const auto& modelDescriptor : modelDescriptors)
+        {
+            // The bounds of dirty models are updated later in the commit
+            const auto& model = modelDescriptor->getModel();
+            const auto& bounds = model.getBounds();
+
+            // First instance uses model transformation
+            const auto& instances = modelDescriptor->getInstances();
+            auto& culled = culledInstances[modelDescriptor->getModelID()];
+            culled.reserve(instances.size());
+            for (size_t i = 0; i < instances.size(); ++i)
+            {
+                if (model.isDirty())
+                {
+                    culled.push_back(false);
+                    continue;
+                }
+                const auto box =
+                    transformBox(bounds,
+                                 i == 0 ? modelDescriptor->getTransformation()
+                                        : instances[i].getTransformation());
+                culled.push_back(
+                    (frustumCulling && !_viewFrustum.intersects(box)) ||
+                    (occlusionCulling && _occlusionMap.isOccluded(box)));
+            }
+        }
+    }
+
+    if (culledInstances == _culledInstances)
+        return false;
+    _culledInstances = std::move(culledInstances);
+    return true;
+}
+
 bool OSPRayScene::commitLights()
 {
     if (!_lightManager.isModified())
@@ -276,6 +421,9 @@ bool OSPRayScene::_commitVolumeAndTransferFunction(
         }
         for (auto volume : model.getVolumes())
         {
+            if (auto pagedVolume =
+                    std::dynamic_pointer_cast<PagedVolume>(volume))
+                pagedVolume->prefetch(_viewFrustum);
             if (volume->isModified() || rebuildScene ||
                 _volumeParameters.isModified())
             {
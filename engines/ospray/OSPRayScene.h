@@ -57,8 +57,17 @@ public:
     OSPData lightData() { return _ospLightData; }
     ModelDescriptorPtr getSimulatedModel();
 
+    /**
+     * @return true if the materials of all the visible models discard the
+     *         geometry outside of the clip planes, so that renderers can clip
+     *         the rays to the planes before traversal.
+     */
+    bool isClippedByPlanes() const { return _clippedByPlanes; }
+
 private:
     bool _commitVolumeAndTransferFunction(ModelDescriptors& modelDescriptors);
+    bool _updateLODLevels(const ModelDescriptors& modelDescriptors);
+    bool _updateCulledInstances(const ModelDescriptors& modelDescriptors);
     void _destroyLights();
 
     OSPModel _rootModel{nullptr};
@@ -70,6 +79,14 @@ private:
     size_t _memoryManagementFlags{0};
 
     ModelDescriptors _activeModels;
+
+    // Level of detail of each instance of the models having coarser levels
+    std::map<size_t, std::vector<size_t>> _lodLevels;
+
+    // Instances out of view or hidden in the previous frame, per model
+    std::map<size_t, std::vector<bool>> _culledInstances;
+
+    bool _clippedByPlanes{false};
 };
 } // namespace brayns
 #endif // OSPRAYSCENE_H
@@ -20,6 +20,7 @@
 
 #include "OSPRayVolume.h"
 
+#include <brayns/common/volume/BrickCache.h>
 #include <brayns/parameters/VolumeParameters.h>
 #include <engines/ospray/utils.h>
 
@@ -100,6 +101,18 @@ OSPRaySharedDataVolume::OSPRaySharedDataVolume(
 {
 }
 
+OSPRayPagedVolume::OSPRayPagedVolume(const Vector3ui& dimensions,
+                                     const Vector3f& spacing,
+                                     const DataType type,
+                                     const VolumeParameters& params,
+                                     OSPTransferFunction transferFunction)
+    : Volume(dimensions, spacing, type)
+    , PagedVolume(dimensions, spacing, type)
+    , OSPRayVolume(dimensions, spacing, type, params, transferFunction,
+                   "brayns_paged_volume")
+{
+}
+
 void OSPRayVolume::setDataRange(const Vector2f& range)
 {
     osphelper::set(_volume, "voxelRange", range);
@@ -126,6 +139,45 @@ void OSPRaySharedDataVolume::setVoxels(const void* voxels)
         glm::compMul(SharedDataVolume::_dimensions) * _dataSize;
     ospSetData(_volume, "voxelData", data);
     ospRelease(data);
+
+    // Value ranges used by the renderers to skip transparent regions
+    _macroCells.build(voxels, SharedDataVolume::_dimensions,
+                      SharedDataVolume::_dataType);
+    const auto& ranges = _macroCells.getRanges();
+    OSPData macroCells = ospNewData(ranges.size() / 2, OSP_FLOAT2,
+                                    ranges.data(), OSP_DATA_SHARED_BUFFER);
+    ospSetData(_volume, "macroCellRanges", macroCells);
+    ospRelease(macroCells);
+    osphelper::set(_volume, "macroCellDimensions",
+                   Vector3i(_macroCells.getDimensions()));
+    osphelper::set(_volume, "macroCellSize",
+                   static_cast<int>(MacroCellGrid::CELL_SIZE));
+    markModified();
+}
+
+void OSPRayPagedVolume::setCoarseVoxels(const void* voxels,
+                                        const Vector3ui& dimensions)
+{
+    OSPData data = ospNewData(glm::compMul(dimensions), _ospType, voxels,
+                              OSP_DATA_SHARED_BUFFER);
+    ospSetData(_volume, "coarseVoxelData", data);
+    ospRelease(data);
+    osphelper::set(_volume, "coarseDimensions", Vector3i(dimensions));
+    osphelper::set(_volume, "coarseFactor",
+                   static_cast<int>(BrickCache::COARSE_FACTOR));
+    markModified();
+}
+
+void OSPRayPagedVolume::setBricks(const std::vector<const void*>& bricks,
+                                  const Vector3ui& brickCounts)
+{
+    OSPData data = ospNewData(bricks.size(), OSP_VOID_PTR, bricks.data(),
+                              OSP_DATA_SHARED_BUFFER);
+    ospSetData(_volume, "bricks", data);
+    ospRelease(data);
+    osphelper::set(_volume, "brickCounts", Vector3i(brickCounts));
+    osphelper::set(_volume, "brickSize",
+                   static_cast<int>(BrickCache::BRICK_SIZE));
     markModified();
 }
 
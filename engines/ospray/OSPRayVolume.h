@@ -20,7 +20,9 @@
 
 #pragma once
 
+#include <brayns/common/volume/MacroCellGrid.h>
 #include <brayns/engine/BrickedVolume.h>
+#include <brayns/engine/PagedVolume.h>
 #include <brayns/engine/SharedDataVolume.h>
 
 #include <ospray/SDK/volume/Volume.h>
@@ -65,5 +67,21 @@ public:
                            OSPTransferFunction transferFunction);
 
     void setVoxels(const void* voxels) final;
+
+private:
+    MacroCellGrid _macroCells;
+};
+
+class OSPRayPagedVolume : public PagedVolume, public OSPRayVolume
+{
+public:
+    OSPRayPagedVolume(const Vector3ui& dimensions, const Vector3f& spacing,
+                      const DataType type, const VolumeParameters& params,
+                      OSPTransferFunction transferFunction);
+
+    void setCoarseVoxels(const void* voxels,
+                         const Vector3ui& dimensions) final;
+    void setBricks(const std::vector<const void*>& bricks,
+                   const Vector3ui& brickCounts) final;
 };
 }
@@ -63,7 +63,29 @@ void Cones::finalize(ospray::Model* model)
         bounds.extend(up + geom.upRadius);
     }
 
-    ispc::ConesGeometry_set(getIE(), model->getIE(), data->data, numCones);
+    // Optional material table, indexed per cone
+    materialIDData = getParamData("prim.materialID", nullptr);
+    materialListData = getParamData("materialList", nullptr);
+    ispcMaterials.clear();
+    if (materialIDData && materialListData)
+    {
+        if (materialIDData->numItems != numCones)
+            throw std::runtime_error(
+                "#ospray:geometry/cones: 'prim.materialID' size does not "
+                "match the number of cones");
+
+        const auto materials =
+            static_cast<ospray::ManagedObject**>(materialListData->data);
+        for (size_t i = 0; i < materialListData->numItems; ++i)
+            ispcMaterials.push_back(materials[i] ? materials[i]->getIE()
+                                                 : nullptr);
+    }
+
+    ispc::ConesGeometry_set(getIE(), model->getIE(), data->data, numCones,
+                            ispcMaterials.empty() ? nullptr
+                                                  : materialIDData->data,
+                            ispcMaterials.empty() ? nullptr
+                                                  : ispcMaterials.data());
 }
 
 OSP_REGISTER_GEOMETRY(Cones, cones);
@@ -31,6 +31,9 @@ struct Cones : public ospray::Geometry
     void finalize(ospray::Model* model) final;
 
     ospray::Ref<ospray::Data> data;
+    ospray::Ref<ospray::Data> materialIDData;
+    ospray::Ref<ospray::Data> materialListData;
+    std::vector<void*> ispcMaterials;
 
     Cones();
 };
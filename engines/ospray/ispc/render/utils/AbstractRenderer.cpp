@@ -46,4 +46,20 @@ void AbstractRenderer::commit()
     _bgMaterial =
         (brayns::DefaultMaterial*)getParamObject("bgMaterial", nullptr);
 }
+
+void* AbstractRenderer::beginFrame(ospray::FrameBuffer* fb)
+{
+    _renderRegions.update(fb);
+    return Renderer::beginFrame(fb);
+}
+
+void AbstractRenderer::renderTile(void* perFrameData, ospray::Tile& tile,
+                                  const size_t jobID) const
+{
+    if (_renderRegions.contains(tile))
+        Renderer::renderTile(perFrameData, tile, jobID);
+    // The jobs of a tile run in parallel, only the first one clears it all
+    else if (jobID == 0)
+        RenderRegions::clear(tile);
+}
 }
@@ -25,6 +25,7 @@
 
 // obj
 #include "../DefaultMaterial.h"
+#include "RenderRegions.h"
 
 // ospray
 #include <ospray/SDK/common/Material.h>
@@ -43,8 +44,14 @@ class AbstractRenderer : public ospray::Renderer
 {
 public:
     void commit() override;
+    void* beginFrame(ospray::FrameBuffer* fb) override;
+    /** Only renders the tiles in the render regions of the framebuffer. */
+    void renderTile(void* perFrameData, ospray::Tile& tile,
+                    size_t jobID) const override;
 
 protected:
+    RenderRegions _renderRegions;
+
     std::vector<void*> _lightArray;
     void** _lightPtr;
 
@@ -0,0 +1,86 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <ospray/SDK/common/Data.h>
+#include <ospray/SDK/fb/FrameBuffer.h>
+#include <ospray/SDK/fb/Tile.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace brayns
+{
+/**
+ * The regions of a framebuffer to render, from its "renderRegions" data of
+ * {lower x, lower y, upper x, upper y} pixels; all of the frame if unset.
+ */
+class RenderRegions
+{
+public:
+    /** Read the regions of the framebuffer, when a frame begins. */
+    void update(ospray::FrameBuffer* frameBuffer)
+    {
+        _regions.clear();
+        const auto data =
+            frameBuffer ? frameBuffer->getParamData("renderRegions", nullptr)
+                        : nullptr;
+        if (!data)
+            return;
+
+        const auto regions = static_cast<const ospray::vec4i*>(data->data);
+        _regions.assign(regions, regions + data->numItems);
+    }
+
+    /** @return true if the tile overlaps one of the regions. */
+    bool contains(const ospray::Tile& tile) const
+    {
+        if (_regions.empty())
+            return true;
+
+        const auto& lower = tile.region.lower;
+        const auto& upper = tile.region.upper;
+        return std::any_of(_regions.begin(), _regions.end(),
+                           [&](const ospray::vec4i& region) {
+                               return lower.x < region.z &&
+                                      upper.x > region.x &&
+                                      lower.y < region.w && upper.y > region.y;
+                           });
+    }
+
+    /**
+     * Empty a tile which is not rendered, as it still goes through the
+     * accumulation of the framebuffer. Called by a single job of the tile.
+     */
+    static void clear(ospray::Tile& tile)
+    {
+        const size_t size = TILE_SIZE * TILE_SIZE;
+        std::fill_n(tile.r, size, 0.f);
+        std::fill_n(tile.g, size, 0.f);
+        std::fill_n(tile.b, size, 0.f);
+        std::fill_n(tile.a, size, 0.f);
+        std::fill_n(tile.z, size, std::numeric_limits<float>::infinity());
+    }
+
+private:
+    std::vector<ospray::vec4i> _regions;
+};
+} // namespace brayns
@@ -0,0 +1,149 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "PagedVolume.h"
+
+#include "ospray/SDK/common/Data.h"
+// ispc-generated files
+#include "PagedVolume_ispc.h"
+
+#include <algorithm>
+#include <set>
+
+namespace ispc
+{
+// Exported by the grid accelerator of OSPRay structured volumes, whose
+// generated header is not part of the SDK
+extern "C" {
+void GridAccelerator_buildAccelerator(void* volume, int taskIndex);
+}
+} // namespace ispc
+
+namespace ospray
+{
+namespace
+{
+// Voxels along each side of a brick of the grid accelerator, each task of
+// GridAccelerator_buildAccelerator() builds the 4^3 cells of 16^3 voxels of
+// one brick
+const int ACCELERATOR_BRICK_SIZE = 64;
+} // namespace
+
+void PagedVolume::commit()
+{
+    if (ispcEquivalent)
+    {
+        _setBricks();
+        _updateAccelerator();
+    }
+    else
+        createEquivalentISPC();
+    StructuredVolume::commit();
+}
+
+int PagedVolume::setRegion(const void*, const vec3i&, const vec3i&)
+{
+    throw std::runtime_error(
+        "#ospray:volume/brayns_paged_volume: setRegion() is not supported");
+}
+
+void PagedVolume::createEquivalentISPC()
+{
+    voxelType = getParamString("voxelType", "unspecified");
+    dimensions = getParam3i("dimensions", vec3i(0));
+    ispcEquivalent =
+        ispc::PagedVolume_create(this, getVoxelType(),
+                                 (const ispc::vec3i&)dimensions);
+    _setBricks();
+
+    // The empty space skipping grid is built from the bricks resident at
+    // creation and the coarse level elsewhere, then updated where the
+    // resident bricks change
+    buildAccelerator();
+    const auto bricks = (const void**)_brickData->data;
+    _residentBricks.assign(bricks, bricks + _brickData->numItems);
+}
+
+void PagedVolume::_setBricks()
+{
+    _coarseVoxelData = getParamData("coarseVoxelData", nullptr);
+    _brickData = getParamData("bricks", nullptr);
+    if (!_coarseVoxelData || !_brickData)
+        throw std::runtime_error(
+            "#ospray:volume/brayns_paged_volume: no 'coarseVoxelData' or "
+            "'bricks' data specified");
+
+    const auto coarseDimensions = getParam3i("coarseDimensions", vec3i(0));
+    const auto brickCounts = getParam3i("brickCounts", vec3i(0));
+    ispc::PagedVolume_set(getIE(), _coarseVoxelData->data,
+                          (const ispc::vec3i&)coarseDimensions,
+                          getParam1i("coarseFactor", 1),
+                          (const void**)_brickData->data,
+                          (const ispc::vec3i&)brickCounts,
+                          getParam1i("brickSize", 1));
+}
+
+void PagedVolume::_updateAccelerator()
+{
+    const auto bricks = (const void**)_brickData->data;
+    const size_t nbBricks = _brickData->numItems;
+    const auto brickCounts = getParam3i("brickCounts", vec3i(0));
+    const int brickSize = getParam1i("brickSize", 1);
+    const vec3i counts((dimensions.x + ACCELERATOR_BRICK_SIZE - 1) /
+                           ACCELERATOR_BRICK_SIZE,
+                       (dimensions.y + ACCELERATOR_BRICK_SIZE - 1) /
+                           ACCELERATOR_BRICK_SIZE,
+                       (dimensions.z + ACCELERATOR_BRICK_SIZE - 1) /
+                           ACCELERATOR_BRICK_SIZE);
+
+    // Accelerator bricks overlapping the loaded or evicted bricks; cells
+    // also hold the first voxel of their next neighbour
+    std::set<int> tasks;
+    for (size_t i = 0; i < nbBricks; ++i)
+    {
+        if (i < _residentBricks.size() && _residentBricks[i] == bricks[i])
+            continue;
+
+        const int brick[] = {int(i % brickCounts.x),
+                             int((i / brickCounts.x) % brickCounts.y),
+                             int(i / (size_t(brickCounts.x) * brickCounts.y))};
+        const int size[] = {dimensions.x, dimensions.y, dimensions.z};
+        int begin[3], end[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            begin[axis] = std::max(brick[axis] * brickSize - 1, 0) /
+                          ACCELERATOR_BRICK_SIZE;
+            end[axis] = std::min((brick[axis] + 1) * brickSize - 1,
+                                 size[axis] - 1) /
+                        ACCELERATOR_BRICK_SIZE;
+        }
+        for (int z = begin[2]; z <= end[2]; ++z)
+            for (int y = begin[1]; y <= end[1]; ++y)
+                for (int x = begin[0]; x <= end[0]; ++x)
+                    tasks.insert(x + counts.x * (y + counts.y * z));
+    }
+    _residentBricks.assign(bricks, bricks + nbBricks);
+
+    const std::vector<int> taskIndices(tasks.begin(), tasks.end());
+#pragma omp parallel for
+    for (int64_t i = 0; i < int64_t(taskIndices.size()); ++i)
+        ispc::GridAccelerator_buildAccelerator(ispcEquivalent, taskIndices[i]);
+}
+
+OSP_REGISTER_VOLUME(PagedVolume, brayns_paged_volume);
+} // namespace ospray
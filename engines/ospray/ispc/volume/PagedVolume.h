@@ -0,0 +1,56 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include "ospray/SDK/volume/structured/StructuredVolume.h"
+
+#include <vector>
+
+namespace ospray
+{
+/**
+ * A structured volume made of bricks which may not be resident: the voxels of
+ * the missing bricks are taken from a coarse level of the volume.
+ */
+struct PagedVolume : public StructuredVolume
+{
+    std::string toString() const final { return "brayns::PagedVolume"; }
+    void commit() final;
+
+    /** The voxels are provided by brick tables only. */
+    int setRegion(const void* source, const vec3i& index,
+                  const vec3i& count) final;
+
+protected:
+    void createEquivalentISPC() final;
+
+private:
+    void _setBricks();
+
+    /** Rebuild the accelerator where the resident bricks changed. */
+    void _updateAccelerator();
+
+    Ref<Data> _coarseVoxelData;
+    Ref<Data> _brickData;
+
+    // Copy of the brick table at the last accelerator update, as the table
+    // is shared with, and modified in place by, the application
+    std::vector<const void*> _residentBricks;
+};
+} // namespace ospray
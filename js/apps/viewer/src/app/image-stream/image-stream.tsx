@@ -4,7 +4,7 @@ import React, {
     RefObject
 } from 'react';
 
-import {IMAGE_JPEG} from 'brayns';
+import {IMAGE_JPEG, IMAGE_STREAM_ACK} from 'brayns';
 import {isNumber, noop} from 'lodash';
 import {
     BehaviorSubject,
@@ -111,6 +111,9 @@ export class ImageStream extends Component<Props> {
                         this.ctx.drawImage(img, 0, 0, widthScaleFactor * width, heightScaleFactor * height);
                     }
 
+                    // Let the server adapt the stream to how fast we draw
+                    brayns.notify(IMAGE_STREAM_ACK);
+
                     // Calc the fps of image decode (accounts for networking)
                     const fps = getRenderFps();
                     this.imageRenderFps.next(fps);
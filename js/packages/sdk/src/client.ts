@@ -41,6 +41,7 @@ import {
     GET_VERSION_TYPE,
     IMAGE_JPEG,
     IMAGE_JPEG_TYPE,
+    IMAGE_STREAM_ACK_TYPE,
     INSPECT_TYPE,
     LOAD_MODEL_TYPE,
     LOADERS_SCHEMA_TYPE,
@@ -193,6 +194,7 @@ export class Client {
     notify(method: SET_MODEL_PROPERTIES_TYPE, params: ModelPropsParams): void;
     notify(method: SET_MODEL_TRANSFER_FUNCTION_TYPE, params: SetTransferFunctionParams): void;
     notify(method: QUIT_TYPE): void;
+    notify(method: IMAGE_STREAM_ACK_TYPE): void;
     notify<P>(method: NotificationType | string, params?: P) {
         this.rockets!.notify(method, params);
     }
@@ -430,6 +432,7 @@ export type NotificationType = SET_ANIMATION_PARAMS_TYPE
     | UPDATE_CLIP_PLANE_TYPE
     | REMOVE_CLIP_PLANES_TYPE
     | SET_MODEL_TRANSFER_FUNCTION_TYPE
+    | IMAGE_STREAM_ACK_TYPE
     | QUIT_TYPE;
 
 export type ObservableType = SET_ANIMATION_PARAMS_TYPE
@@ -57,6 +57,10 @@ export type SET_STATISTICS_TYPE = typeof SET_STATISTICS;
 export const IMAGE_JPEG = 'image-jpeg';
 export type IMAGE_JPEG_TYPE = typeof IMAGE_JPEG;
 
+// Acknowledge a received image to adapt the stream rate and quality
+export const IMAGE_STREAM_ACK = 'image-stream-ack';
+export type IMAGE_STREAM_ACK_TYPE = typeof IMAGE_STREAM_ACK;
+
 
 /**
  * Renderer
@@ -54,6 +54,7 @@ export {
     // Image
     SNAPSHOT,
     IMAGE_JPEG,
+    IMAGE_STREAM_ACK,
     ImageFormat,
     // Quit
     QUIT,
@@ -120,10 +120,11 @@ export interface CancelParams {
     id: string | number;
 }
 
-export type SetAnimationParameters = Partial<Pick<AnimationParameters, 'current' | 'delta' | 'playing'>>;
+export type SetAnimationParameters = Partial<Pick<AnimationParameters, 'current' | 'fraction' | 'delta' | 'playing'>>;
 
 export interface AnimationParameters {
     current: number;
+    fraction: number;
     delta: number;
     dt: number;
     frameCount: number;
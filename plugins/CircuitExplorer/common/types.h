@@ -162,6 +162,15 @@ inline std::vector<std::pair<std::string, UserDataType>> enumerateMap()
             {"Distance to soma", UserDataType::distance_to_soma}};
 }
 
+template <>
+inline std::vector<std::pair<std::string, brayns::SimulationDataEncoding>>
+    enumerateMap()
+{
+    return {{"Float", brayns::SimulationDataEncoding::float32},
+            {"16-bit integer", brayns::SimulationDataEncoding::uint16},
+            {"8-bit integer", brayns::SimulationDataEncoding::uint8}};
+}
+
 template <>
 inline std::vector<std::pair<std::string, MorphologyColorScheme>> enumerateMap()
 {
@@ -221,6 +230,10 @@ const brayns::Property PROP_USER_DATA_TYPE = {
     {"Type of data attached to morphology segments"}};
 const brayns::Property PROP_SYNCHRONOUS_MODE = {
     "023SynchronousMode", false, {"Synchronous mode"}};
+const brayns::Property PROP_SIMULATION_ENCODING = {
+    "024SimulationEncoding", ::enumToString(brayns::SimulationDataEncoding::float32),
+    enumerateNames<brayns::SimulationDataEncoding>(),
+    {"Storage of the simulation values, integers are normalized to the transfer function range"}};
 const brayns::Property PROP_CIRCUIT_COLOR_SCHEME = {
     "030CircuitColorScheme", enumToString(CircuitColorScheme::none),
     enumerateNames<CircuitColorScheme>(),
@@ -330,9 +343,9 @@ struct ParallelModelContainer
         for (const auto& sphere : spheres)
         {
             const auto index = sphere.first;
-            model.getSpheres()[index].insert(model.getSpheres()[index].end(),
-                                             sphere.second.begin(),
-                                             sphere.second.end());
+            auto& modelSpheres = model.getSpheres(index);
+            modelSpheres.insert(modelSpheres.end(), sphere.second.begin(),
+                                sphere.second.end());
         }
     }
 
@@ -341,9 +354,9 @@ struct ParallelModelContainer
         for (const auto& cylinder : cylinders)
         {
             const auto index = cylinder.first;
-            model.getCylinders()[index].insert(
-                model.getCylinders()[index].end(), cylinder.second.begin(),
-                cylinder.second.end());
+            auto& modelCylinders = model.getCylinders(index);
+            modelCylinders.insert(modelCylinders.end(), cylinder.second.begin(),
+                                  cylinder.second.end());
         }
     }
 
@@ -352,9 +365,9 @@ struct ParallelModelContainer
         for (const auto& cone : cones)
         {
             const auto index = cone.first;
-            model.getCones()[index].insert(model.getCones()[index].end(),
-                                           cone.second.begin(),
-                                           cone.second.end());
+            auto& modelCones = model.getCones(index);
+            modelCones.insert(modelCones.end(), cone.second.begin(),
+                              cone.second.end());
         }
     }
 
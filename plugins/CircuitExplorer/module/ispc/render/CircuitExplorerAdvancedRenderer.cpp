@@ -24,9 +24,13 @@
 #include "CircuitExplorerAdvancedRenderer.h"
 #include <common/log.h>
 
+#include <brayns/common/volume/MacroCellGrid.h>
+
 // ospray
 #include <ospray/SDK/common/Data.h>
 #include <ospray/SDK/common/Model.h>
+#include <ospray/SDK/transferFunction/TransferFunction.h>
+#include <ospray/SDK/volume/Volume.h>
 
 // ispc exports
 #include "CircuitExplorerAdvancedRenderer_ispc.h"
@@ -54,12 +58,12 @@ void CircuitExplorerAdvancedRenderer::commit()
     _volumeSpecularExponent = getParam1f("volumeSpecularExponent", 20.f);
     _volumeAlphaCorrection = getParam1f("volumeAlphaCorrection", 0.5f);
 
-    const uint64 simulationDataSize =
-        _simulationData ? _simulationData->size() : 0;
-
     clipPlanes = getParamData("clipPlanes", nullptr);
     const auto clipPlaneData = clipPlanes ? clipPlanes->data : nullptr;
     const uint32 numClipPlanes = clipPlanes ? clipPlanes->numItems : 0;
+    // Set when all the geometry is clipped by the planes, rays can then be
+    // clamped to them instead of rejecting the clipped hits one by one
+    _clipRayIntervals = getParam("clipRayIntervals", 0);
 
     ispc::CircuitExplorerAdvancedRenderer_set(
         getIE(), (_secondaryModel ? _secondaryModel->getIE() : nullptr),
@@ -69,10 +73,72 @@ void CircuitExplorerAdvancedRenderer::commit()
         _randomNumber, _timestamp, spp, _lightPtr, _lightArray.size(),
         _volumeSamplesPerRay,
         _simulationData ? (float*)_simulationData->data : nullptr,
-        simulationDataSize, _samplingThreshold, _volumeSpecularExponent,
+        _simulationDataSize, _samplingThreshold, _volumeSpecularExponent,
         _volumeAlphaCorrection, _exposure, _fogThickness, _fogStart,
-        (const ispc::vec4f*)clipPlaneData, numClipPlanes, _maxBounces,
-        _epsilonFactor, _useHardwareRandomizer);
+        (const ispc::vec4f*)clipPlaneData, numClipPlanes, _clipRayIntervals,
+        _maxBounces, _epsilonFactor, _useHardwareRandomizer);
+
+    _commitVolumeMacroCells();
+}
+
+void CircuitExplorerAdvancedRenderer::_commitVolumeMacroCells()
+{
+    const size_t nbVolumes = model ? model->volume.size() : 0;
+    _visibleCellsPointers.assign(nbVolumes, nullptr);
+    _cellDimensions.assign(nbVolumes, vec3i(0));
+    _cellScales.assign(nbVolumes, vec3f(0.f));
+
+    // Volumes provide the value range of their macro cells, the cells are
+    // skipped where the transfer function is below the sampling threshold
+    std::map<const Volume*, MacroCells> macroCells;
+    for (size_t i = 0; i < nbVolumes; ++i)
+    {
+        Volume* volume = model->volume[i].ptr;
+        Ref<Data> ranges = volume->getParamData("macroCellRanges", nullptr);
+        auto transferFunction = dynamic_cast<TransferFunction*>(
+            volume->getParamObject("transferFunction", nullptr));
+        Ref<Data> opacities =
+            transferFunction
+                ? transferFunction->getParamData("opacities", nullptr)
+                : nullptr;
+        if (!ranges || !opacities)
+            continue;
+
+        const vec2f valueRange =
+            transferFunction->getParam2f("valueRange", vec2f(0.f, 1.f));
+
+        auto& cells = macroCells[volume];
+        const auto it = _macroCells.find(volume);
+        if (it != _macroCells.end())
+            cells = std::move(it->second);
+        if (cells.ranges != ranges || cells.opacities != opacities ||
+            cells.valueRange != valueRange ||
+            cells.threshold != _samplingThreshold)
+        {
+            cells.ranges = ranges;
+            cells.opacities = opacities;
+            cells.valueRange = valueRange;
+            cells.threshold = _samplingThreshold;
+            cells.visibleCells = brayns::MacroCellGrid::getVisibleCells(
+                (const float*)ranges->data, ranges->numItems,
+                (const float*)opacities->data, opacities->numItems,
+                {valueRange.x, valueRange.y}, _samplingThreshold);
+        }
+
+        const float cellSize = volume->getParam1i("macroCellSize", 1);
+        _visibleCellsPointers[i] = cells.visibleCells.data();
+        _cellDimensions[i] =
+            volume->getParam3i("macroCellDimensions", vec3i(0));
+        _cellScales[i] =
+            1.f / (volume->getParam3f("gridSpacing", vec3f(1.f)) * cellSize);
+    }
+    // Drops the cells of the removed volumes
+    _macroCells = std::move(macroCells);
+
+    ispc::CircuitExplorerAdvancedRenderer_setVolumeMacroCells(
+        getIE(), _visibleCellsPointers.data(),
+        (const ispc::vec3i*)_cellDimensions.data(),
+        (const ispc::vec3f*)_cellScales.data(), nbVolumes);
 }
 
 CircuitExplorerAdvancedRenderer::CircuitExplorerAdvancedRenderer()
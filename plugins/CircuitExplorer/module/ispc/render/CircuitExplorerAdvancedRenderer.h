@@ -23,6 +23,8 @@
 
 #include "utils/CircuitExplorerSimulationRenderer.h"
 
+#include <map>
+
 namespace circuitExplorer
 {
 /**
@@ -46,6 +48,8 @@ public:
     void commit() final;
 
 private:
+    void _commitVolumeMacroCells();
+
     // Shading
     float _shadows{0.f};
     float _softShadows{0.f};
@@ -64,7 +68,24 @@ private:
     float _volumeSpecularExponent{10.f};
     float _volumeAlphaCorrection{0.5f};
 
+    // Visible macro cells of each volume with its current transfer function,
+    // computed again when the voxels or the transfer function change. The
+    // references keep the data alive, so new data never reuse their address.
+    struct MacroCells
+    {
+        ospray::Ref<ospray::Data> ranges;
+        ospray::Ref<ospray::Data> opacities;
+        ospray::vec2f valueRange;
+        float threshold{0.f};
+        std::vector<uint8_t> visibleCells;
+    };
+    std::map<const ospray::Volume*, MacroCells> _macroCells;
+    std::vector<void*> _visibleCellsPointers;
+    std::vector<ospray::vec3i> _cellDimensions;
+    std::vector<ospray::vec3f> _cellScales;
+
     // Clip planes
     ospray::Ref<ospray::Data> clipPlanes;
+    bool _clipRayIntervals{false};
 };
 } // namespace circuitExplorer
@@ -51,4 +51,19 @@ void CircuitExplorerAbstractRenderer::commit()
     _useHardwareRandomizer = getParam("useHardwareRandomizer", 0);
 }
 
+void* CircuitExplorerAbstractRenderer::beginFrame(ospray::FrameBuffer* fb)
+{
+    _renderRegions.update(fb);
+    return Renderer::beginFrame(fb);
+}
+
+void CircuitExplorerAbstractRenderer::renderTile(void* perFrameData,
+                                                 ospray::Tile& tile,
+                                                 const size_t jobID) const
+{
+    if (_renderRegions.contains(tile))
+        Renderer::renderTile(perFrameData, tile, jobID);
+    else
+        brayns::RenderRegions::clear(tile);
+}
 } // namespace circuitExplorer
@@ -25,6 +25,8 @@
 // obj
 #include "../CircuitExplorerMaterial.h"
 
+#include <engines/ospray/ispc/render/utils/RenderRegions.h>
+
 // ospray
 #include <ospray/SDK/common/Material.h>
 #include <ospray/SDK/render/Renderer.h>
@@ -42,8 +44,14 @@ class CircuitExplorerAbstractRenderer : public ospray::Renderer
 {
 public:
     void commit() override;
+    void* beginFrame(ospray::FrameBuffer* fb) override;
+    /** Only renders the tiles in the render regions of the framebuffer. */
+    void renderTile(void* perFrameData, ospray::Tile& tile,
+                    size_t jobID) const override;
 
 protected:
+    brayns::RenderRegions _renderRegions;
+
     bool _useHardwareRandomizer;
 
     std::vector<void*> _lightArray;
@@ -45,10 +45,12 @@ extern "C"
     {
         const ospray::Geometry* base =
             static_cast<const ospray::Geometry*>(geometry);
-        if (dynamic_cast<const ospray::Spheres*>(base))
-            return sizeof(brayns::Sphere);
-        else if (dynamic_cast<const ospray::Cylinders*>(base))
-            return sizeof(brayns::Cylinder);
+        // Spheres and cylinders may carry a material index after the brayns
+        // primitive, use the stride they were committed with
+        if (auto spheres = dynamic_cast<const ospray::Spheres*>(base))
+            return static_cast<int>(spheres->bytesPerSphere);
+        else if (auto cylinders = dynamic_cast<const ospray::Cylinders*>(base))
+            return static_cast<int>(cylinders->bytesPerCylinder);
         else if (dynamic_cast<const ospray::Cones*>(base))
             return sizeof(brayns::Cone);
         else if (dynamic_cast<const ospray::SDFGeometries*>(base))
@@ -67,8 +69,17 @@ void CircuitExplorerSimulationRenderer::commit()
     _maxDistanceToSecondaryModel =
         getParam1f("maxDistanceToSecondaryModel", 30.f);
 
+    // Integer encodings are normalized to the simulation data range, see
+    // brayns::SimulationDataEncoding
     _simulationData = getParamData("simulationData");
-    _simulationDataSize = _simulationData ? _simulationData->size() : 0;
+    const int encoding = getParam1i("simulationDataEncoding", 0);
+    const ospray::vec2f range =
+        getParam2f("simulationDataRange", ospray::vec2f(0.f, 1.f));
+    const size_t bytesPerValue = encoding == 1 ? 2 : encoding == 2 ? 1 : 4;
+    _simulationDataSize =
+        _simulationData ? _simulationData->numBytes / bytesPerValue : 0;
+    ispc::CircuitExplorerSimulationRenderer_setSimulationEncoding(
+        getIE(), encoding, range.x, range.y);
 
     _alphaCorrection = getParam1f("alphaCorrection", 0.5f);
     _fogThickness = getParam1f("fogThickness", 1e6f);
@@ -273,6 +273,26 @@ std::vector<std::string> _splitString(const std::string& source, const char toke
     return result;
 }
 
+bool _isClippedByPlanes(const brayns::Model& model)
+{
+    const auto& materials = model.getMaterials();
+    if (materials.empty())
+        return false;
+
+    for (const auto& material : materials)
+    {
+        if (material.first == brayns::BOUNDINGBOX_MATERIAL_ID ||
+            material.first == brayns::SECONDARY_MODEL_MATERIAL_ID)
+            continue;
+        if (material.second->getPropertyOrValue<int>(
+                MATERIAL_PROPERTY_CLIPPING_MODE,
+                MaterialClippingMode::no_clipping) !=
+            MaterialClippingMode::plane)
+            return false;
+    }
+    return true;
+}
+
 CircuitExplorerPlugin::CircuitExplorerPlugin()
     : ExtensionPlugin()
 {
@@ -284,6 +304,9 @@ void CircuitExplorerPlugin::init()
     auto& registry = scene.getLoaderRegistry();
     auto& pm = _api->getParametersManager();
 
+    // Lets the engine cull the instances outside of the clip planes
+    scene.setClippedByPlanesCallback(_isClippedByPlanes);
+
     registry.registerLoader(
         std::make_unique<BrickLoader>(scene, BrickLoader::getCLIProperties()));
 
@@ -606,80 +629,106 @@ void CircuitExplorerPlugin::_setMaterial(const MaterialDescriptor& md)
 
 void CircuitExplorerPlugin::_setMaterials(const MaterialsDescriptor& md)
 {
+    const size_t nbMaterials = md.materialIds.size();
+    const auto checkColumn = [nbMaterials](const size_t size,
+                                           const size_t components,
+                                           const std::string& name) {
+        if (size != 0 && size != nbMaterials * components)
+        {
+            PLUGIN_ERROR << "set-materials: " << name << " has " << size
+                         << " values, expected " << nbMaterials * components
+                         << std::endl;
+            return false;
+        }
+        return true;
+    };
+
+    if (!checkColumn(md.diffuseColors.size(), 3, "diffuseColors") ||
+        !checkColumn(md.specularColors.size(), 3, "specularColors") ||
+        !checkColumn(md.specularExponents.size(), 1, "specularExponents") ||
+        !checkColumn(md.reflectionIndices.size(), 1, "reflectionIndices") ||
+        !checkColumn(md.opacities.size(), 1, "opacities") ||
+        !checkColumn(md.refractionIndices.size(), 1, "refractionIndices") ||
+        !checkColumn(md.emissions.size(), 1, "emissions") ||
+        !checkColumn(md.glossinesses.size(), 1, "glossinesses") ||
+        !checkColumn(md.simulationDataCasts.size(), 1,
+                     "simulationDataCasts") ||
+        !checkColumn(md.shadingModes.size(), 1, "shadingModes") ||
+        !checkColumn(md.clippingModes.size(), 1, "clippingModes") ||
+        !checkColumn(md.userParameters.size(), 1, "userParameters"))
+        return;
+
     for (const auto modelId : md.modelIds)
     {
         auto modelDescriptor = _api->getScene().getModel(modelId);
-        if (modelDescriptor)
+        if (!modelDescriptor)
         {
-            size_t id = 0;
-            for (const auto materialId : md.materialIds)
+            PLUGIN_INFO << "Model " << modelId << " is not registered"
+                        << std::endl;
+            continue;
+        }
+
+        // Materials are only updated here. They are committed all at once by
+        // the engine before the next frame, instead of one OSPRay commit per
+        // material.
+        const auto& materials = modelDescriptor->getModel().getMaterials();
+        for (size_t id = 0; id < nbMaterials; ++id)
+        {
+            const auto it = materials.find(md.materialIds[id]);
+            if (it == materials.end())
             {
-                try
-                {
-                    auto material =
-                        modelDescriptor->getModel().getMaterial(materialId);
-                    if (material)
-                    {
-                        if (!md.diffuseColors.empty())
-                        {
-                            const size_t index = id * 3;
-                            material->setDiffuseColor(
-                                {md.diffuseColors[index],
-                                 md.diffuseColors[index + 1],
-                                 md.diffuseColors[index + 2]});
-                            material->setSpecularColor(
-                                {md.specularColors[index],
-                                 md.specularColors[index + 1],
-                                 md.specularColors[index + 2]});
-                        }
-
-                        if (!md.specularExponents.empty())
-                            material->setSpecularExponent(
-                                md.specularExponents[id]);
-                        if (!md.reflectionIndices.empty())
-                            material->setReflectionIndex(
-                                md.reflectionIndices[id]);
-                        if (!md.opacities.empty())
-                            material->setOpacity(md.opacities[id]);
-                        if (!md.refractionIndices.empty())
-                            material->setRefractionIndex(
-                                md.refractionIndices[id]);
-                        if (!md.emissions.empty())
-                            material->setEmission(md.emissions[id]);
-                        if (!md.glossinesses.empty())
-                            material->setGlossiness(md.glossinesses[id]);
-                        if (!md.simulationDataCasts.empty())
-                            material->updateProperty(
-                                MATERIAL_PROPERTY_CAST_USER_DATA,
-                                md.simulationDataCasts[id]);
-                        if (!md.shadingModes.empty())
-                            material->updateProperty(
-                                MATERIAL_PROPERTY_SHADING_MODE,
-                                md.shadingModes[id]);
-                        if (!md.clippingModes.empty())
-                            material->updateProperty(
-                                MATERIAL_PROPERTY_CLIPPING_MODE,
-                                md.clippingModes[id]);
-                        if (!md.userParameters.empty())
-                            material->updateProperty(
-                                MATERIAL_PROPERTY_USER_PARAMETER,
-                                static_cast<double>(md.userParameters[id]));
-                        material->markModified(); // This is needed to apply
-                                                  // propery modifications
-                        material->commit();
-                    }
-                }
-                catch (const std::runtime_error& e)
-                {
-                    PLUGIN_INFO << e.what() << std::endl;
-                }
-                ++id;
+                PLUGIN_INFO << "Material " << md.materialIds[id]
+                            << " is not registered in model " << modelId
+                            << std::endl;
+                continue;
+            }
+
+            auto& material = *it->second;
+            try
+            {
+                const size_t index = id * 3;
+                if (!md.diffuseColors.empty())
+                    material.setDiffuseColor({md.diffuseColors[index],
+                                              md.diffuseColors[index + 1],
+                                              md.diffuseColors[index + 2]});
+                if (!md.specularColors.empty())
+                    material.setSpecularColor({md.specularColors[index],
+                                               md.specularColors[index + 1],
+                                               md.specularColors[index + 2]});
+                if (!md.specularExponents.empty())
+                    material.setSpecularExponent(md.specularExponents[id]);
+                if (!md.reflectionIndices.empty())
+                    material.setReflectionIndex(md.reflectionIndices[id]);
+                if (!md.opacities.empty())
+                    material.setOpacity(md.opacities[id]);
+                if (!md.refractionIndices.empty())
+                    material.setRefractionIndex(md.refractionIndices[id]);
+                if (!md.emissions.empty())
+                    material.setEmission(md.emissions[id]);
+                if (!md.glossinesses.empty())
+                    material.setGlossiness(md.glossinesses[id]);
+                if (!md.simulationDataCasts.empty())
+                    material.updateProperty(MATERIAL_PROPERTY_CAST_USER_DATA,
+                                            static_cast<bool>(
+                                                md.simulationDataCasts[id]),
+                                            false);
+                if (!md.shadingModes.empty())
+                    material.updateProperty(MATERIAL_PROPERTY_SHADING_MODE,
+                                            md.shadingModes[id], false);
+                if (!md.clippingModes.empty())
+                    material.updateProperty(MATERIAL_PROPERTY_CLIPPING_MODE,
+                                            md.clippingModes[id], false);
+                if (!md.userParameters.empty())
+                    material.updateProperty(
+                        MATERIAL_PROPERTY_USER_PARAMETER,
+                        static_cast<double>(md.userParameters[id]), false);
+            }
+            catch (const std::runtime_error& e)
+            {
+                PLUGIN_INFO << e.what() << std::endl;
             }
-            _dirty = true;
         }
-        else
-            PLUGIN_INFO << "Model " << modelId << " is not registered"
-                        << std::endl;
+        _dirty = true;
     }
 }
 
@@ -24,6 +24,10 @@
 
 #include <common/log.h>
 
+#include <brayns/common/utils/base64/base64.h>
+
+#include <cstring>
+
 #ifndef BRAYNS_DEBUG_JSON_ENABLED
 #define FROM_JSON(PARAM, JSON, NAME) \
     PARAM.NAME = JSON[#NAME].get<decltype(PARAM.NAME)>()
@@ -38,6 +42,55 @@
     }
 #endif
 #define TO_JSON(PARAM, JSON, NAME) JSON[#NAME] = PARAM.NAME
+#define FROM_JSON_COLUMN(PARAM, JSON, NAME) \
+    fromJsonColumn(JSON[#NAME], PARAM.NAME)
+
+namespace
+{
+/**
+ * Columns of bulk requests are either regular JSON arrays, or base64 encoded
+ * strings of densely packed little-endian values of the column type, which
+ * spares the JSON number parsing for large arrays.
+ */
+std::string decodePackedColumn(const nlohmann::json& value,
+                               const size_t elementSize)
+{
+    auto bytes = base64_decode(value.get<std::string>());
+    if (bytes.size() % elementSize != 0)
+        throw std::runtime_error("Packed column size is not a multiple of " +
+                                 std::to_string(elementSize) + " bytes");
+    return bytes;
+}
+
+template <typename T>
+void fromJsonColumn(const nlohmann::json& value, std::vector<T>& column)
+{
+    if (!value.is_string())
+    {
+        column = value.get<std::vector<T>>();
+        return;
+    }
+
+    const auto bytes = decodePackedColumn(value, sizeof(T));
+    column.resize(bytes.size() / sizeof(T));
+    std::memcpy(column.data(), bytes.data(), bytes.size());
+}
+
+void fromJsonColumn(const nlohmann::json& value, std::vector<bool>& column)
+{
+    if (!value.is_string())
+    {
+        column = value.get<std::vector<bool>>();
+        return;
+    }
+
+    // Booleans are packed as one byte per value
+    const auto bytes = decodePackedColumn(value, sizeof(uint8_t));
+    column.resize(bytes.size());
+    for (size_t i = 0; i < bytes.size(); ++i)
+        column[i] = bytes[i] != 0;
+}
+} // namespace
 
 bool from_json(Result& param, const std::string& payload)
 {
@@ -119,20 +172,20 @@ bool from_json(MaterialsDescriptor& param, const std::string& payload)
     try
     {
         auto js = nlohmann::json::parse(payload);
-        FROM_JSON(param, js, modelIds);
-        FROM_JSON(param, js, materialIds);
-        FROM_JSON(param, js, diffuseColors);
-        FROM_JSON(param, js, specularColors);
-        FROM_JSON(param, js, specularExponents);
-        FROM_JSON(param, js, reflectionIndices);
-        FROM_JSON(param, js, opacities);
-        FROM_JSON(param, js, refractionIndices);
-        FROM_JSON(param, js, emissions);
-        FROM_JSON(param, js, glossinesses);
-        FROM_JSON(param, js, simulationDataCasts);
-        FROM_JSON(param, js, shadingModes);
-        FROM_JSON(param, js, clippingModes);
-        FROM_JSON(param, js, userParameters);
+        FROM_JSON_COLUMN(param, js, modelIds);
+        FROM_JSON_COLUMN(param, js, materialIds);
+        FROM_JSON_COLUMN(param, js, diffuseColors);
+        FROM_JSON_COLUMN(param, js, specularColors);
+        FROM_JSON_COLUMN(param, js, specularExponents);
+        FROM_JSON_COLUMN(param, js, reflectionIndices);
+        FROM_JSON_COLUMN(param, js, opacities);
+        FROM_JSON_COLUMN(param, js, refractionIndices);
+        FROM_JSON_COLUMN(param, js, emissions);
+        FROM_JSON_COLUMN(param, js, glossinesses);
+        FROM_JSON_COLUMN(param, js, simulationDataCasts);
+        FROM_JSON_COLUMN(param, js, shadingModes);
+        FROM_JSON_COLUMN(param, js, clippingModes);
+        FROM_JSON_COLUMN(param, js, userParameters);
     }
     catch (...)
     {
@@ -63,6 +63,13 @@ struct MaterialDescriptor
 bool from_json(MaterialDescriptor& materialDescriptor,
                const std::string& payload);
 
+/**
+ * Bulk material update. All attributes are dense columns indexed like
+ * materialIds (colors use 3 consecutive values per material), and empty
+ * columns leave the corresponding attribute untouched. Each column can also be
+ * sent as a base64 string of packed little-endian values (float32, int32, and
+ * one byte per boolean).
+ */
 struct MaterialsDescriptor
 {
     std::vector<int32_t> modelIds;
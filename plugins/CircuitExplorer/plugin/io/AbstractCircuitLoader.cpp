@@ -220,6 +220,10 @@ CompartmentReportPtr AbstractCircuitLoader::_attachSimulationHandler(
         auto handler =
             std::make_shared<VoltageSimulationHandler>(voltageReport.getPath(),
                                                        gids, synchronousMode);
+        handler->setEncoding(stringToEnum<brayns::SimulationDataEncoding>(
+            properties.getProperty<std::string>(
+                PROP_SIMULATION_ENCODING.name,
+                ::enumToString(brayns::SimulationDataEncoding::float32))));
         compartmentReport = handler->getReport();
 
         // Only keep simulated GIDs
@@ -608,6 +612,22 @@ void AbstractCircuitLoader::_importMeshes(
     const auto meshTransformation =
         properties.getProperty<bool>(PROP_MESH_TRANSFORMATION.name);
 
+    brayns::GeometryQuality quality;
+    switch (morphologyQuality)
+    {
+    case MorphologyQuality::low:
+        quality = brayns::GeometryQuality::low;
+        break;
+    case MorphologyQuality::medium:
+        quality = brayns::GeometryQuality::medium;
+        break;
+    default:
+        quality = brayns::GeometryQuality::high;
+        break;
+    }
+
+    std::vector<brayns::MeshFile> files;
+    files.reserve(gids.size());
     size_t meshIndex = 0;
     for (const auto &gid : gids)
     {
@@ -619,34 +639,17 @@ void AbstractCircuitLoader::_importMeshes(
         const auto transformation = meshTransformation
                                         ? transformations[meshIndex]
                                         : brayns::Matrix4f();
-
-        brayns::GeometryQuality quality;
-        switch (morphologyQuality)
-        {
-        case MorphologyQuality::low:
-            quality = brayns::GeometryQuality::low;
-            break;
-        case MorphologyQuality::medium:
-            quality = brayns::GeometryQuality::medium;
-            break;
-        default:
-            quality = brayns::GeometryQuality::high;
-            break;
-        }
-        try
-        {
-            meshLoader.importMesh(_getMeshFilenameFromGID(properties, gid),
-                                  brayns::LoaderProgress(), model,
-                                  transformation, materialId, quality);
-        }
-        catch (const std::runtime_error &e)
-        {
-            PLUGIN_WARN << e.what() << std::endl;
-        }
+        files.push_back({_getMeshFilenameFromGID(properties, gid),
+                         transformation, materialId});
         ++meshIndex;
-        callback.updateProgress("Loading morphologies as meshes...",
-                                (float)meshIndex / (float)gids.size());
     }
+
+    // Meshes are imported concurrently, failures only skip the cell
+    const auto errors =
+        meshLoader.importMeshes(files, model, quality, callback);
+    for (const auto &error : errors)
+        PLUGIN_WARN << error << std::endl;
+
     // Add custom properties to materials
     for (auto &material : model.getMaterials())
     {
@@ -59,6 +59,9 @@ public:
     bool isSupported(const std::string &filename,
                      const std::string &extension) const;
 
+    /** Morphologies and reports are read from the files of the circuit */
+    bool isCacheable(const std::string &) const final { return false; }
+
     brayns::ModelDescriptorPtr importFromBlob(
         brayns::Blob &&blob, const brayns::LoaderProgress &callback,
         const brayns::PropertyMap &properties) const;
@@ -93,6 +93,7 @@ brayns::PropertyMap MeshCircuitLoader::getCLIProperties()
     pm.setProperty(PROP_DENSITY);
     pm.setProperty(PROP_REPORT);
     pm.setProperty(PROP_SYNCHRONOUS_MODE);
+    pm.setProperty(PROP_SIMULATION_ENCODING);
     pm.setProperty(PROP_TARGETS);
     pm.setProperty(PROP_GIDS);
     pm.setProperty(PROP_RANDOM_SEED);
@@ -0,0 +1,88 @@
+/* Copyright (c) 2018-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ * Responsible Author: Cyrille Favreau <cyrille.favreau@epfl.ch>
+ *
+ * This file is part of the circuit explorer for Brayns
+ * <https://github.com/favreau/Brayns-UC-CircuitExplorer>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef CIRCUIT_EXPLORER_SPIKEFRAME_H
+#define CIRCUIT_EXPLORER_SPIKEFRAME_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** A spike of the cell at the given index in the frame */
+struct Spike
+{
+    float time;
+    uint32_t cell;
+};
+using Spikes = std::vector<Spike>;
+
+/** How the value of a cell changes around its spikes */
+struct SpikeDecay
+{
+    float restValue;
+    float spikingValue;
+    /** Value lost per frame after the spike */
+    float decaySpeed;
+    /** Spikes are shown from this long before they happen */
+    float anticipation;
+};
+
+/**
+ * Computes the values of the cells at a frame from spikes sorted by time.
+ *
+ * Only the spikes in the decay window of the frame are read and the previous
+ * content of data is ignored, so the frame is the same whether it is reached
+ * by playing forward, backward or by seeking.
+ */
+inline void computeSpikeFrame(const Spikes& spikes, const uint32_t frame,
+                              const double dt, const SpikeDecay& decay,
+                              float* data, const size_t size)
+{
+    const double decayFrames =
+        (decay.spikingValue - decay.restValue) / decay.decaySpeed;
+    const double ts = frame * dt;
+    const auto byTime = [](const Spike& spike, const double time) {
+        return spike.time < time;
+    };
+    const auto begin = std::lower_bound(spikes.begin(), spikes.end(),
+                                        ts - (decayFrames + 1.) * dt, byTime);
+    const auto end =
+        std::lower_bound(begin, spikes.end(), ts + decay.anticipation, byTime);
+
+    const auto nbCells = static_cast<int64_t>(size);
+#pragma omp parallel for
+    for (int64_t i = 0; i < nbCells; ++i)
+        data[i] = decay.restValue;
+
+    for (auto spike = begin; spike != end; ++spike)
+    {
+        const double spikeFrame = std::floor(spike->time / dt);
+        const double elapsed = spike->time >= ts ? 0. : frame - spikeFrame;
+        const float value =
+            std::max<float>(decay.restValue,
+                            decay.spikingValue - decay.decaySpeed * elapsed);
+        data[spike->cell] = std::max(data[spike->cell], value);
+    }
+}
+
+#endif // CIRCUIT_EXPLORER_SPIKEFRAME_H
@@ -24,12 +24,20 @@
 #include "SpikeSimulationHandler.h"
 #include <brayns/parameters/AnimationParameters.h>
 
+#include <algorithm>
+
 namespace
 {
 const float DEFAULT_REST_VALUE = -80.f;
 const float DEFAULT_SPIKING_VALUE = -1.f;
 const float DEFAULT_TIME_INTERVAL = 0.01f;
 const float DEFAULT_DECAY_SPEED = 1.f;
+
+// Spikes are shown from this long before they happen
+const float SPIKE_ANTICIPATION = 1.f;
+
+const SpikeDecay SPIKE_DECAY{DEFAULT_REST_VALUE, DEFAULT_SPIKING_VALUE,
+                             DEFAULT_DECAY_SPEED, SPIKE_ANTICIPATION};
 } // namespace
 
 SpikeSimulationHandler::SpikeSimulationHandler(const std::string& reportPath,
@@ -39,12 +47,7 @@ SpikeSimulationHandler::SpikeSimulationHandler(const std::string& reportPath,
     , _gids(gids)
     , _spikeReport(new brain::SpikeReportReader(brain::URI(reportPath), gids))
 {
-    uint64_t c{0};
-    for (const auto gid : _gids)
-    {
-        _gidMap[gid] = c;
-        ++c;
-    }
+    _loadSpikes();
 
     // Load simulation information from compartment reports
     _nbFrames = _spikeReport->getEndTime() / DEFAULT_TIME_INTERVAL;
@@ -65,6 +68,7 @@ SpikeSimulationHandler::SpikeSimulationHandler(const std::string& reportPath,
     PLUGIN_INFO << "Decay speed           : " << DEFAULT_DECAY_SPEED
                 << std::endl;
     PLUGIN_INFO << "Number of frames      : " << _nbFrames << std::endl;
+    PLUGIN_INFO << "Number of spikes      : " << _spikes->size() << std::endl;
     PLUGIN_INFO << "-----------------------------------------------------------"
                 << std::endl;
 }
@@ -75,8 +79,31 @@ SpikeSimulationHandler::SpikeSimulationHandler(
     , _reportPath(rhs._reportPath)
     , _gids(rhs._gids)
     , _spikeReport(rhs._spikeReport)
-    , _gidMap(rhs._gidMap)
+    , _spikes(rhs._spikes)
+{
+}
+
+void SpikeSimulationHandler::_loadSpikes()
 {
+    // GIDs are sorted, their index in the frame is found by bisection
+    const std::vector<uint32_t> gids(_gids.begin(), _gids.end());
+
+    auto spikes = std::make_shared<Spikes>();
+    const auto& reportSpikes =
+        _spikeReport->getSpikes(0.f, _spikeReport->getEndTime());
+    spikes->reserve(reportSpikes.size());
+    for (const auto& spike : reportSpikes)
+    {
+        const auto i = std::lower_bound(gids.begin(), gids.end(), spike.second);
+        if (i != gids.end() && *i == spike.second)
+            spikes->push_back(
+                {spike.first, static_cast<uint32_t>(i - gids.begin())});
+    }
+    std::stable_sort(spikes->begin(), spikes->end(),
+                     [](const Spike& a, const Spike& b) {
+                         return a.time < b.time;
+                     });
+    _spikes = spikes;
 }
 
 void* SpikeSimulationHandler::getFrameData(const uint32_t frame)
@@ -84,23 +111,8 @@ void* SpikeSimulationHandler::getFrameData(const uint32_t frame)
     const auto boundedFrame = _getBoundedFrame(frame);
     if (_currentFrame != boundedFrame)
     {
-        for (size_t i = 0; i < _frameSize; ++i)
-        {
-            if (_frameData[i] > DEFAULT_REST_VALUE)
-                _frameData[i] -= DEFAULT_DECAY_SPEED;
-            else
-                _frameData[i] = DEFAULT_REST_VALUE;
-        }
-
-        const float ts = boundedFrame * _dt;
-        const float endTime = _spikeReport->getEndTime() - _dt;
-        const auto& spikes =
-            _spikeReport->getSpikes(std::min(ts, endTime),
-                                    std::min(ts + 1.f, endTime));
-
-        for (const auto spike : spikes)
-            _frameData[_gidMap[spike.second]] = DEFAULT_SPIKING_VALUE;
-
+        computeSpikeFrame(*_spikes, boundedFrame, _dt, SPIKE_DECAY,
+                          _frameData.data(), _frameSize);
         _currentFrame = boundedFrame;
     }
 
@@ -28,6 +28,8 @@
 #include <brayns/common/types.h>
 #include <brayns/engine/Scene.h>
 
+#include "SpikeFrame.h"
+
 typedef std::shared_ptr<brain::SpikeReportReader> SpikeReportReaderPtr;
 
 class SpikeSimulationHandler : public brayns::AbstractSimulationHandler
@@ -45,11 +47,15 @@ public:
     brayns::AbstractSimulationHandlerPtr clone() const final;
 
 private:
+    void _loadSpikes();
+
     std::string _reportPath;
     brain::GIDSet _gids;
     SpikeReportReaderPtr _spikeReport;
 
-    std::map<uint64_t, uint64_t> _gidMap;
+    // All the spikes of the report sorted by time, shared by the clones. Any
+    // frame is computed from the spikes in its decay window only.
+    std::shared_ptr<const Spikes> _spikes;
 };
 
 #endif // SPIKESIMULATIONHANDLER_H
@@ -48,6 +48,8 @@ public:
 
     bool isSupported(const std::string& filename,
                      const std::string& extension) const final;
+    /** Morphologies and reports are read from the files of the circuit */
+    bool isCacheable(const std::string&) const final { return false; }
 
     ModelDescriptorPtr importFromBlob(
         Blob&& blob, const LoaderProgress& callback,
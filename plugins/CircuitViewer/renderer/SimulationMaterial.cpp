@@ -43,10 +43,12 @@ int SimulationMaterial_getBytesPerPrimitive(const void* geometry)
 {
     const ospray::Geometry* base =
         static_cast<const ospray::Geometry*>(geometry);
-    if (dynamic_cast<const ospray::Spheres*>(base))
-        return sizeof(brayns::Sphere);
-    else if (dynamic_cast<const ospray::Cylinders*>(base))
-        return sizeof(brayns::Cylinder);
+    // Spheres and cylinders may carry a material index after the brayns
+    // primitive, use the stride they were committed with
+    if (auto spheres = dynamic_cast<const ospray::Spheres*>(base))
+        return static_cast<int>(spheres->bytesPerSphere);
+    else if (auto cylinders = dynamic_cast<const ospray::Cylinders*>(base))
+        return static_cast<int>(cylinders->bytesPerCylinder);
     else if (dynamic_cast<const ospray::Cones*>(base))
         return sizeof(brayns::Cone);
     else if (dynamic_cast<const ospray::SDFGeometries*>(base))
@@ -29,7 +29,14 @@ void SimulationRenderer::commit()
 {
     AbstractRenderer::commit();
 
+    // Integer encodings are normalized to the simulation data range, see
+    // brayns::SimulationDataEncoding
     _simulationData = getParamData("simulationData");
+    const int encoding = getParam1i("simulationDataEncoding", 0);
+    const ospray::vec2f range =
+        getParam2f("simulationDataRange", ospray::vec2f(0.f, 1.f));
+    ispc::SimulationRenderer_setSimulationEncoding(getIE(), encoding, range.x,
+                                                   range.y);
     _alphaCorrection = getParam1f("alphaCorrection", 0.5f);
 
     ospray::TransferFunction* transferFunction =
@@ -38,7 +45,9 @@ void SimulationRenderer::commit()
         ispc::SimulationRenderer_setTransferFunction(getIE(),
                                                      transferFunction->getIE());
 
-    _simulationDataSize = _simulationData ? _simulationData->size() : 0;
+    const size_t bytesPerValue = encoding == 1 ? 2 : encoding == 2 ? 1 : 4;
+    _simulationDataSize =
+        _simulationData ? _simulationData->numBytes / bytesPerValue : 0;
 }
 
 } // ::brayns
@@ -44,6 +44,8 @@ public:
 
     bool isSupported(const std::string& filename,
                      const std::string& extension) const final;
+    /** The streamlines are read from the files listed in the configuration */
+    bool isCacheable(const std::string&) const final { return false; }
 
     static brayns::PropertyMap getCLIProperties();
 
@@ -25,58 +25,101 @@
 
 #include <engines/ospray/utils.h>
 
+// ispc exports
+#include "DeflectPixelOp_ispc.h"
+
+#include <chrono>
+#include <iostream>
+
 namespace
 {
-std::future<bool> make_ready_future()
-{
-    std::promise<bool> promise;
-    promise.set_value(true);
-    return promise.get_future();
-}
+const size_t ALIGNMENT = 64;
 
-#pragma omp declare simd
-inline unsigned char clampCvt(float f)
-{
-    if (f < 0.f)
-        f = 0.f;
-    if (f > 1.f)
-        f = 1.f;
-    return f * 255.f + .5f;
-}
+// The sender thread checks for new tiles at this interval during a frame
+const auto SENDER_INTERVAL = std::chrono::milliseconds(1);
 
-const size_t ALIGNMENT = 64;
+// Index of the tile threads, to find their queue without locking
+std::atomic<size_t> nextThreadIndex{0};
+thread_local const size_t threadIndex = nextThreadIndex++;
 }
 
 namespace brayns
 {
+constexpr size_t DeflectPixelOp::Instance::MAX_THREADS;
+
 DeflectPixelOp::Instance::Instance(ospray::FrameBuffer* fb_,
                                    DeflectPixelOp& parent)
     : _parent(parent)
 {
     fb = fb_;
+    for (auto& queue : _queues)
+        queue = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(_parent._mutex);
+        _parent._instances.insert(this);
+    }
+    _sender = std::thread(&Instance::_sendTiles, this);
 }
 
-DeflectPixelOp::Instance::~Instance() = default;
+DeflectPixelOp::Instance::~Instance()
+{
+    {
+        std::lock_guard<std::mutex> lock(_parent._mutex);
+        _parent._instances.erase(this);
+    }
+    finish();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _condition.notify_all();
+    _sender.join();
+
+    for (auto& queue : _queues)
+        delete queue.load();
+}
 
 void DeflectPixelOp::Instance::beginFrame()
 {
     if (!_parent._deflectStream)
         return;
+
+    _renderRegions.update(fb);
+
     const size_t numTiles = fb->getTotalTiles();
-    if (_pixels.size() < numTiles)
+    const auto& params = _parent._params;
+    const auto name = fb->getParamString("name");
     {
-        _pixels.resize(numTiles);
+        // At most one frame is sent while the next one is rendered, so the
+        // tile threads never wait for the sender
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this] { return _frame <= _framesSent + 1; });
 
-        for (auto& i : _pixels)
+        if (_pixels.size() < 2 * numTiles)
         {
-            if (i)
-                continue;
-
-            i.reset((unsigned char*)_mm_malloc(TILE_SIZE * TILE_SIZE * 4,
-                                               ALIGNMENT));
-            memset(i.get(), 255, TILE_SIZE * TILE_SIZE * 4);
+            _pixels.resize(2 * numTiles);
+            for (auto& i : _pixels)
+            {
+                if (!i)
+                    i.reset((unsigned char*)_mm_malloc(TILE_SIZE * TILE_SIZE *
+                                                           4,
+                                                       ALIGNMENT));
+            }
         }
+
+        _settings[_frame % 2] = {utils::getView(name),
+                                 utils::getChannel(name),
+                                 params.getCompression(),
+                                 params.getQuality(),
+                                 params.getChromaSubsampling(),
+                                 params.isTopDown()
+                                     ? deflect::RowOrder::top_down
+                                     : deflect::RowOrder::bottom_up};
+        ++_frame;
     }
+    _condition.notify_all();
 }
 
 void DeflectPixelOp::Instance::endFrame()
@@ -84,14 +127,16 @@ void DeflectPixelOp::Instance::endFrame()
     if (!_parent._deflectStream)
         return;
 
-    auto sharedFuture = _parent._deflectStream->finishFrame().share();
-    for (auto& i : _parent._finishFutures)
-        i.second = sharedFuture;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_framesEnded;
+    }
+    _condition.notify_all();
 }
 
 void DeflectPixelOp::Instance::postAccum(ospray::Tile& tile)
 {
-    if (!_parent._deflectStream)
+    if (!_parent._deflectStream || !_renderRegions.contains(tile))
         return;
 
     const auto& fbSize = fb->getNumPixels();
@@ -102,110 +147,126 @@ void DeflectPixelOp::Instance::postAccum(ospray::Tile& tile)
     if (tile.region.lower.y + TILE_SIZE > fbSize.y)
         tileSize.y = fbSize.y % TILE_SIZE;
 
-    deflect::ImageWrapper image(_copyPixels(tile, tileSize), tileSize.x,
-                                tileSize.y, deflect::RGBA, tile.region.lower.x,
-                                tile.region.lower.y);
-    image.compressionPolicy = _parent._params.getCompression()
-                                  ? deflect::COMPRESSION_ON
-                                  : deflect::COMPRESSION_OFF;
-    image.compressionQuality = _parent._params.getQuality();
-    image.subsampling = _parent._params.getChromaSubsampling();
-    image.rowOrder = _parent._params.isTopDown() ? deflect::RowOrder::top_down
-                                                 : deflect::RowOrder::bottom_up;
-
-    const auto name = fb->getParamString("name");
-    image.view = utils::getView(name);
-    image.channel = utils::getChannel(name);
-
-    try
-    {
-        auto i = _parent._finishFutures.find(pthread_self());
-        if (i == _parent._finishFutures.end())
-        {
-            // only for the first frame
-            std::lock_guard<std::mutex> _lock(_parent._mutex);
-            _parent._finishFutures.insert(
-                {pthread_self(), make_ready_future()});
-        }
-        else
-            i->second.wait(); // complete previous frame
+    _push({_frame - 1, _copyPixels(tile, tileSize), tile.region.lower,
+           tileSize});
+}
 
-        _parent._deflectStream->send(image).get();
-    }
-    catch (const std::exception& exc)
-    {
-        std::cerr << "Encountered error during sendImage: " << exc.what()
-                  << std::endl;
-    }
+void DeflectPixelOp::Instance::finish()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this] { return _framesSent == _framesEnded; });
 }
 
 unsigned char* DeflectPixelOp::Instance::_copyPixels(
     ospray::Tile& tile, const ospray::vec2i& tileSize)
 {
+    const size_t numTiles = fb->getTotalTiles();
     const size_t tileID =
         tile.region.lower.y / TILE_SIZE * fb->getNumTiles().x +
         tile.region.lower.x / TILE_SIZE;
+    auto pixels = _pixels[(_frame - 1) % 2 * numTiles + tileID].get();
+
+    // Vectorized for the widest instruction set of the CPU, which is selected
+    // at runtime
+    ispc::DeflectPixelOp_convertTile(tile.r, tile.g, tile.b, TILE_SIZE,
+                                     tileSize.x, tileSize.y,
+                                     (uint32_t*)pixels);
+    return pixels;
+}
+
+void DeflectPixelOp::Instance::_push(const Tile& tile)
+{
+    const size_t index = std::min(threadIndex, MAX_THREADS - 1);
+    std::unique_lock<std::mutex> lock(_sharedQueueMutex, std::defer_lock);
+    if (index == MAX_THREADS - 1)
+        lock.lock();
 
-#ifdef __GNUC__
-    unsigned char* __restrict__ pixels =
-        (unsigned char*)__builtin_assume_aligned(_pixels[tileID].get(),
-                                                 ALIGNMENT);
-#else
-    unsigned char* __restrict__ pixels = _pixels[tileID].get();
-#endif
-    float* __restrict__ red = tile.r;
-    float* __restrict__ green = tile.g;
-    float* __restrict__ blue = tile.b;
-
-    if (tileSize.x < TILE_SIZE)
+    auto queue = _queues[index].load(std::memory_order_acquire);
+    if (!queue)
+    {
+        queue = new TileQueue(2 * fb->getTotalTiles());
+        _queues[index].store(queue, std::memory_order_release);
+    }
+
+    // Never full, as the queue holds the tiles of two frames
+    while (!queue->push(tile))
+        std::this_thread::yield();
+}
+
+void DeflectPixelOp::Instance::_sendTiles()
+{
+    std::vector<std::future<bool>> sends;
+    while (_running)
     {
-        int index = 0;
-        for (int i = 0; i < tileSize.y; ++i)
+        // Read before the queues: all the tiles of an ended frame are queued
+        const size_t framesEnded = _framesEnded;
+        const size_t frame = _framesSent;
+
+        // Tiles of the next frame stay queued until this one is finished
+        for (auto& slot : _queues)
         {
-            for (int j = 0; j < tileSize.x; ++j)
+            auto queue = slot.load(std::memory_order_acquire);
+            if (!queue)
+                continue;
+
+            while (const auto tile = queue->front())
             {
-                pixels[index + 0] = clampCvt(red[i * TILE_SIZE + j]);
-                pixels[index + 1] = clampCvt(green[i * TILE_SIZE + j]);
-                pixels[index + 2] = clampCvt(blue[i * TILE_SIZE + j]);
-                index += 4;
+                if (tile->frame != frame)
+                    break;
+
+                const auto& settings = _settings[frame % 2];
+                deflect::ImageWrapper image(tile->pixels, tile->size.x,
+                                            tile->size.y, deflect::RGBA,
+                                            tile->position.x,
+                                            tile->position.y);
+                image.compressionPolicy = settings.compression
+                                              ? deflect::COMPRESSION_ON
+                                              : deflect::COMPRESSION_OFF;
+                image.compressionQuality = settings.quality;
+                image.subsampling = settings.subsampling;
+                image.rowOrder = settings.rowOrder;
+                image.view = settings.view;
+                image.channel = settings.channel;
+                sends.push_back(_parent._deflectStream->send(image));
+                queue->pop();
             }
         }
-        return pixels;
-    }
 
-// clang-format off
-    // AVX vectorization with icc 17 reports (create with -qopt-report=5)
-    //LOOP BEGIN at ../plugins/engines/ospray/modules/deflect/DeflectPixelOp.cpp(130,16)
-    //   remark #15388: vectorization support: reference red[i] has aligned access
-    //   remark #15388: vectorization support: reference green[i] has aligned access
-    //   remark #15388: vectorization support: reference blue[i] has aligned access
-    //   remark #15329: vectorization support: non-unit strided store was emulated for the variable <U137_V[i*4]>, stride is 4
-    //   remark #15329: vectorization support: non-unit strided store was emulated for the variable <U137_V[i*4+1]>, stride is 4
-    //   remark #15329: vectorization support: non-unit strided store was emulated for the variable <U137_V[i*4+2]>, stride is 4
-    //   remark #15305: vectorization support: vector length 32
-    //   remark #15301: OpenMP SIMD LOOP WAS VECTORIZED
-    //   remark #15448: unmasked aligned unit stride loads: 3
-    //   remark #15453: unmasked strided stores: 3
-    //   remark #15475: --- begin vector cost summary ---
-    //   remark #15476: scalar cost: 56
-    //   remark #15477: vector cost: 9.460
-    //   remark #15478: estimated potential speedup: 5.910
-    //   remark #15487: type converts: 3
-    //   remark #15488: --- end vector cost summary ---
-    //   remark #25015: Estimate of max trip count of loop=128
-    //LOOP END
-// clang-format on
-#ifdef __INTEL_COMPILER
-#pragma vector aligned
-#endif
-#pragma omp simd
-    for (int i = 0; i < TILE_SIZE * TILE_SIZE; ++i)
-    {
-        pixels[i * 4 + 0] = clampCvt(red[i]);
-        pixels[i * 4 + 1] = clampCvt(green[i]);
-        pixels[i * 4 + 2] = clampCvt(blue[i]);
+        if (framesEnded > frame)
+        {
+            try
+            {
+                for (auto& send : sends)
+                    send.get();
+                _parent._deflectStream->finishFrame().get();
+            }
+            catch (const std::exception& exc)
+            {
+                std::cerr << "Encountered error during sendImage: "
+                          << exc.what() << std::endl;
+            }
+            sends.clear();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                ++_framesSent;
+            }
+            _condition.notify_all();
+            continue;
+        }
+
+        // Check for new tiles during a frame, sleep between the frames
+        std::unique_lock<std::mutex> lock(_mutex);
+        const auto woken = [this, framesEnded, frame] {
+            return !_running || _framesEnded > framesEnded;
+        };
+        if (_frame > frame)
+            _condition.wait_for(lock, SENDER_INTERVAL, woken);
+        else
+            _condition.wait(lock, [this, frame, &woken] {
+                return woken() || _frame > frame;
+            });
     }
-    return pixels;
 }
 
 void DeflectPixelOp::commit()
@@ -242,9 +303,9 @@ ospray::PixelOp::Instance* DeflectPixelOp::createInstance(
 
 void DeflectPixelOp::_finish()
 {
-    for (auto& i : _finishFutures)
-        i.second.wait();
-    _finishFutures.clear();
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto instance : _instances)
+        instance->finish();
 }
 }
 
@@ -21,17 +21,29 @@
 #pragma once
 
 #include "DeflectParameters.h"
+#include "LockFreeQueue.h"
 
 #include <deflect/Stream.h>
-#include <map>
+#include <engines/ospray/ispc/render/utils/RenderRegions.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
 #include <ospray/SDK/fb/PixelOp.h>
 
 namespace brayns
 {
 /**
  * Implements an ospray pixel op that streams each tile to a Deflect server
- * instance. The tiles are compressed directly on the tile thread and then
- * enqueued for sending.
+ * instance. The tiles are converted to RGBA8 on the tile thread and enqueued
+ * without locking, a sender thread per framebuffer hands them to the stream
+ * so that the tile threads never wait for the network.
  *
  * The ospray module to load is called "deflect", and the pixel op name for
  * creating it is "DeflectPixelOp".
@@ -54,12 +66,63 @@ public:
         };
         using Pixels = std::unique_ptr<unsigned char, PixelsDeleter>;
 
+        /** Wait until all the ended frames are sent. */
+        void finish();
+
     private:
+        /** A converted tile waiting to be sent. */
+        struct Tile
+        {
+            size_t frame;
+            const unsigned char* pixels;
+            ospray::vec2i position;
+            ospray::vec2i size;
+        };
+        using TileQueue = LockFreeQueue<Tile>;
+
+        /** Stream settings of a frame, read on the sender thread. */
+        struct FrameSettings
+        {
+            deflect::View view;
+            uint8_t channel;
+            bool compression;
+            unsigned quality;
+            deflect::ChromaSubsampling subsampling;
+            deflect::RowOrder rowOrder;
+        };
+
+        /**
+         * Number of tile queues, the threads beyond share the last one and
+         * push to it under a lock.
+         */
+        static constexpr size_t MAX_THREADS = 1024;
+
         DeflectPixelOp& _parent;
+
+        // Two sets of tile pixels, for the frame being rendered and the one
+        // being sent
         std::vector<Pixels> _pixels;
+        std::array<FrameSettings, 2> _settings;
+
+        // Tiles outside of the regions are not rendered, nor streamed
+        RenderRegions _renderRegions;
+
+        // Created by their thread on its first tile
+        std::array<std::atomic<TileQueue*>, MAX_THREADS> _queues;
+        std::mutex _sharedQueueMutex;
+
+        std::atomic<size_t> _frame{0};
+        std::atomic<size_t> _framesEnded{0};
+        std::atomic<size_t> _framesSent{0};
+        std::atomic<bool> _running{true};
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::thread _sender;
 
         unsigned char* _copyPixels(ospray::Tile& tile,
                                    const ospray::vec2i& tileSize);
+        void _push(const Tile& tile);
+        void _sendTiles();
     };
 
     /**
@@ -81,7 +144,7 @@ private:
     void _finish();
 
     std::unique_ptr<deflect::Stream> _deflectStream;
-    std::map<pthread_t, std::shared_future<bool>> _finishFutures;
+    std::set<Instance*> _instances;
     std::mutex _mutex;
     DeflectParameters _params;
 };
@@ -0,0 +1,74 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+namespace brayns
+{
+/**
+ * A bounded queue for one producer and one consumer thread, which never
+ * blocks or locks either of them.
+ */
+template <typename T>
+class LockFreeQueue
+{
+public:
+    explicit LockFreeQueue(const size_t capacity)
+        : _items(capacity + 1)
+    {
+    }
+
+    /** Producer side: @return false if the queue is full. */
+    bool push(const T& item)
+    {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+        const auto next = (tail + 1) % _items.size();
+        if (next == _head.load(std::memory_order_acquire))
+            return false;
+        _items[tail] = item;
+        _tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer side: @return the oldest item, nullptr if the queue is empty */
+    const T* front() const
+    {
+        const auto head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire))
+            return nullptr;
+        return &_items[head];
+    }
+
+    /** Consumer side: remove the oldest item, the queue must not be empty. */
+    void pop()
+    {
+        const auto head = _head.load(std::memory_order_relaxed);
+        _head.store((head + 1) % _items.size(), std::memory_order_release);
+    }
+
+private:
+    std::vector<T> _items;
+    // On separate cache lines, as each is written by a different thread
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+};
+} // namespace brayns
@@ -0,0 +1,153 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "AdaptiveImageStream.h"
+
+#include <algorithm>
+
+namespace brayns
+{
+namespace
+{
+// Frames in flight for longer are considered lost, e.g. because the client
+// stopped acknowledging them
+const auto IN_FLIGHT_TIMEOUT = std::chrono::seconds(5);
+} // namespace
+
+constexpr size_t AdaptiveImageStream::MAX_QUEUED_FRAMES;
+constexpr size_t AdaptiveImageStream::SKIPS_TO_DEGRADE;
+constexpr size_t AdaptiveImageStream::FRAMES_TO_UPGRADE;
+
+const std::vector<AdaptiveImageStream::Tier>& AdaptiveImageStream::getTiers()
+{
+    static const std::vector<Tier> tiers{{1, 100}, {1, 60}, {2, 60}, {4, 40}};
+    return tiers;
+}
+
+std::map<size_t, std::vector<uintptr_t>> AdaptiveImageStream::schedule(
+    const std::set<uintptr_t>& clients, const Clock::duration frameInterval,
+    const Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _frameInterval = frameInterval;
+
+    std::map<size_t, std::vector<uintptr_t>> tiers;
+    for (const auto clientID : clients)
+    {
+        auto& client = _clients[clientID];
+        if (!client.acknowledges)
+        {
+            tiers[0].push_back(clientID);
+            continue;
+        }
+
+        while (!client.inFlight.empty() &&
+               now - client.inFlight.front() > IN_FLIGHT_TIMEOUT)
+        {
+            client.inFlight.pop_front();
+        }
+
+        // Frames needed to cover the base latency are not a backlog
+        size_t allowed = MAX_QUEUED_FRAMES;
+        if (client.minRoundTrip != Clock::duration::max() &&
+            frameInterval.count() > 0)
+        {
+            allowed += client.minRoundTrip / frameInterval;
+        }
+
+        if (client.inFlight.size() >= allowed)
+        {
+            client.fastFrames = 0;
+            if (++client.skipped >= SKIPS_TO_DEGRADE)
+                _degrade(client);
+            continue;
+        }
+        tiers[client.tier].push_back(clientID);
+    }
+    return tiers;
+}
+
+void AdaptiveImageStream::onSent(const uintptr_t clientID,
+                                 const Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& client = _clients[clientID];
+    if (client.acknowledges)
+        client.inFlight.push_back(now);
+    else
+        ++client.untracked;
+}
+
+void AdaptiveImageStream::acknowledge(const uintptr_t clientID,
+                                      const Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& client = _clients[clientID];
+    client.acknowledges = true;
+
+    // Acknowledgements are in send order, the frames sent before tracking
+    // began come first
+    if (client.untracked > 0)
+    {
+        --client.untracked;
+        return;
+    }
+    if (client.inFlight.empty())
+        return;
+
+    const auto roundTrip = now - client.inFlight.front();
+    client.inFlight.pop_front();
+    client.minRoundTrip = std::min(client.minRoundTrip, roundTrip);
+
+    // The frame waited in a queue on top of the base latency
+    if (roundTrip - client.minRoundTrip > _frameInterval / 2)
+    {
+        client.fastFrames = 0;
+        return;
+    }
+
+    client.skipped = 0;
+    if (++client.fastFrames >= FRAMES_TO_UPGRADE)
+    {
+        if (client.tier > 0)
+            --client.tier;
+        client.fastFrames = 0;
+    }
+}
+
+void AdaptiveImageStream::removeClient(const uintptr_t clientID)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _clients.erase(clientID);
+}
+
+size_t AdaptiveImageStream::getTier(const uintptr_t clientID) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto i = _clients.find(clientID);
+    return i == _clients.end() ? 0 : i->second.tier;
+}
+
+void AdaptiveImageStream::_degrade(Client& client)
+{
+    client.tier = std::min(client.tier + 1, getTiers().size() - 1);
+    client.skipped = 0;
+    client.fastFrames = 0;
+}
+} // namespace brayns
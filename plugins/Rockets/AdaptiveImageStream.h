@@ -0,0 +1,113 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace brayns
+{
+/**
+ * Per-client pacing and quality of the image stream.
+ *
+ * Clients acknowledging the images they receive get at most a few frames in
+ * flight on top of what their base latency requires; frames are skipped for
+ * clients lagging behind, which then move to a cheaper encoding tier, and
+ * move back up once their acknowledgements arrive without queueing. Clients
+ * which never acknowledge get every frame at full quality, as before.
+ */
+class AdaptiveImageStream
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** An encoding of the frame, produced once for all the clients using it */
+    struct Tier
+    {
+        size_t downscale; //!< integer reduction factor of the resolution
+        size_t quality;   //!< upper bound of the JPEG quality
+    };
+
+    /** @return the tiers, from the best to the cheapest one */
+    static const std::vector<Tier>& getTiers();
+
+    /** Number of frames allowed in flight besides the base latency. */
+    static constexpr size_t MAX_QUEUED_FRAMES = 2;
+
+    /** Number of skipped frames before moving to a cheaper tier. */
+    static constexpr size_t SKIPS_TO_DEGRADE = 3;
+
+    /** Number of acknowledgements without queueing to move to a better tier */
+    static constexpr size_t FRAMES_TO_UPGRADE = 60;
+
+    /**
+     * Select the clients which receive the next frame and their tier; clients
+     * with too many frames in flight skip it.
+     *
+     * @param clients all the connected clients
+     * @param frameInterval target time between two frames
+     * @param now current time
+     * @return the clients receiving the frame, per tier index
+     */
+    std::map<size_t, std::vector<uintptr_t>> schedule(
+        const std::set<uintptr_t>& clients, Clock::duration frameInterval,
+        Clock::time_point now);
+
+    /** Record that a frame was sent to the client. */
+    void onSent(uintptr_t clientID, Clock::time_point now);
+
+    /**
+     * Record that the client received its oldest frame in flight. The first
+     * acknowledgement enables the pacing and adaptation for the client; the
+     * acknowledgements of the frames sent before it are ignored, as their
+     * send times were not recorded.
+     */
+    void acknowledge(uintptr_t clientID, Clock::time_point now);
+
+    void removeClient(uintptr_t clientID);
+
+    /** @return the current tier index of the client */
+    size_t getTier(uintptr_t clientID) const;
+
+private:
+    struct Client
+    {
+        bool acknowledges{false};
+        size_t tier{0};
+        // Frames sent before the first acknowledgement and not acknowledged
+        size_t untracked{0};
+        std::deque<Clock::time_point> inFlight;
+        Clock::duration minRoundTrip{Clock::duration::max()};
+        size_t skipped{0};
+        size_t fastFrames{0};
+    };
+
+    void _degrade(Client& client);
+
+    std::map<uintptr_t, Client> _clients;
+    Clock::duration _frameInterval{};
+    mutable std::mutex _mutex;
+};
+} // namespace brayns
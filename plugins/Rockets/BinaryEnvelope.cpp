@@ -0,0 +1,530 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "BinaryEnvelope.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// The buffers are copied as is, which assumes a little-endian host like all
+// the platforms Brayns runs on.
+
+namespace brayns
+{
+namespace
+{
+const char MAGIC[] = {'B', 'R', 'B', '1'};
+const size_t PREFIX_SIZE = sizeof(MAGIC) + sizeof(uint32_t);
+const size_t ALIGNMENT = 8;
+
+const char* const BUFFER_KEY = "$buffer";
+
+enum class DType
+{
+    int8,
+    uint8,
+    int16,
+    uint16,
+    int32,
+    uint32,
+    int64,
+    uint64,
+    float32,
+    float64
+};
+
+struct DTypeInfo
+{
+    const char* name;
+    size_t size;
+};
+
+const DTypeInfo DTYPES[] = {{"int8", 1},   {"uint8", 1},   {"int16", 2},
+                            {"uint16", 2}, {"int32", 4},   {"uint32", 4},
+                            {"int64", 8},  {"uint64", 8},  {"float32", 4},
+                            {"float64", 8}};
+
+const DTypeInfo& getInfo(const DType dtype)
+{
+    return DTYPES[static_cast<size_t>(dtype)];
+}
+
+DType getDType(const rapidjson::Value& name)
+{
+    if (name.IsString())
+        for (size_t i = 0; i < sizeof(DTYPES) / sizeof(DTYPES[0]); ++i)
+            if (name == DTYPES[i].name)
+                return static_cast<DType>(i);
+    throw std::runtime_error("Unknown binary buffer type");
+}
+
+size_t align(const size_t size)
+{
+    return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+template <typename T>
+T read(const char* data)
+{
+    T value;
+    memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+rapidjson::Value readValue(const DType dtype, const char* data)
+{
+    switch (dtype)
+    {
+    case DType::int8:
+        return rapidjson::Value(int(read<int8_t>(data)));
+    case DType::uint8:
+        return rapidjson::Value(unsigned(read<uint8_t>(data)));
+    case DType::int16:
+        return rapidjson::Value(int(read<int16_t>(data)));
+    case DType::uint16:
+        return rapidjson::Value(unsigned(read<uint16_t>(data)));
+    case DType::int32:
+        return rapidjson::Value(int(read<int32_t>(data)));
+    case DType::uint32:
+        return rapidjson::Value(unsigned(read<uint32_t>(data)));
+    case DType::int64:
+        return rapidjson::Value(int64_t(read<int64_t>(data)));
+    case DType::uint64:
+        return rapidjson::Value(uint64_t(read<uint64_t>(data)));
+    case DType::float32:
+        return rapidjson::Value(double(read<float>(data)));
+    case DType::float64:
+    default:
+        return rapidjson::Value(read<double>(data));
+    }
+}
+
+template <typename T>
+void write(std::string& buffer, const T value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeValue(std::string& buffer, const DType dtype,
+                const rapidjson::Value& value)
+{
+    switch (dtype)
+    {
+    case DType::int32:
+        write(buffer, int32_t(value.GetInt()));
+        break;
+    case DType::uint32:
+        write(buffer, uint32_t(value.GetUint()));
+        break;
+    case DType::int64:
+        write(buffer, int64_t(value.GetInt64()));
+        break;
+    case DType::uint64:
+        write(buffer, uint64_t(value.GetUint64()));
+        break;
+    case DType::float32:
+        write(buffer, float(value.GetDouble()));
+        break;
+    default:
+        write(buffer, value.GetDouble());
+        break;
+    }
+}
+
+struct Placeholder
+{
+    rapidjson::Value* value{nullptr};
+    size_t index{0};
+    DType dtype{DType::float64};
+    size_t length{0};
+    size_t innerLength{0}; // 0 for flat arrays
+};
+
+void findPlaceholders(rapidjson::Value& value,
+                      std::vector<Placeholder>& placeholders)
+{
+    if (value.IsArray())
+    {
+        for (auto i = value.Begin(); i != value.End(); ++i)
+            findPlaceholders(*i, placeholders);
+        return;
+    }
+    if (!value.IsObject())
+        return;
+
+    const auto buffer = value.FindMember(BUFFER_KEY);
+    if (buffer == value.MemberEnd())
+    {
+        for (auto i = value.MemberBegin(); i != value.MemberEnd(); ++i)
+            findPlaceholders(i->value, placeholders);
+        return;
+    }
+
+    const auto shape = value.FindMember("shape");
+    const auto dtype = value.FindMember("dtype");
+    if (!buffer->value.IsUint() || dtype == value.MemberEnd() ||
+        shape == value.MemberEnd() || !shape->value.IsArray() ||
+        shape->value.Empty() || shape->value.Size() > 2)
+    {
+        throw std::runtime_error("Invalid binary buffer reference");
+    }
+    for (auto i = shape->value.Begin(); i != shape->value.End(); ++i)
+        if (!i->IsUint())
+            throw std::runtime_error("Invalid binary buffer shape");
+
+    Placeholder placeholder;
+    placeholder.value = &value;
+    placeholder.index = buffer->value.GetUint();
+    placeholder.dtype = getDType(dtype->value);
+    placeholder.length = shape->value[0].GetUint();
+    if (shape->value.Size() == 2)
+        placeholder.innerLength = shape->value[1].GetUint();
+    placeholders.push_back(placeholder);
+}
+
+template <typename Allocator>
+rapidjson::Value readArray(const Placeholder& placeholder, const char* data,
+                           Allocator& allocator)
+{
+    const auto size = getInfo(placeholder.dtype).size;
+    rapidjson::Value array(rapidjson::kArrayType);
+    array.Reserve(placeholder.length, allocator);
+    if (placeholder.innerLength == 0)
+    {
+        for (size_t i = 0; i < placeholder.length; ++i)
+            array.PushBack(readValue(placeholder.dtype, data + i * size),
+                           allocator);
+        return array;
+    }
+
+    for (size_t i = 0; i < placeholder.length; ++i)
+    {
+        rapidjson::Value inner(rapidjson::kArrayType);
+        inner.Reserve(placeholder.innerLength, allocator);
+        for (size_t j = 0; j < placeholder.innerLength; ++j)
+            inner.PushBack(readValue(placeholder.dtype, data + j * size),
+                           allocator);
+        array.PushBack(inner, allocator);
+        data += placeholder.innerLength * size;
+    }
+    return array;
+}
+
+/** Tracks the narrowest type holding all the values seen so far. */
+class DTypeSelector
+{
+public:
+    void add(const rapidjson::Value& value)
+    {
+        _int32 = _int32 && value.IsInt();
+        _uint32 = _uint32 && value.IsUint();
+        _int64 = _int64 && value.IsInt64();
+        _uint64 = _uint64 && value.IsUint64();
+        if (_float32)
+        {
+            const auto number = value.GetDouble();
+            _float32 = double(float(number)) == number;
+        }
+    }
+
+    DType get() const
+    {
+        if (_int32)
+            return DType::int32;
+        if (_uint32)
+            return DType::uint32;
+        if (_int64)
+            return DType::int64;
+        if (_uint64)
+            return DType::uint64;
+        return _float32 ? DType::float32 : DType::float64;
+    }
+
+private:
+    bool _int32{true};
+    bool _uint32{true};
+    bool _int64{true};
+    bool _uint64{true};
+    bool _float32{true};
+};
+
+/**
+ * @return the length of the inner arrays if the value is an array of arrays
+ *         of numbers of the same length, 0 if it is an array of numbers, -1
+ *         otherwise
+ */
+int getInnerLength(const rapidjson::Value& array)
+{
+    if (array.Empty())
+        return -1;
+
+    if (array[0].IsNumber())
+    {
+        for (auto i = array.Begin(); i != array.End(); ++i)
+            if (!i->IsNumber())
+                return -1;
+        return 0;
+    }
+
+    if (!array[0].IsArray() || array[0].Empty())
+        return -1;
+    const auto innerLength = array[0].Size();
+    for (auto i = array.Begin(); i != array.End(); ++i)
+    {
+        if (!i->IsArray() || i->Size() != innerLength)
+            return -1;
+        for (auto j = i->Begin(); j != i->End(); ++j)
+            if (!j->IsNumber())
+                return -1;
+    }
+    return int(innerLength);
+}
+
+template <typename Allocator>
+void extractArrays(rapidjson::Value& value, const size_t minArrayLength,
+                   std::vector<std::string>& buffers, Allocator& allocator)
+{
+    if (value.IsObject())
+    {
+        for (auto i = value.MemberBegin(); i != value.MemberEnd(); ++i)
+            extractArrays(i->value, minArrayLength, buffers, allocator);
+        return;
+    }
+    if (!value.IsArray())
+        return;
+
+    const int innerLength = getInnerLength(value);
+    if (innerLength < 0)
+    {
+        for (auto i = value.Begin(); i != value.End(); ++i)
+            extractArrays(*i, minArrayLength, buffers, allocator);
+        return;
+    }
+
+    const size_t nbValues = value.Size() * std::max(innerLength, 1);
+    if (nbValues < minArrayLength)
+        return;
+
+    // Flat view on the numbers, inner arrays being laid out one after another
+    std::vector<const rapidjson::Value*> numbers;
+    numbers.reserve(nbValues);
+    for (auto i = value.Begin(); i != value.End(); ++i)
+    {
+        if (innerLength == 0)
+            numbers.push_back(&*i);
+        else
+            for (auto j = i->Begin(); j != i->End(); ++j)
+                numbers.push_back(&*j);
+    }
+
+    DTypeSelector selector;
+    for (const auto number : numbers)
+        selector.add(*number);
+    const auto dtype = selector.get();
+
+    std::string buffer;
+    buffer.reserve(nbValues * getInfo(dtype).size);
+    for (const auto number : numbers)
+        writeValue(buffer, dtype, *number);
+
+    rapidjson::Value shape(rapidjson::kArrayType);
+    shape.PushBack(value.Size(), allocator);
+    if (innerLength > 0)
+        shape.PushBack(innerLength, allocator);
+
+    rapidjson::Value placeholder(rapidjson::kObjectType);
+    placeholder.AddMember(rapidjson::StringRef(BUFFER_KEY),
+                          unsigned(buffers.size()), allocator);
+    placeholder.AddMember("dtype", rapidjson::StringRef(getInfo(dtype).name),
+                          allocator);
+    placeholder.AddMember("shape", shape, allocator);
+    value = placeholder;
+
+    buffers.push_back(std::move(buffer));
+}
+
+bool isNumberType(const rapidjson::Value& schema)
+{
+    if (!schema.IsObject())
+        return false;
+    const auto type = schema.FindMember("type");
+    return type != schema.MemberEnd() &&
+           (type->value == "number" || type->value == "integer");
+}
+
+bool isNumberArrayType(const rapidjson::Value& schema)
+{
+    if (!schema.IsObject())
+        return false;
+    const auto type = schema.FindMember("type");
+    const auto items = schema.FindMember("items");
+    return type != schema.MemberEnd() && type->value == "array" &&
+           items != schema.MemberEnd() && isNumberType(items->value);
+}
+
+template <typename Allocator>
+void markArrays(rapidjson::Value& schema, Allocator& allocator)
+{
+    if (schema.IsArray())
+    {
+        for (auto i = schema.Begin(); i != schema.End(); ++i)
+            markArrays(*i, allocator);
+        return;
+    }
+    if (!schema.IsObject())
+        return;
+
+    for (auto i = schema.MemberBegin(); i != schema.MemberEnd(); ++i)
+        markArrays(i->value, allocator);
+
+    const auto items = schema.FindMember("items");
+    if (!isNumberArrayType(schema) &&
+        !(items != schema.MemberEnd() && isNumberArrayType(items->value)))
+    {
+        return;
+    }
+
+    // Fixed size vectors like positions and colors stay in the header
+    const auto maxItems = schema.FindMember("maxItems");
+    if (maxItems != schema.MemberEnd() && maxItems->value.IsUint() &&
+        maxItems->value.GetUint() < MIN_BINARY_ARRAY_LENGTH)
+    {
+        return;
+    }
+    if (!schema.HasMember("binary"))
+        schema.AddMember("binary", true, allocator);
+}
+
+std::string toString(const rapidjson::Value& value)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    value.Accept(writer);
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+} // namespace
+
+bool isBinaryEnvelope(const std::string& message)
+{
+    return message.size() >= PREFIX_SIZE &&
+           memcmp(message.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::string decodeBinaryEnvelope(const std::string& message)
+{
+    if (!isBinaryEnvelope(message))
+        throw std::runtime_error("Not a binary envelope");
+
+    const size_t headerSize = read<uint32_t>(message.data() + sizeof(MAGIC));
+    if (headerSize > message.size() - PREFIX_SIZE)
+        throw std::runtime_error("Truncated binary envelope header");
+
+    rapidjson::Document document;
+    document.Parse(message.data() + PREFIX_SIZE, headerSize);
+    if (document.HasParseError())
+        throw std::runtime_error("Invalid binary envelope header");
+
+    // The indices come from the client, they are checked to be the range
+    // 0..n-1 before anything is allocated from them
+    std::vector<Placeholder> references;
+    findPlaceholders(document, references);
+    std::vector<Placeholder> placeholders(references.size());
+    for (const auto& reference : references)
+    {
+        if (reference.index >= references.size())
+            throw std::runtime_error("Invalid binary buffer index");
+        auto& placeholder = placeholders[reference.index];
+        if (placeholder.value)
+            throw std::runtime_error("Duplicate binary buffer reference");
+        placeholder = reference;
+    }
+
+    size_t offset = align(PREFIX_SIZE + headerSize);
+    for (const auto& placeholder : placeholders)
+    {
+        if (!placeholder.value)
+            throw std::runtime_error("Missing binary buffer reference");
+
+        // Bounds checked before multiplying to reject overflowing shapes
+        const size_t available =
+            offset < message.size() ? message.size() - offset : 0;
+        const size_t dtypeSize = getInfo(placeholder.dtype).size;
+        const size_t innerLength =
+            std::max<size_t>(placeholder.innerLength, 1);
+        if (placeholder.length > available / dtypeSize / innerLength)
+            throw std::runtime_error("Truncated binary buffer");
+        const size_t size = placeholder.length * innerLength * dtypeSize;
+
+        *placeholder.value = readArray(placeholder, message.data() + offset,
+                                       document.GetAllocator());
+        offset = align(offset + size);
+    }
+    return toString(document);
+}
+
+std::string encodeBinaryEnvelope(const std::string& json,
+                                 const size_t minArrayLength)
+{
+    rapidjson::Document document;
+    document.Parse(json.c_str(), json.size());
+    if (document.HasParseError())
+        throw std::runtime_error("Invalid JSON message");
+
+    std::vector<std::string> buffers;
+    extractArrays(document, std::max<size_t>(minArrayLength, 1), buffers,
+                  document.GetAllocator());
+
+    auto header = toString(document);
+    header.resize(align(PREFIX_SIZE + header.size()) - PREFIX_SIZE, ' ');
+
+    size_t size = PREFIX_SIZE + header.size();
+    for (const auto& buffer : buffers)
+        size += align(buffer.size());
+
+    std::string envelope;
+    envelope.reserve(size);
+    envelope.append(MAGIC, sizeof(MAGIC));
+    write(envelope, uint32_t(header.size()));
+    envelope += header;
+    for (const auto& buffer : buffers)
+    {
+        envelope += buffer;
+        envelope.resize(align(envelope.size()), '\0');
+    }
+    return envelope;
+}
+
+std::string markBinaryArrays(const std::string& schema)
+{
+    rapidjson::Document document;
+    document.Parse(schema.c_str(), schema.size());
+    if (document.HasParseError())
+        return schema;
+
+    markArrays(document, document.GetAllocator());
+    return toString(document);
+}
+} // namespace brayns
@@ -0,0 +1,72 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Binary envelope for JSON-RPC messages carrying large numeric arrays:
+ *
+ * - 4 bytes magic "BRB1"
+ * - uint32 little-endian size of the header, padded to 8 bytes
+ * - header: the JSON-RPC message, where each array sent as binary is replaced
+ *   by {"$buffer": index, "dtype": type, "shape": [length]}, or
+ *   {..., "shape": [length, inner length]} for an array of arrays of numbers
+ *   of equal length
+ * - the buffers in index order, as raw little-endian values, each starting on
+ *   an 8 bytes boundary
+ *
+ * Supported types are int8, uint8, int16, uint16, int32, uint32, int64,
+ * uint64, float32 and float64.
+ */
+namespace brayns
+{
+/** Arrays shorter than this are kept in the JSON header. */
+constexpr size_t MIN_BINARY_ARRAY_LENGTH = 64;
+
+/** @return true if the message starts with the binary envelope magic. */
+bool isBinaryEnvelope(const std::string& message);
+
+/**
+ * Expand the buffers of the binary envelope into the arrays of the JSON-RPC
+ * message it carries.
+ *
+ * @throw std::runtime_error if the envelope is malformed
+ */
+std::string decodeBinaryEnvelope(const std::string& message);
+
+/**
+ * Wrap the given JSON-RPC message into a binary envelope, moving its numeric
+ * arrays of at least the given length to buffers. Integer arrays use the
+ * smallest of int32, uint32, int64 or uint64 which fits all the values, other
+ * arrays float32 if it is lossless and float64 otherwise.
+ *
+ * @throw std::runtime_error if the message is not valid JSON
+ */
+std::string encodeBinaryEnvelope(
+    const std::string& json, size_t minArrayLength = MIN_BINARY_ARRAY_LENGTH);
+
+/**
+ * Annotate the arrays of numbers of the given JSON schema with
+ * "binary": true, as they can travel in the buffers of a binary envelope.
+ */
+std::string markBinaryArrays(const std::string& schema);
+} // namespace brayns
@@ -68,7 +68,8 @@ ImageGenerator::ImageBase64 ImageGenerator::createImage(
 }
 
 ImageGenerator::ImageJPEG ImageGenerator::createJPEG(
-    FrameBuffer& frameBuffer BRAYNS_UNUSED, const uint8_t quality BRAYNS_UNUSED)
+    FrameBuffer& frameBuffer BRAYNS_UNUSED, const uint8_t quality BRAYNS_UNUSED,
+    const size_t downscale)
 {
     frameBuffer.map();
     const auto colorBuffer = frameBuffer.getColorBuffer();
@@ -91,9 +92,42 @@ ImageGenerator::ImageJPEG ImageGenerator::createJPEG(
 
     const auto& frameSize = frameBuffer.getSize();
     ImageJPEG image;
-    image.data = _encodeJpeg(frameSize.x, frameSize.y, colorBuffer, pixelFormat,
-                             quality, image.size);
+    if (downscale <= 1 || frameSize.x < downscale || frameSize.y < downscale)
+    {
+        image.data = _encodeJpeg(frameSize.x, frameSize.y, colorBuffer,
+                                 pixelFormat, quality, image.size);
+        frameBuffer.unmap();
+        return image;
+    }
+
+    // Average blocks of downscale x downscale pixels, channel by channel
+    const size_t width = frameSize.x / downscale;
+    const size_t height = frameSize.y / downscale;
+    const size_t nbSamples = downscale * downscale;
+    _downscaled.resize(width * height * 4);
+    for (size_t y = 0; y < height; ++y)
+    {
+        for (size_t x = 0; x < width; ++x)
+        {
+            uint32_t sums[4] = {0, 0, 0, 0};
+            for (size_t j = 0; j < downscale; ++j)
+            {
+                const uint8_t* pixel =
+                    colorBuffer +
+                    ((y * downscale + j) * frameSize.x + x * downscale) * 4;
+                for (size_t i = 0; i < downscale; ++i, pixel += 4)
+                    for (size_t c = 0; c < 4; ++c)
+                        sums[c] += pixel[c];
+            }
+            uint8_t* target = &_downscaled[(y * width + x) * 4];
+            for (size_t c = 0; c < 4; ++c)
+                target[c] = (sums[c] + nbSamples / 2) / nbSamples;
+        }
+    }
     frameBuffer.unmap();
+
+    image.data = _encodeJpeg(width, height, _downscaled.data(), pixelFormat,
+                             quality, image.size);
     return image;
 }
 
@@ -73,12 +73,16 @@ public:
      *
      * @param frameBuffer the framebuffer to use for getting the pixels
      * @param quality 1..100 JPEG quality
+     * @param downscale integer factor to reduce the resolution of the image,
+     *                  averaging blocks of downscale x downscale pixels
      * @return JPEG image with a size > 0 if valid, size == 0 on error.
      */
-    ImageJPEG createJPEG(FrameBuffer& frameBuffer, uint8_t quality);
+    ImageJPEG createJPEG(FrameBuffer& frameBuffer, uint8_t quality,
+                         size_t downscale = 1);
 
 private:
     tjhandle _compressor{tjInitCompress()};
+    std::vector<uint8_t> _downscaled;
 
     ImageJPEG::JpegData _encodeJpeg(uint32_t width, uint32_t height,
                                     const uint8_t* rawData, int32_t pixelFormat,
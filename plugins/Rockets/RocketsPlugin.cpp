@@ -41,14 +41,20 @@
 #include <rockets/jsonrpc/server.h>
 #include <rockets/server.h>
 
+#include "AdaptiveImageStream.h"
+#include "BinaryEnvelope.h"
 #include "BinaryRequests.h"
 #include "ImageGenerator.h"
 #include "Throttle.h"
+#include "VersionedObject.h"
 
+#include <algorithm>
 #include <atomic>
 #include <dirent.h>
 #include <fstream>
+#include <iterator>
 #include <limits.h>
+#include <set>
 #include <unistd.h>
 
 #include <sys/stat.h>
@@ -70,6 +76,7 @@ const int SCHEMA_RPC_ENDPOINT_NOT_FOUND = -12348;
 const int PARAMETER_FROM_JSON_ERROR = -12349;
 const int VIDEOSTREAMING_NOT_SUPPORTED = -12350;
 const int VIDEOSTREAMING_NOT_ENABLED = -12351;
+const int VERSIONED_ENDPOINT_NOT_FOUND = -12352;
 
 // REST PUT & GET, JSONRPC set-* notification, JSONRPC get-* request
 const std::string ENDPOINT_ANIMATION_PARAMS = "animation-parameters";
@@ -112,6 +119,7 @@ const std::string METHOD_SET_ENVIRONMENT_MAP = "set-environment-map";
 const std::string METHOD_SET_MODEL_PROPERTIES = "set-model-properties";
 const std::string METHOD_SET_MODEL_TRANSFER_FUNCTION =
     "set-model-transfer-function";
+const std::string METHOD_SET_RENDER_REGIONS = "set-render-regions";
 const std::string METHOD_SET_VIDEOSTREAM = "set-videostream";
 const std::string METHOD_UPDATE_CLIP_PLANE = "update-clip-plane";
 const std::string METHOD_UPDATE_INSTANCE = "update-instance";
@@ -130,6 +138,11 @@ const std::string METHOD_FS_GET_CONTENT = "fs-get-content";
 const std::string METHOD_FS_GET_ROOT = "fs-get-root";
 const std::string METHOD_FS_LIST_DIR = "fs-list-dir";
 
+const std::string METHOD_GET_VERSIONED_OBJECT = "get-versioned-object";
+const std::string METHOD_ACKNOWLEDGE_VERSION = "acknowledge-version";
+const std::string METHOD_SET_BINARY_TRANSPORT = "set-binary-transport";
+const std::string METHOD_IMAGE_STREAM_ACK = "image-stream-ack";
+
 // JSONRPC notifications
 const std::string METHOD_CHUNK = "chunk";
 const std::string METHOD_QUIT = "quit";
@@ -173,6 +186,11 @@ std::string getRequestEndpointName(const std::string& endpoint)
     return "get-" + endpoint;
 }
 
+std::string getPatchEndpointName(const std::string& endpoint)
+{
+    return "patch-" + endpoint;
+}
+
 const Response::Error VIDEOSTREAM_NOT_ENABLED_ERROR{
     "Brayns was not started with videostream support enabled",
     VIDEOSTREAMING_NOT_ENABLED};
@@ -218,6 +236,7 @@ inline bool from_json(T& obj, const std::string& json,
         staticjson::from_json_string(json.c_str(), &obj, &status);
     if (success)
     {
+        postJSONUpdate(obj, json);
         obj.markModified();
         if (std::function<void(T&)>(postUpdateFunc))
             postUpdateFunc(obj);
@@ -458,14 +477,89 @@ public:
 
     void _setupWebsocket()
     {
+        _rocketsServer->handleOpen([this](const uintptr_t clientID) {
+            std::lock_guard<std::mutex> lock(_clientsMutex);
+            _clients.insert(clientID);
+            return std::vector<rockets::ws::Response>{};
+        });
+
         _rocketsServer->handleClose([this](const uintptr_t clientID) {
             _binaryRequests.removeRequest(clientID);
+            {
+                std::lock_guard<std::mutex> lock(_clientsMutex);
+                _clients.erase(clientID);
+                _binaryTransportClients.erase(clientID);
+            }
+            _imageStream.removeClient(clientID);
+            for (auto& i : _versionedObjects)
+            {
+                std::lock_guard<std::mutex> lock(i.second.mutex);
+                i.second.clients.erase(clientID);
+            }
             return std::vector<rockets::ws::Response>{};
         });
 
-        _rocketsServer->handleBinary(std::bind(&BinaryRequests::processMessage,
-                                               std::ref(_binaryRequests),
-                                               std::placeholders::_1));
+        _rocketsServer->handleBinary(
+            [this](const rockets::ws::Request& request) {
+                if (isBinaryEnvelope(request.message) &&
+                    _hasBinaryTransport(request.clientID))
+                {
+                    _processBinaryEnvelope(request);
+                    return rockets::ws::Response{};
+                }
+                return _binaryRequests.processMessage(request);
+            });
+    }
+
+    bool _hasBinaryTransport(const uintptr_t clientID)
+    {
+        std::lock_guard<std::mutex> lock(_clientsMutex);
+        return _binaryTransportClients.count(clientID) > 0;
+    }
+
+    /**
+     * Process the JSON-RPC request carried by the binary envelope, and reply
+     * with a binary envelope as well.
+     */
+    void _processBinaryEnvelope(const rockets::ws::Request& request)
+    {
+        const auto clientID = request.clientID;
+        std::string json;
+        try
+        {
+            json = decodeBinaryEnvelope(request.message);
+        }
+        catch (const std::exception& e)
+        {
+            BRAYNS_ERROR << "Invalid binary message: " << e.what()
+                         << std::endl;
+            _sendText("{\"jsonrpc\":\"2.0\",\"id\":null,\"error\":{"
+                      "\"code\":-32700,\"message\":\"Invalid binary "
+                      "envelope\"}}",
+                      {clientID});
+            return;
+        }
+
+        // The response of asynchronous requests comes from another thread
+        _jsonrpcServer->process(
+            rockets::jsonrpc::Request{json, clientID},
+            [this, clientID](std::string response) {
+                if (response.empty())
+                    return;
+                _delayedNotify([this, clientID,
+                                response = std::move(response)] {
+                    try
+                    {
+                        _sendBinaryResponse(encodeBinaryEnvelope(response),
+                                            clientID);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        BRAYNS_ERROR << "Error sending binary response: "
+                                     << e.what() << std::endl;
+                    }
+                });
+            });
     }
 
     void _delayedNotify(const std::function<void()>& notify)
@@ -508,6 +602,127 @@ public:
         });
     }
 
+    /** Send the message to the given clients only. */
+    void _sendText(const std::string& message,
+                   const std::set<uintptr_t>& clients)
+    {
+        std::set<uintptr_t> filter;
+        {
+            std::lock_guard<std::mutex> lock(_clientsMutex);
+            std::set_difference(_clients.begin(), _clients.end(),
+                                clients.begin(), clients.end(),
+                                std::inserter(filter, filter.end()));
+        }
+        _rocketsServer->broadcastText(message, filter);
+    }
+
+    /**
+     * Send the binary message to the given clients only.
+     *
+     * The server can only exclude the clients it is given, so nothing is sent
+     * while it has a connection not registered in _clients yet, which would
+     * receive the message as well. Holding the lock during the send keeps
+     * connections from being registered in between.
+     *
+     * @return false if nothing was sent
+     */
+    bool _sendBinary(const char* data, const size_t size,
+                     const std::set<uintptr_t>& targets)
+    {
+        std::lock_guard<std::mutex> lock(_clientsMutex);
+        if (_rocketsServer->getConnectionCount() != _clients.size())
+            return false;
+
+        std::set<uintptr_t> filter;
+        std::set_difference(_clients.begin(), _clients.end(), targets.begin(),
+                            targets.end(),
+                            std::inserter(filter, filter.end()));
+        _rocketsServer->broadcastBinary(data, size, filter);
+        return true;
+    }
+
+    /**
+     * Send the binary response to its client, at a later processing of the
+     * delayed notifications if a connection is not registered yet.
+     */
+    void _sendBinaryResponse(std::string message, const uintptr_t clientID)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_clientsMutex);
+            if (!_clients.count(clientID))
+                return;
+        }
+        if (_sendBinary(message.data(), message.size(), {clientID}))
+            return;
+        _delayedNotify([this, clientID, message = std::move(message)] {
+            _sendBinaryResponse(message, clientID);
+        });
+    }
+
+    /**
+     * Notify the clients about the new state of the object of the given
+     * endpoint. Clients which acknowledged a version of the object receive a
+     * patch from it, the other ones the whole object, except the client
+     * which made the change. Each message is created once for all the
+     * clients receiving it.
+     */
+    void _notifyObject(const std::string& endpoint, const std::string& json,
+                       const uintptr_t clientID)
+    {
+        auto& versioned = _versionedObjects.at(endpoint);
+        std::lock_guard<std::mutex> lock(versioned.mutex);
+        try
+        {
+            const auto base = versioned.object.getVersion();
+            const auto patch = versioned.object.update(json);
+
+            if (_rocketsServer->getConnectionCount() == 0)
+                return;
+
+            std::set<uintptr_t> filter;
+            for (const auto& i : versioned.clients)
+                filter.insert(i.first);
+            if (clientID != NO_CURRENT_CLIENT)
+                filter.insert(clientID);
+            if (filter.size() < _rocketsServer->getConnectionCount())
+            {
+                const auto& msg = rockets::jsonrpc::makeNotification(
+                    getNotificationEndpointName(endpoint), json);
+                _rocketsServer->broadcastText(msg, filter);
+            }
+
+            if (patch.empty() || versioned.clients.empty())
+                return;
+
+            const auto version = versioned.object.getVersion();
+            std::set<uintptr_t> upToDate;
+            std::set<uintptr_t> outdated;
+            for (auto& i : versioned.clients)
+            {
+                (i.second == base ? upToDate : outdated).insert(i.first);
+                i.second = version;
+            }
+
+            const auto makePatchNotification = [&](const std::string& ops) {
+                return rockets::jsonrpc::makeNotification(
+                    getPatchEndpointName(endpoint),
+                    "{\"version\":" + std::to_string(version) +
+                        ",\"patch\":" + ops + "}");
+            };
+            if (!upToDate.empty())
+                _sendText(makePatchNotification(patch), upToDate);
+            if (!outdated.empty())
+                _sendText(makePatchNotification(
+                              versioned.object.getReplacePatch()),
+                          outdated);
+        }
+        catch (const std::exception& e)
+        {
+            BRAYNS_ERROR << "Error broadcasting notification: " << e.what()
+                         << std::endl;
+        }
+    }
+
     // Utilty to change current client while we are handling a message to skip
     // notification to the current client and to trigger a delayed notify to
     // avoid a deadlock which happens when sending a message from within a
@@ -671,8 +886,10 @@ public:
         // Create new throttle for that endpoint
         _throttle[endpoint];
 
-        obj.onModified([&, endpoint = getNotificationEndpointName(endpoint),
-                        throttleTime](const auto& base) {
+        // Initial version of the object, for clients requesting patches
+        _versionedObjects[endpoint].object.update(to_json(obj));
+
+        obj.onModified([&, endpoint, throttleTime](const auto& base) {
             auto& throttle = _throttle[endpoint];
 
             // throttle itself is not thread-safe, but we can get called
@@ -680,26 +897,9 @@ public:
             std::lock_guard<std::mutex> lock(throttle.first);
 
             const auto& castedObj = static_cast<const T&>(base);
-            const auto notify = [& rocketsServer = _rocketsServer,
-                                 clientID = _currentClientID, endpoint,
+            const auto notify = [this, clientID = _currentClientID, endpoint,
                                  json = to_json(castedObj)] {
-                if (rocketsServer->getConnectionCount() == 0)
-                    return;
-                try
-                {
-                    const auto& msg =
-                        rockets::jsonrpc::makeNotification(endpoint, json);
-                    if (clientID == NO_CURRENT_CLIENT)
-                        rocketsServer->broadcastText(msg);
-                    else
-                        rocketsServer->broadcastText(msg, {clientID});
-                }
-                catch (const std::exception& e)
-                {
-                    BRAYNS_ERROR
-                        << "Error broadcasting notification: " << e.what()
-                        << std::endl;
-                }
+                this->_notifyObject(endpoint, json, clientID);
             };
             const auto delayedNotify = [&, notify] {
                 this->_delayedNotify(notify);
@@ -958,8 +1158,12 @@ public:
                       buildJsonSchema(obj, hyphenatedToCamelCase(endpoint)));
     }
 
-    void _handleSchema(const std::string& endpoint, const std::string& schema)
+    void _handleSchema(const std::string& endpoint,
+                       const std::string& jsonSchema)
     {
+        // Let clients know which arrays can travel in binary envelopes
+        const auto schema = markBinaryArrays(jsonSchema);
+
         using namespace rockets::http;
         _rocketsServer->handle(Method::GET, endpoint + "/schema",
                                [schema](const Request&) {
@@ -976,6 +1180,7 @@ public:
         _handleCamera();
         _handleImageJPEG();
         _handleTriggerImageStream();
+        _handleImageStreamAck();
         _handleSetImageStreamingMode();
         _handleRenderer();
         _handleVersion();
@@ -991,11 +1196,14 @@ public:
         _handleGET(ENDPOINT_STATISTICS, _engine.getStatistics(), SLOW_THROTTLE);
 
         _handleSchemaRPC();
+        _handleVersionedObjects();
+        _handleBinaryTransport();
 
         _handleInspect();
         _handleQuit();
         _handleExitLater();
         _handleResetCamera();
+        _handleSetRenderRegions();
         _handleSnapshot();
 
         _handleRequestModelUpload();
@@ -1085,12 +1293,37 @@ public:
             _leftover -= duration;
         _timer.start();
 
-        const auto image =
-            _imageGenerator.createJPEG(frameBuffer,
-                                       params.getJpegCompression());
-        if (image.size > 0)
-            _rocketsServer->broadcastBinary((const char*)image.data.get(),
-                                            image.size);
+        std::set<uintptr_t> clients;
+        {
+            std::lock_guard<std::mutex> lock(_clientsMutex);
+            clients = _clients;
+        }
+
+        // Each tier is encoded once and sent to all the clients using it
+        using Clock = AdaptiveImageStream::Clock;
+        const auto now = Clock::now();
+        const auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(duration));
+        for (const auto& tier : _imageStream.schedule(clients, interval, now))
+        {
+            const auto& encoding = AdaptiveImageStream::getTiers()[tier.first];
+            const auto quality =
+                std::min(encoding.quality, params.getJpegCompression());
+            const auto image =
+                _imageGenerator.createJPEG(frameBuffer, quality,
+                                           encoding.downscale);
+            if (image.size == 0)
+                continue;
+
+            // The frame is skipped by all the clients while one is connecting
+            const std::set<uintptr_t> targets(tier.second.begin(),
+                                              tier.second.end());
+            if (!_sendBinary((const char*)image.data.get(), image.size,
+                             targets))
+                return;
+            for (const auto clientID : tier.second)
+                _imageStream.onSent(clientID, now);
+        }
     }
 
     void _broadcastControlledImageJpeg()
@@ -1261,6 +1494,108 @@ public:
                           desc));
     }
 
+    void _handleVersionedObjects()
+    {
+        const RpcParameterDescription getDesc{
+            METHOD_GET_VERSIONED_OBJECT,
+            "Get the current version of the object of the given endpoint and "
+            "subscribe to patch notifications for it",
+            Execution::sync, "endpoint", "name of the endpoint of the object"};
+
+        _jsonrpcServer->bind(METHOD_GET_VERSIONED_OBJECT,
+                             [this](const auto& request) {
+                                 SchemaParam param;
+                                 if (!::from_json(param, request.message))
+                                     return Response::invalidParams();
+
+                                 auto i = _versionedObjects.find(
+                                     param.endpoint);
+                                 if (i == _versionedObjects.end())
+                                     return Response{Response::Error{
+                                         "Endpoint not found",
+                                         VERSIONED_ENDPOINT_NOT_FOUND}};
+
+                                 auto& versioned = i->second;
+                                 std::lock_guard<std::mutex> lock(
+                                     versioned.mutex);
+                                 const auto version =
+                                     versioned.object.getVersion();
+                                 versioned.clients[request.clientID] = version;
+                                 return Response{
+                                     "{\"version\":" +
+                                     std::to_string(version) +
+                                     ",\"object\":" +
+                                     versioned.object.getJson() + "}"};
+                             });
+
+        _handleSchema(METHOD_GET_VERSIONED_OBJECT,
+                      buildJsonRpcSchemaRequest<SchemaParam, std::string>(
+                          getDesc));
+
+        const RpcParameterDescription ackDesc{
+            METHOD_ACKNOWLEDGE_VERSION,
+            "Acknowledge the version of the object of the given endpoint the "
+            "client knows about, returns whether it is the current one",
+            Execution::sync, "param", "endpoint and version of the object"};
+
+        _jsonrpcServer->bind(METHOD_ACKNOWLEDGE_VERSION,
+                             [this](const auto& request) {
+                                 EndpointVersion param;
+                                 if (!::from_json(param, request.message))
+                                     return Response::invalidParams();
+
+                                 auto i = _versionedObjects.find(
+                                     param.endpoint);
+                                 if (i == _versionedObjects.end())
+                                     return Response{Response::Error{
+                                         "Endpoint not found",
+                                         VERSIONED_ENDPOINT_NOT_FOUND}};
+
+                                 auto& versioned = i->second;
+                                 std::lock_guard<std::mutex> lock(
+                                     versioned.mutex);
+                                 versioned.clients[request.clientID] =
+                                     param.version;
+                                 return Response{to_json(
+                                     param.version ==
+                                     versioned.object.getVersion())};
+                             });
+
+        _handleSchema(METHOD_ACKNOWLEDGE_VERSION,
+                      buildJsonRpcSchemaRequest<EndpointVersion, bool>(
+                          ackDesc));
+    }
+
+    void _handleBinaryTransport()
+    {
+        const RpcParameterDescription desc{
+            METHOD_SET_BINARY_TRANSPORT,
+            "Enable or disable binary envelopes for the JSON-RPC requests and "
+            "responses of this client, with large numeric arrays sent as raw "
+            "little-endian buffers",
+            Execution::sync, "param", "whether to use binary envelopes"};
+
+        _jsonrpcServer->bind(METHOD_SET_BINARY_TRANSPORT,
+                             [this](const auto& request) {
+                                 BinaryTransport param;
+                                 if (!::from_json(param, request.message))
+                                     return Response::invalidParams();
+
+                                 std::lock_guard<std::mutex> lock(
+                                     _clientsMutex);
+                                 if (param.enabled)
+                                     _binaryTransportClients.insert(
+                                         request.clientID);
+                                 else
+                                     _binaryTransportClients.erase(
+                                         request.clientID);
+                                 return Response{to_json(true)};
+                             });
+
+        _handleSchema(METHOD_SET_BINARY_TRANSPORT,
+                      buildJsonRpcSchemaRequest<BinaryTransport, bool>(desc));
+    }
+
     void _handleInspect()
     {
         using Position = std::array<double, 2>;
@@ -1330,6 +1665,32 @@ public:
                    });
     }
 
+    void _handleSetRenderRegions()
+    {
+        const RpcParameterDescription desc{
+            METHOD_SET_RENDER_REGIONS,
+            "Render only the given regions of a frame buffer, e.g. the ones "
+            "being displayed; all of the frame if there is no region",
+            "param", "Frame buffer name, all of them if empty, and regions"};
+        _handleRPC<FrameBufferRegions, bool>(
+            desc, [&](const FrameBufferRegions& param) {
+                bool found = false;
+                for (auto frameBuffer : _engine.getFrameBuffers())
+                {
+                    if (!param.frameBuffer.empty() &&
+                        frameBuffer->getName() != param.frameBuffer)
+                    {
+                        continue;
+                    }
+                    frameBuffer->setRenderRegions(param.regions);
+                    found = true;
+                }
+                if (found)
+                    _engine.triggerRender();
+                return found;
+            });
+    }
+
     void _handleSnapshot()
     {
         const RpcParameterDescription desc{
@@ -1356,6 +1717,17 @@ public:
                    });
     }
 
+    void _handleImageStreamAck()
+    {
+        _handleRPC({METHOD_IMAGE_STREAM_ACK,
+                    "Acknowledge the reception of an image of the stream, to "
+                    "adapt the rate and quality of the stream to the client"},
+                   [&] {
+                       _imageStream.acknowledge(
+                           _currentClientID, AdaptiveImageStream::Clock::now());
+                   });
+    }
+
     void _handleSetImageStreamingMode()
     {
         _handleRPC<ImageStreamingMethod>({METHOD_SET_STREAMING_METHOD,
@@ -2304,6 +2676,19 @@ public:
     static constexpr uintptr_t NO_CURRENT_CLIENT{0};
     uintptr_t _currentClientID{NO_CURRENT_CLIENT};
 
+    // Last version of each object sent to the clients which subscribed to
+    // patch notifications
+    struct VersionedSubscriptions
+    {
+        std::mutex mutex;
+        VersionedObject object;
+        std::map<uintptr_t, uint64_t> clients;
+    };
+    std::unordered_map<std::string, VersionedSubscriptions> _versionedObjects;
+    std::set<uintptr_t> _clients;
+    std::set<uintptr_t> _binaryTransportClients;
+    std::mutex _clientsMutex;
+
 #ifdef BRAYNS_USE_LIBUV
     std::shared_ptr<uvw::AsyncHandle> _processDelayedNotifies;
 #endif
@@ -2319,6 +2704,7 @@ public:
     bool _manualProcessing{true};
 
     ImageGenerator _imageGenerator;
+    AdaptiveImageStream _imageStream;
 
     Timer _timer;
     float _leftover{0.f};
@@ -0,0 +1,153 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "VersionedObject.h"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace brayns
+{
+namespace
+{
+using Writer = rapidjson::Writer<rapidjson::StringBuffer>;
+
+/** Escapes a member name as a JSON pointer reference token (RFC 6901). */
+std::string escapeToken(const rapidjson::Value& name)
+{
+    std::string token;
+    token.reserve(name.GetStringLength());
+    const char* chars = name.GetString();
+    for (rapidjson::SizeType i = 0; i < name.GetStringLength(); ++i)
+    {
+        if (chars[i] == '~')
+            token += "~0";
+        else if (chars[i] == '/')
+            token += "~1";
+        else
+            token += chars[i];
+    }
+    return token;
+}
+
+void writeOperation(Writer& writer, const char* operation,
+                    const std::string& path, const rapidjson::Value* value)
+{
+    writer.StartObject();
+    writer.Key("op");
+    writer.String(operation);
+    writer.Key("path");
+    writer.String(path.c_str(), rapidjson::SizeType(path.size()));
+    if (value)
+    {
+        writer.Key("value");
+        value->Accept(writer);
+    }
+    writer.EndObject();
+}
+
+void writeDiff(Writer& writer, const std::string& path,
+               const rapidjson::Value& from, const rapidjson::Value& to)
+{
+    if (from == to)
+        return;
+
+    if (from.IsObject() && to.IsObject())
+    {
+        for (auto i = from.MemberBegin(); i != from.MemberEnd(); ++i)
+        {
+            const auto memberPath = path + "/" + escapeToken(i->name);
+            const auto j = to.FindMember(i->name);
+            if (j == to.MemberEnd())
+                writeOperation(writer, "remove", memberPath, nullptr);
+            else
+                writeDiff(writer, memberPath, i->value, j->value);
+        }
+        for (auto j = to.MemberBegin(); j != to.MemberEnd(); ++j)
+        {
+            if (from.FindMember(j->name) == from.MemberEnd())
+                writeOperation(writer, "add", path + "/" + escapeToken(j->name),
+                               &j->value);
+        }
+        return;
+    }
+
+    if (from.IsArray() && to.IsArray())
+    {
+        const auto common = std::min(from.Size(), to.Size());
+        for (rapidjson::SizeType i = 0; i < common; ++i)
+            writeDiff(writer, path + "/" + std::to_string(i), from[i], to[i]);
+        for (rapidjson::SizeType i = common; i < to.Size(); ++i)
+            writeOperation(writer, "add", path + "/" + std::to_string(i),
+                           &to[i]);
+        // Last elements first, as removals shift the following ones
+        for (rapidjson::SizeType i = from.Size(); i > common; --i)
+            writeOperation(writer, "remove", path + "/" + std::to_string(i - 1),
+                           nullptr);
+        return;
+    }
+
+    writeOperation(writer, "replace", path, &to);
+}
+} // namespace
+
+std::string createJsonPatch(const rapidjson::Value& from,
+                            const rapidjson::Value& to)
+{
+    rapidjson::StringBuffer buffer;
+    Writer writer(buffer);
+    writer.StartArray();
+    writeDiff(writer, "", from, to);
+    writer.EndArray();
+    return buffer.GetString();
+}
+
+std::string VersionedObject::update(const std::string& json)
+{
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    if (document.HasParseError())
+        throw std::runtime_error("Invalid JSON document");
+
+    std::string patch;
+    if (_version > 0)
+    {
+        patch = createJsonPatch(_document, document);
+        if (patch == "[]")
+            return {};
+    }
+
+    _document.Swap(document);
+    _json = json;
+    ++_version;
+
+    auto replacePatch = getReplacePatch();
+    if (patch.empty() || patch.size() > replacePatch.size())
+        return replacePatch;
+    return patch;
+}
+
+std::string VersionedObject::getReplacePatch() const
+{
+    return "[{\"op\":\"replace\",\"path\":\"\",\"value\":" + _json + "}]";
+}
+} // namespace brayns
@@ -0,0 +1,66 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#pragma once
+
+#include <rapidjson/document.h>
+
+#include <cstdint>
+#include <string>
+
+namespace brayns
+{
+/**
+ * Computes the RFC 6902 JSON patch turning one JSON document into another, as
+ * a JSON array. Objects are compared member by member and arrays element by
+ * element, elements added or removed at the end of arrays become add and
+ * remove operations.
+ */
+std::string createJsonPatch(const rapidjson::Value& from,
+                            const rapidjson::Value& to);
+
+/**
+ * The latest JSON serialization of an object, with a version incremented on
+ * every change. Each update yields the patch from the previous version, so a
+ * change is serialized and diffed once, whatever the number of clients.
+ */
+class VersionedObject
+{
+public:
+    /**
+     * Update the object to the given JSON document.
+     *
+     * @return the patch from the previous version, or a patch replacing the
+     *         whole document if it is smaller; empty if nothing changed
+     * @throw std::runtime_error if the document is not valid JSON
+     */
+    std::string update(const std::string& json);
+
+    /** @return a patch replacing the whole document by the current one */
+    std::string getReplacePatch() const;
+
+    uint64_t getVersion() const { return _version; }
+    const std::string& getJson() const { return _json; }
+
+private:
+    uint64_t _version{0};
+    std::string _json;
+    rapidjson::Document _document;
+};
+} // namespace brayns
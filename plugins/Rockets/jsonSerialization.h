@@ -30,6 +30,7 @@
 #include <brayns/common/utils/utils.h>
 #include <brayns/engine/Camera.h>
 #include <brayns/engine/Engine.h>
+#include <brayns/engine/FrameBuffer.h>
 #include <brayns/engine/Material.h>
 #include <brayns/engine/Model.h>
 #include <brayns/engine/Renderer.h>
@@ -60,6 +61,17 @@ struct SchemaParam
     std::string endpoint;
 };
 
+struct EndpointVersion
+{
+    std::string endpoint;
+    uint64_t version{0};
+};
+
+struct BinaryTransport
+{
+    bool enabled{false};
+};
+
 struct EnvironmentMapParam
 {
     std::string filename;
@@ -161,6 +173,12 @@ struct ExitLaterSchedule
     uint32_t minutes;
 };
 
+struct FrameBufferRegions
+{
+    std::string frameBuffer;
+    RenderRegions regions;
+};
+
 } // namespace brayns
 
 STATICJSON_DECLARE_ENUM(brayns::GeometryQuality,
@@ -255,6 +273,19 @@ inline void init(brayns::SchemaParam* s, ObjectHandler* h)
     h->set_flags(Flags::DisallowUnknownKey);
 }
 
+inline void init(brayns::EndpointVersion* s, ObjectHandler* h)
+{
+    h->add_property("endpoint", &s->endpoint);
+    h->add_property("version", &s->version);
+    h->set_flags(Flags::DisallowUnknownKey);
+}
+
+inline void init(brayns::BinaryTransport* s, ObjectHandler* h)
+{
+    h->add_property("enabled", &s->enabled);
+    h->set_flags(Flags::DisallowUnknownKey);
+}
+
 inline void init(brayns::EnvironmentMapParam* s, ObjectHandler* h)
 {
     h->add_property("filename", &s->filename);
@@ -308,6 +339,11 @@ inline void init(brayns::Statistics* s, ObjectHandler* h)
 {
     h->add_property("fps", &s->_fps);
     h->add_property("scene_size_in_bytes", &s->_sceneSizeInBytes);
+    h->add_property("loader_cache_hits", &s->_loaderCacheHits);
+    h->add_property("loader_cache_misses", &s->_loaderCacheMisses);
+    h->add_property("loader_cache_saved_ms",
+                    &s->_loaderCacheSavedMilliseconds);
+    h->add_property("cpu_usage", &s->_cpuUsage);
     h->set_flags(Flags::DisallowUnknownKey);
 }
 
@@ -492,6 +528,7 @@ inline void init(brayns::AnimationParameters* a, ObjectHandler* h)
 {
     h->add_property("frame_count", &a->_numFrames, Flags::Optional);
     h->add_property("current", &a->_current, Flags::Optional);
+    h->add_property("fraction", &a->_fraction, Flags::Optional);
     h->add_property("delta", &a->_delta, Flags::Optional);
     h->add_property("dt", &a->_dt, Flags::Optional);
     h->add_property("playing", &a->_playing, Flags::Optional);
@@ -620,6 +657,20 @@ inline void init(brayns::ExitLaterSchedule* a, ObjectHandler* h)
     h->set_flags(Flags::DisallowUnknownKey);
 }
 
+inline void init(brayns::RenderRegion* r, ObjectHandler* h)
+{
+    h->add_property("position", toArray<2, uint32_t>(r->position));
+    h->add_property("size", toArray<2, uint32_t>(r->size));
+    h->set_flags(Flags::DisallowUnknownKey);
+}
+
+inline void init(brayns::FrameBufferRegions* f, ObjectHandler* h)
+{
+    h->add_property("frame_buffer", &f->frameBuffer, Flags::Optional);
+    h->add_property("regions", &f->regions);
+    h->set_flags(Flags::DisallowUnknownKey);
+}
+
 } // namespace staticjson
 
 // for rockets::jsonrpc
@@ -699,6 +750,25 @@ inline bool from_json(brayns::Vector2d& obj, const std::string& json)
                                         nullptr);
 }
 
+/** Adjusts an object once the given JSON update has been applied to it. */
+template <typename T>
+inline void postJSONUpdate(T&, const std::string&)
+{
+}
+
+/** A current frame set without fraction starts at the frame itself. */
+inline void postJSONUpdate(brayns::AnimationParameters& params,
+                           const std::string& json)
+{
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    if (document.IsObject() && document.HasMember("current") &&
+        !document.HasMember("fraction"))
+    {
+        params.setFrame(params.getFrame());
+    }
+}
+
 brayns::PropertyMap jsonToPropertyMap(const std::string& json);
 
 template <typename T>
@@ -60,6 +60,35 @@ class AsyncClient(BaseClient, aobject):
         schemas = await self.rockets_client.batch(requests)
         super()._build_api(registry, requests, schemas)
 
+    async def binary_request(self, method, params=None):
+        """
+        Send a request in a binary envelope, where the large numeric arrays of the params and of
+        the result travel as raw buffers instead of JSON text.
+
+        :param str method: name of the method to call
+        :param dict params: params of the method, arrays can be lists, array.array or numpy arrays
+        :return: the result of the request, with large arrays as numpy arrays if available
+        :raises rockets.RequestError: if Brayns returned an error
+        """
+        if not self._binary_transport:
+            await self.rockets_client.request('set-binary-transport', {'enabled': True})
+            self._binary_transport = True
+
+        request_id = rockets.Request(method).request_id()
+        future = asyncio.get_event_loop().create_future()
+
+        def _on_response(message):
+            if not future.done():
+                future.set_result(message)
+
+        subscription = self._binary_responses(request_id).subscribe(_on_response)
+        try:
+            await self.rockets_client.send(self._binary_message(request_id, method, params))
+            message = await future
+        finally:
+            subscription.dispose()
+        return self._binary_result(message)
+
     # pylint: disable=W0613,W0622,E1101
     def image(self, size, format='jpg', animation_parameters=None, camera=None, quality=None,
               renderer=None, samples_per_pixel=None):
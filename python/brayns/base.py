@@ -29,6 +29,7 @@ import inspect
 import rockets
 
 from .api_generator import build_api
+from . import binary
 from .utils import base64decode, set_http_protocol, underscorize
 from .utils import HTTP_METHOD_GET, HTTP_STATUS_OK
 from .version import MINIMAL_VERSION
@@ -49,6 +50,7 @@ class BaseClient:
 
         self._check_version()
         self.rockets_client = None
+        self._binary_transport = False
 
         if utils.in_notebook():
             self._add_widgets()  # pragma: no cover
@@ -106,6 +108,28 @@ class BaseClient:
             raise Exception('Brayns does not satisfy minimal required version; '
                             'needed {0}, got {1}'.format(MINIMAL_VERSION, version))
 
+    def _binary_responses(self, request_id):
+        """Return the observable of the binary envelope answering the given request."""
+        return self.rockets_client.ws_observable \
+            .filter(binary.is_envelope) \
+            .map(binary.decode) \
+            .filter(lambda message: message.get('id') == request_id)
+
+    @staticmethod
+    def _binary_message(request_id, method, params):
+        """Return the binary envelope of the given request."""
+        message = {'jsonrpc': '2.0', 'id': request_id, 'method': method}
+        if params is not None:
+            message['params'] = params
+        return binary.encode(message)
+
+    @staticmethod
+    def _binary_result(message):
+        """Return the result of the decoded binary response, raise if it is an error."""
+        if 'error' in message:
+            raise rockets.RequestError(message['error']['code'], message['error']['message'])
+        return message.get('result')
+
     def _build_api(self, registry, requests, schemas):
         """Use the schemas from the remote running Brayns to build the API."""
         schemas_dict = dict()
@@ -175,6 +199,11 @@ class BaseClient:
                         self.image.height = viewport[1]
                         self.image.value = value
 
+                        # let Brayns adapt the stream to how fast images arrive
+                        result = rockets_client.notify('image-stream-ack')
+                        if inspect.iscoroutine(result):
+                            asyncio.ensure_future(result)
+
                     def on_completed(self):
                         self.image.close()
 
@@ -184,6 +213,7 @@ class BaseClient:
 
                 rockets_client.ws_observable \
                     .filter(lambda value: isinstance(value, (bytes, bytearray, memoryview))) \
+                    .filter(lambda value: not binary.is_envelope(value)) \
                     .subscribe(ImageStreamObserver())
 
             return show
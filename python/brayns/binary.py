@@ -0,0 +1,226 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2016-2019, Blue Brain Project
+#
+# This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+#
+# This library is free software; you can redistribute it and/or modify it under
+# the terms of the GNU Lesser General Public License version 3.0 as published
+# by the Free Software Foundation.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+# details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this library; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+# All rights reserved. Do not distribute without further notice.
+
+"""
+Binary envelope for JSON-RPC messages carrying large numeric arrays.
+
+The envelope is made of the 'BRB1' magic, the little-endian uint32 size of the header padded to 8
+bytes, the JSON header and the raw little-endian buffers, each starting on an 8 bytes boundary.
+Arrays moved to buffers are replaced in the header by {"$buffer": index, "dtype": type,
+"shape": [length] or [length, inner length]}.
+"""
+
+import array
+import json
+import struct
+import sys
+
+try:
+    import numpy
+except ImportError:  # pragma: no cover
+    numpy = None
+
+MAGIC = b'BRB1'
+MIN_ARRAY_LENGTH = 64
+_ALIGNMENT = 8
+_PREFIX = struct.Struct('<4sI')
+
+# dtype name -> array module typecode
+_TYPECODES = {'int8': 'b', 'uint8': 'B', 'int16': 'h', 'uint16': 'H', 'int32': 'i',
+              'uint32': 'I', 'int64': 'q', 'uint64': 'Q', 'float32': 'f', 'float64': 'd'}
+
+_INT_RANGES = [('int32', -2**31, 2**31 - 1), ('uint32', 0, 2**32 - 1),
+               ('int64', -2**63, 2**63 - 1), ('uint64', 0, 2**64 - 1)]
+
+
+def _padding(size):
+    return -size % _ALIGNMENT
+
+
+def is_envelope(data):
+    """Return whether the given websocket message is a binary envelope."""
+    return isinstance(data, (bytes, bytearray, memoryview)) and bytes(data[:4]) == MAGIC
+
+
+def _select_dtype(values):
+    """Return the narrowest dtype holding all the given numbers without loss."""
+    if all(isinstance(x, int) and not isinstance(x, bool) for x in values):
+        low, high = min(values), max(values)
+        for name, minimum, maximum in _INT_RANGES:
+            if minimum <= low and high <= maximum:
+                return name
+        return None
+    try:
+        if array.array('f', values).tolist() == values:
+            return 'float32'
+    except OverflowError:
+        pass
+    return 'float64'
+
+
+def _numbers_shape(value):
+    """Return the shape of a list of numbers or of a list of lists of numbers of equal length."""
+    def _is_number(x):
+        return isinstance(x, (int, float)) and not isinstance(x, bool)
+
+    if not value:
+        return None
+    if all(_is_number(x) for x in value):
+        return [len(value)]
+    if not isinstance(value[0], (list, tuple)) or not value[0]:
+        return None
+    inner = len(value[0])
+    for element in value:
+        if not isinstance(element, (list, tuple)) or len(element) != inner or \
+                not all(_is_number(x) for x in element):
+            return None
+    return [len(value), inner]
+
+
+def _to_buffer(value, min_length):
+    """Return (dtype, shape, bytes) if the value should travel as a buffer, None otherwise."""
+    if numpy is not None and isinstance(value, numpy.ndarray):
+        if value.ndim not in (1, 2) or value.size < min_length or \
+                value.dtype.name not in _TYPECODES:
+            return None
+        data = numpy.ascontiguousarray(value, dtype=value.dtype.newbyteorder('<'))
+        return value.dtype.name, list(value.shape), data.tobytes()
+
+    if isinstance(value, array.array):
+        value = value.tolist()
+    if not isinstance(value, (list, tuple)):
+        return None
+    shape = _numbers_shape(value)
+    if shape is None or (shape[0] * (shape[1] if len(shape) == 2 else 1)) < min_length:
+        return None
+    values = list(value) if len(shape) == 1 else [x for element in value for x in element]
+    dtype = _select_dtype(values)
+    if dtype is None:
+        return None
+    data = array.array(_TYPECODES[dtype], values)
+    if sys.byteorder != 'little':  # pragma: no cover
+        data.byteswap()
+    return dtype, shape, data.tobytes()
+
+
+def encode(message, min_length=MIN_ARRAY_LENGTH):
+    """
+    Wrap a JSON-RPC message into a binary envelope.
+
+    :param dict message: the JSON-RPC message, where arrays can be lists, array.array or numpy
+                         arrays
+    :param int min_length: arrays with fewer elements are kept in the JSON header
+    :return: the binary envelope
+    :rtype: bytes
+    """
+    buffers = list()
+
+    def _extract(value):
+        buffer = _to_buffer(value, min_length)
+        if buffer:
+            dtype, shape, data = buffer
+            buffers.append(data)
+            return {'$buffer': len(buffers) - 1, 'dtype': dtype, 'shape': shape}
+        if isinstance(value, dict):
+            return {key: _extract(item) for key, item in value.items()}
+        if isinstance(value, (list, tuple)):
+            return [_extract(item) for item in value]
+        return value
+
+    header = json.dumps(_extract(message), separators=(',', ':')).encode('utf-8')
+    header += b' ' * _padding(_PREFIX.size + len(header))
+
+    chunks = [_PREFIX.pack(MAGIC, len(header)), header]
+    for data in buffers:
+        chunks.append(data)
+        chunks.append(b'\0' * _padding(len(data)))
+    return b''.join(chunks)
+
+
+def _from_buffer(data, dtype, shape):
+    typecode = _TYPECODES[dtype]
+    if numpy is not None:
+        values = numpy.frombuffer(data, dtype=numpy.dtype(dtype).newbyteorder('<'))
+        return values.reshape(shape)
+    values = array.array(typecode)
+    values.frombytes(data)
+    if sys.byteorder != 'little':  # pragma: no cover
+        values.byteswap()
+    if len(shape) == 1:
+        return values
+    inner = shape[1]
+    return [values[i:i + inner].tolist() for i in range(0, len(values), inner)]
+
+
+def decode(data):
+    """
+    Unwrap the JSON-RPC message of a binary envelope.
+
+    :param bytes data: the binary envelope
+    :return: the JSON-RPC message, with buffers as numpy arrays if numpy is available, otherwise
+             as array.array for flat arrays and lists of lists for 2D arrays
+    :rtype: dict
+    """
+    data = memoryview(data)
+    magic, header_size = _PREFIX.unpack_from(data)
+    if magic != MAGIC:
+        raise ValueError('Not a binary envelope')
+    header = json.loads(bytes(data[_PREFIX.size:_PREFIX.size + header_size]).decode('utf-8'))
+
+    references = dict()
+
+    def _collect(value):
+        if isinstance(value, dict):
+            if '$buffer' in value:
+                references[value['$buffer']] = value
+            else:
+                for item in value.values():
+                    _collect(item)
+        elif isinstance(value, list):
+            for item in value:
+                _collect(item)
+
+    _collect(header)
+
+    offset = _PREFIX.size + header_size
+    offset += _padding(offset)
+    arrays = dict()
+    for index in sorted(references):
+        reference = references[index]
+        shape = reference['shape']
+        size = struct.calcsize('<' + _TYPECODES[reference['dtype']])
+        for length in shape:
+            size *= length
+        if offset + size > len(data):
+            raise ValueError('Truncated binary buffer')
+        arrays[index] = _from_buffer(data[offset:offset + size], reference['dtype'], shape)
+        offset += size + _padding(size)
+
+    def _expand(value):
+        if isinstance(value, dict):
+            if '$buffer' in value:
+                return arrays[value['$buffer']]
+            return {key: _expand(item) for key, item in value.items()}
+        if isinstance(value, list):
+            return [_expand(item) for item in value]
+        return value
+
+    return _expand(header)
@@ -24,6 +24,7 @@
 
 """Client that connects to a remote running Brayns instance which provides the supported API."""
 
+import queue
 import rockets
 
 from .base import BaseClient
@@ -48,6 +49,34 @@ class Client(BaseClient):
         schemas = self.rockets_client.batch(requests)
         super()._build_api(registry, requests, schemas)
 
+    def binary_request(self, method, params=None, response_timeout=None):
+        """
+        Send a request in a binary envelope, where the large numeric arrays of the params and of
+        the result travel as raw buffers instead of JSON text.
+
+        :param str method: name of the method to call
+        :param dict params: params of the method, arrays can be lists, array.array or numpy arrays
+        :param int response_timeout: number of seconds to wait for the response
+        :return: the result of the request, with large arrays as numpy arrays if available
+        :raises rockets.RequestError: if Brayns returned an error
+        :raises TimeoutError: if the response did not arrive in time
+        """
+        if not self._binary_transport:
+            self.rockets_client.request('set-binary-transport', {'enabled': True})
+            self._binary_transport = True
+
+        request_id = rockets.Request(method).request_id()
+        responses = queue.Queue()
+        subscription = self._binary_responses(request_id).subscribe(responses.put)
+        try:
+            self.rockets_client.send(self._binary_message(request_id, method, params))
+            message = responses.get(timeout=response_timeout)
+        except queue.Empty:
+            raise TimeoutError('No response to {0} in time'.format(method))
+        finally:
+            subscription.dispose()
+        return self._binary_result(message)
+
     # pylint: disable=W0613,W0622,E1101
     def image(self, size, format='jpg', animation_parameters=None, camera=None, quality=None,
               renderer=None, samples_per_pixel=None):
@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2016-2019, Blue Brain Project
+#
+# This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+#
+# This library is free software; you can redistribute it and/or modify it under
+# the terms of the GNU Lesser General Public License version 3.0 as published
+# by the Free Software Foundation.
+#
+# This library is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+# FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+# details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this library; if not, write to the Free Software Foundation, Inc.,
+# 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+# All rights reserved. Do not distribute without further notice.
+
+import json
+import struct
+
+from nose.tools import assert_true, assert_false, assert_equal, raises
+from brayns import binary
+
+
+def _header(envelope):
+    size = struct.unpack_from('<I', envelope, 4)[0]
+    return json.loads(envelope[8:8 + size].decode('utf-8'))
+
+
+def test_small_arrays_stay_in_header():
+    message = {'jsonrpc': '2.0', 'id': 1, 'method': 'test', 'params': {'values': [1, 2, 3]}}
+    envelope = binary.encode(message)
+    assert_true(binary.is_envelope(envelope))
+    assert_equal(len(envelope) % 8, 0)
+    assert_equal(_header(envelope), message)
+    assert_equal(binary.decode(envelope), message)
+
+
+def test_dtypes():
+    params = {'int32': list(range(-32, 32)), 'uint32': [2**31] * 64, 'int64': [-2**40] * 64,
+              'float32': [0.5] * 64, 'float64': [0.1] * 64}
+    envelope = binary.encode({'id': 1, 'result': params})
+    header = _header(envelope)['result']
+    for dtype in params:
+        assert_equal(header[dtype]['dtype'], dtype)
+        assert_equal(header[dtype]['shape'], [64])
+
+    result = binary.decode(envelope)['result']
+    for dtype, values in params.items():
+        assert_equal(list(result[dtype]), values)
+
+
+def test_nested_arrays():
+    colors = [[0.25, 0.5, 1.0, 1.0]] * 32
+    envelope = binary.encode({'id': 1, 'params': {'colors': colors, 'mixed': [[1, 2], [3]] * 64}})
+    header = _header(envelope)['params']
+    assert_equal(header['colors'], {'$buffer': 0, 'dtype': 'float32', 'shape': [32, 4]})
+    assert_equal(header['mixed'], [[1, 2], [3]] * 64)
+
+    params = binary.decode(envelope)['params']
+    assert_equal([list(color) for color in params['colors']], colors)
+
+
+def test_buffers_are_aligned():
+    envelope = binary.encode({'id': 1, 'params': [[1] * 65, [0.5] * 67]}, min_length=1)
+    header = _header(envelope)
+    assert_equal(header['params'][0]['dtype'], 'int32')
+    assert_equal(header['params'][1]['dtype'], 'float32')
+    assert_equal(len(envelope) % 8, 0)
+    params = binary.decode(envelope)['params']
+    assert_equal(list(params[0]), [1] * 65)
+    assert_equal(list(params[1]), [0.5] * 67)
+
+
+def test_not_an_envelope():
+    assert_false(binary.is_envelope('{"id": 1}'))
+    assert_false(binary.is_envelope(b'\x89PNG'))
+
+
+@raises(ValueError)
+def test_truncated_envelope():
+    envelope = binary.encode({'id': 1, 'result': [0.5] * 64})
+    binary.decode(envelope[:-8])
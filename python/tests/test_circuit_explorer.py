@@ -104,6 +104,27 @@ def test_set_materials():
             emissions=emissions, refraction_indices=refraction_indices)
         assert_equal(response, {'ok'})
 
+def test_set_materials_packed():
+    with patch('rockets.AsyncClient.connected', new=mock_connected), \
+         patch('brayns.utils.http_request', new=mock_http_request), \
+         patch('brayns.utils.in_notebook', new=mock_not_in_notebook), \
+         patch('rockets.Client.request', new=mock_ce_rpc_request), \
+         patch('rockets.Client.batch', new=mock_batch):
+        app = brayns.Client('localhost:8200')
+        ce = CircuitExplorer(app)
+        response = ce.set_materials(
+            model_ids=[0], material_ids=[0, 1],
+            diffuse_colors=[(1, 0, 0), (0, 1, 0)], specular_colors=[(1, 1, 1), (1, 1, 1)],
+            opacities=[1.0, 0.5], simulation_data_casts=[True, False],
+            shading_modes=[ce.SHADING_MODE_DIFFUSE, ce.SHADING_MODE_CARTOON], packed=True)
+        assert_equal(response, {'ok'})
+
+
+def test_pack_column():
+    assert_equal(CircuitExplorer._pack_column([1.0, 2.0], 'f'), 'AACAPwAAAEA=')
+    assert_equal(CircuitExplorer._pack_column([True, False], 'B'), 'AQA=')
+
+
 def test_set_material_range():
     with patch('rockets.AsyncClient.connected', new=mock_connected), \
          patch('brayns.utils.http_request', new=mock_http_request), \
@@ -0,0 +1,167 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../plugins/Rockets/AdaptiveImageStream.h"
+
+using brayns::AdaptiveImageStream;
+
+namespace
+{
+const auto FRAME_INTERVAL = std::chrono::milliseconds(40);
+const uintptr_t FAST_CLIENT = 1;
+const uintptr_t SLOW_CLIENT = 2;
+const uintptr_t LEGACY_CLIENT = 3;
+
+/** Send the scheduled frames, and return the clients which received one. */
+std::set<uintptr_t> sendFrame(AdaptiveImageStream& stream,
+                              const std::set<uintptr_t>& clients,
+                              const AdaptiveImageStream::Clock::time_point now)
+{
+    std::set<uintptr_t> receivers;
+    for (const auto& tier : stream.schedule(clients, FRAME_INTERVAL, now))
+    {
+        for (const auto clientID : tier.second)
+        {
+            CHECK_EQ(tier.first, stream.getTier(clientID));
+            stream.onSent(clientID, now);
+            receivers.insert(clientID);
+        }
+    }
+    return receivers;
+}
+} // namespace
+
+TEST_CASE("legacy_clients_get_every_frame")
+{
+    AdaptiveImageStream stream;
+    auto now = AdaptiveImageStream::Clock::now();
+    for (size_t i = 0; i < 100; ++i, now += FRAME_INTERVAL)
+        CHECK_EQ(sendFrame(stream, {LEGACY_CLIENT}, now),
+                 std::set<uintptr_t>{LEGACY_CLIENT});
+    CHECK_EQ(stream.getTier(LEGACY_CLIENT), 0);
+}
+
+TEST_CASE("slow_client_does_not_hold_back_fast_one")
+{
+    AdaptiveImageStream stream;
+    auto now = AdaptiveImageStream::Clock::now();
+    const std::set<uintptr_t> clients{FAST_CLIENT, SLOW_CLIENT, LEGACY_CLIENT};
+    stream.acknowledge(FAST_CLIENT, now);
+    stream.acknowledge(SLOW_CLIENT, now);
+
+    // The fast client acknowledges each frame before the next one, the slow
+    // one needs four frame intervals per frame
+    std::deque<AdaptiveImageStream::Clock::time_point> slowFrames;
+    size_t nbFast = 0;
+    size_t nbSlow = 0;
+    for (size_t i = 0; i < 200; ++i, now += FRAME_INTERVAL)
+    {
+        if (i % 4 == 0 && !slowFrames.empty())
+        {
+            stream.acknowledge(SLOW_CLIENT, now);
+            slowFrames.pop_front();
+        }
+
+        const auto receivers = sendFrame(stream, clients, now);
+        CHECK(receivers.count(FAST_CLIENT));
+        CHECK(receivers.count(LEGACY_CLIENT));
+        nbFast += receivers.count(FAST_CLIENT);
+        if (receivers.count(SLOW_CLIENT))
+        {
+            ++nbSlow;
+            slowFrames.push_back(now);
+        }
+        stream.acknowledge(FAST_CLIENT, now + FRAME_INTERVAL / 4);
+    }
+
+    CHECK_EQ(nbFast, 200);
+    CHECK_LT(nbSlow, 100);
+    CHECK_GT(nbSlow, 0);
+    CHECK_EQ(stream.getTier(FAST_CLIENT), 0);
+    CHECK_EQ(stream.getTier(SLOW_CLIENT),
+             AdaptiveImageStream::getTiers().size() - 1);
+}
+
+TEST_CASE("recovered_client_moves_back_up")
+{
+    AdaptiveImageStream stream;
+    auto now = AdaptiveImageStream::Clock::now();
+    stream.acknowledge(SLOW_CLIENT, now);
+
+    // Never acknowledging fills the frames in flight and degrades the client
+    for (size_t i = 0; i < 20; ++i, now += FRAME_INTERVAL)
+        sendFrame(stream, {SLOW_CLIENT}, now);
+    CHECK_GT(stream.getTier(SLOW_CLIENT), 0);
+
+    // Frames in flight for too long are dropped, fast acknowledgements then
+    // upgrade the client back to the best tier
+    now += std::chrono::seconds(10);
+    for (size_t i = 0; i < 1000; ++i, now += FRAME_INTERVAL)
+    {
+        if (sendFrame(stream, {SLOW_CLIENT}, now).count(SLOW_CLIENT))
+            stream.acknowledge(SLOW_CLIENT, now + FRAME_INTERVAL / 4);
+    }
+    CHECK_EQ(stream.getTier(SLOW_CLIENT), 0);
+
+    stream.removeClient(SLOW_CLIENT);
+    CHECK_EQ(stream.getTier(SLOW_CLIENT), 0);
+}
+
+TEST_CASE("frames_sent_before_tracking_are_ignored")
+{
+    AdaptiveImageStream stream;
+    auto now = AdaptiveImageStream::Clock::now();
+
+    // The client receives frames before it starts acknowledging, then
+    // acknowledges every frame four frame intervals after it was sent
+    const size_t latency = 4;
+    std::deque<AdaptiveImageStream::Clock::time_point> received;
+    const auto play = [&](const size_t nbFrames, const bool send) {
+        size_t nbReceived = 0;
+        for (size_t i = 0; i < nbFrames; ++i, now += FRAME_INTERVAL)
+        {
+            while (!received.empty() &&
+                   now - received.front() >= latency * FRAME_INTERVAL)
+            {
+                stream.acknowledge(SLOW_CLIENT, now);
+                received.pop_front();
+            }
+            if (send &&
+                sendFrame(stream, {SLOW_CLIENT}, now).count(SLOW_CLIENT))
+            {
+                received.push_back(now);
+                ++nbReceived;
+            }
+        }
+        return nbReceived;
+    };
+
+    play(100, true);
+
+    // No frame is sent for a while, e.g. because the scene does not change,
+    // the client acknowledges all the frames it received
+    play(10, false);
+
+    // The base latency is not mistaken for a backlog
+    CHECK_EQ(play(100, true), 100);
+    CHECK_EQ(stream.getTier(SLOW_CLIENT), 0);
+}
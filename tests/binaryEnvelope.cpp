@@ -0,0 +1,160 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../plugins/Rockets/BinaryEnvelope.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+std::string makeArray(const std::string& value, const size_t size)
+{
+    std::string array = "[";
+    for (size_t i = 0; i < size; ++i)
+        array += (i == 0 ? "" : ",") + value;
+    return array + "]";
+}
+
+/** @return an envelope with the given header and 16 bytes of buffers */
+std::string makeEnvelope(std::string header)
+{
+    header.resize(header.size() + (8 - header.size() % 8) % 8, ' ');
+    const uint32_t size = header.size();
+    std::string envelope = "BRB1";
+    envelope.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    envelope += header;
+    envelope += std::string(1, '\1') + std::string(7, '\0');
+    envelope += std::string(1, '\2') + std::string(7, '\0');
+    return envelope;
+}
+
+std::string getHeader(const std::string& envelope)
+{
+    uint32_t size;
+    memcpy(&size, envelope.data() + 4, sizeof(size));
+    auto header = envelope.substr(8, size);
+    return header.substr(0, header.find_last_not_of(' ') + 1);
+}
+} // namespace
+
+TEST_CASE("small_arrays_stay_in_header")
+{
+    const std::string json = R"({"id":1,"result":{"values":[1,2,3]}})";
+    const auto envelope = brayns::encodeBinaryEnvelope(json);
+    CHECK(brayns::isBinaryEnvelope(envelope));
+    CHECK_EQ(envelope.size() % 8, 0);
+    CHECK_EQ(getHeader(envelope), json);
+    CHECK_EQ(brayns::decodeBinaryEnvelope(envelope), json);
+    CHECK(!brayns::isBinaryEnvelope(json));
+}
+
+TEST_CASE("round_trip")
+{
+    const std::string json = R"({"id":1,"result":{"ints":)" +
+                             makeArray("-7", 100) + R"(,"floats":)" +
+                             makeArray("0.25", 65) + R"(,"doubles":)" +
+                             makeArray("0.1", 64) + R"(,"colors":)" +
+                             makeArray("[0.5,1.0,0.0]", 32) + "}}";
+    const auto envelope = brayns::encodeBinaryEnvelope(json);
+    CHECK_EQ(envelope.size() % 8, 0);
+    CHECK_LT(envelope.size(), json.size());
+
+    const auto header = getHeader(envelope);
+    CHECK_NE(header.find(
+                 R"("ints":{"$buffer":0,"dtype":"int32","shape":[100]})"),
+             std::string::npos);
+    CHECK_NE(header.find(R"("floats":{"$buffer":1,"dtype":"float32")"),
+             std::string::npos);
+    CHECK_NE(header.find(R"("doubles":{"$buffer":2,"dtype":"float64")"),
+             std::string::npos);
+    CHECK_NE(header.find(R"("shape":[32,3])"), std::string::npos);
+
+    CHECK_EQ(brayns::decodeBinaryEnvelope(envelope), json);
+}
+
+TEST_CASE("invalid_envelopes")
+{
+    const auto envelope = brayns::encodeBinaryEnvelope(
+        R"({"id":1,"params":)" + makeArray("0.5", 64) + "}");
+    CHECK_THROWS_AS(brayns::decodeBinaryEnvelope(
+                        envelope.substr(0, envelope.size() - 8)),
+                    std::runtime_error);
+    CHECK_THROWS_AS(brayns::decodeBinaryEnvelope("BRB1"), std::runtime_error);
+    CHECK_THROWS_AS(brayns::decodeBinaryEnvelope(R"({"id":1})"),
+                    std::runtime_error);
+
+    const auto overflowing =
+        makeEnvelope(R"({"params":{"$buffer":0,"dtype":"int32",)"
+                     R"("shape":[4294967295,4294967295]}})");
+    CHECK_THROWS_AS(brayns::decodeBinaryEnvelope(overflowing),
+                    std::runtime_error);
+}
+
+TEST_CASE("invalid_buffer_indices")
+{
+    // An oversized index must be rejected before anything is allocated
+    const auto oversized =
+        makeEnvelope(R"({"params":{"$buffer":4294967295,"dtype":"int8",)"
+                     R"("shape":[1]}})");
+    CHECK_THROWS_AS(brayns::decodeBinaryEnvelope(oversized),
+                    std::runtime_error);
+
+    const auto gap = makeEnvelope(
+        R"({"params":[{"$buffer":0,"dtype":"int8","shape":[1]},)"
+        R"({"$buffer":2,"dtype":"int8","shape":[1]}]})");
+    CHECK_THROWS_AS(brayns::decodeBinaryEnvelope(gap), std::runtime_error);
+
+    const auto duplicate = makeEnvelope(
+        R"({"params":[{"$buffer":1,"dtype":"int8","shape":[1]},)"
+        R"({"$buffer":1,"dtype":"int8","shape":[1]}]})");
+    CHECK_THROWS_AS(brayns::decodeBinaryEnvelope(duplicate),
+                    std::runtime_error);
+
+    const auto swapped = makeEnvelope(
+        R"({"params":[{"$buffer":1,"dtype":"int8","shape":[1]},)"
+        R"({"$buffer":0,"dtype":"int8","shape":[1]}]})");
+    CHECK_EQ(brayns::decodeBinaryEnvelope(swapped), R"({"params":[2,1]})");
+}
+
+TEST_CASE("mark_binary_arrays")
+{
+    const std::string schema =
+        R"({"type":"object","properties":{)"
+        R"("values":{"type":"array","items":{"type":"number"}},)"
+        R"("position":{"type":"array","items":{"type":"number"},)"
+        R"("maxItems":3},)"
+        R"("colors":{"type":"array","items":{"type":"array",)"
+        R"("items":{"type":"number"},"maxItems":3}},)"
+        R"("names":{"type":"array","items":{"type":"string"}}}})";
+    const std::string expected =
+        R"({"type":"object","properties":{)"
+        R"("values":{"type":"array","items":{"type":"number"},)"
+        R"("binary":true},)"
+        R"("position":{"type":"array","items":{"type":"number"},)"
+        R"("maxItems":3},)"
+        R"("colors":{"type":"array","items":{"type":"array",)"
+        R"("items":{"type":"number"},"maxItems":3},"binary":true},)"
+        R"("names":{"type":"array","items":{"type":"string"}}}})";
+    CHECK_EQ(brayns::markBinaryArrays(schema), expected);
+}
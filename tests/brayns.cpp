@@ -18,6 +18,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <tests/paths.h>
+
 #include <brayns/Brayns.h>
 
 #include <brayns/engine/Camera.h>
@@ -28,6 +30,10 @@
 #include <brayns/manipulators/InspectCenterManipulator.h>
 #include <brayns/parameters/ParametersManager.h>
 
+#include <brayns/common/utils/filesystem.h>
+
+#include <fstream>
+
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 
@@ -109,3 +115,110 @@ TEST_CASE("bvh_type")
     CHECK(bvhFlags.count(brayns::BVHFlag::robust) > 0);
     CHECK(bvhFlags.count(brayns::BVHFlag::compact) > 0);
 }
+
+TEST_CASE("loader_cache")
+{
+    const auto cacheFolder =
+        (fs::temp_directory_path() / "brayns_loader_cache_test").string();
+    fs::remove_all(cacheFolder);
+
+    const char* argv[] = {"brayns", "--loader-cache", cacheFolder.c_str()};
+    const int argc = sizeof(argv) / sizeof(char*);
+    brayns::Brayns brayns(argc, argv);
+
+    auto& scene = brayns.getEngine().getScene();
+    const brayns::ModelParams params{BRAYNS_TESTDATA_MODEL_PDB_PATH};
+    auto imported = scene.loadModel(BRAYNS_TESTDATA_MODEL_PDB_PATH, params, {});
+    auto cached = scene.loadModel(BRAYNS_TESTDATA_MODEL_PDB_PATH, params, {});
+
+    const auto stats = scene.getLoaderCache().getStats();
+    CHECK_EQ(stats.misses, 1);
+    CHECK_EQ(stats.hits, 1);
+
+    const auto& importedModel = imported->getModel();
+    const auto& cachedModel = cached->getModel();
+    CHECK_EQ(cached->getName(), imported->getName());
+    CHECK_EQ(cachedModel.getMaterials().size(),
+             importedModel.getMaterials().size());
+    CHECK_EQ(cachedModel.getSpheres().size(),
+             importedModel.getSpheres().size());
+    CHECK_EQ(cachedModel.getCylinders().size(),
+             importedModel.getCylinders().size());
+    CHECK_EQ(cached->getBounds(), imported->getBounds());
+
+    fs::remove_all(cacheFolder);
+}
+
+TEST_CASE("loader_cache_defaults")
+{
+    const auto cacheFolder =
+        (fs::temp_directory_path() / "brayns_loader_cache_defaults").string();
+    fs::remove_all(cacheFolder);
+
+    const brayns::ModelParams params{BRAYNS_TESTDATA_MODEL_PDB_PATH};
+    {
+        const char* argv[] = {"brayns", "--loader-cache", cacheFolder.c_str()};
+        const int argc = sizeof(argv) / sizeof(char*);
+        brayns::Brayns brayns(argc, argv);
+        brayns.getEngine().getScene().loadModel(BRAYNS_TESTDATA_MODEL_PDB_PATH,
+                                                params, {});
+    }
+
+    // The loader default of the radius multiplier comes from the command line
+    const char* argv[] = {"brayns", "--loader-cache", cacheFolder.c_str(),
+                          "--radius-multiplier", "2"};
+    const int argc = sizeof(argv) / sizeof(char*);
+    brayns::Brayns brayns(argc, argv);
+    auto& scene = brayns.getEngine().getScene();
+    scene.loadModel(BRAYNS_TESTDATA_MODEL_PDB_PATH, params, {});
+    scene.loadModel(BRAYNS_TESTDATA_MODEL_PDB_PATH, params, {});
+
+    const auto stats = scene.getLoaderCache().getStats();
+    CHECK_EQ(stats.misses, 1);
+    CHECK_EQ(stats.hits, 1);
+
+    fs::remove_all(cacheFolder);
+}
+
+TEST_CASE("loader_cache_corrupted")
+{
+    const auto cacheFolder =
+        (fs::temp_directory_path() / "brayns_loader_cache_corrupted").string();
+    fs::remove_all(cacheFolder);
+
+    const char* argv[] = {"brayns", "--loader-cache", cacheFolder.c_str()};
+    const int argc = sizeof(argv) / sizeof(char*);
+    brayns::Brayns brayns(argc, argv);
+
+    auto& scene = brayns.getEngine().getScene();
+    const brayns::ModelParams params{BRAYNS_TESTDATA_MODEL_PDB_PATH};
+    auto imported = scene.loadModel(BRAYNS_TESTDATA_MODEL_PDB_PATH, params, {});
+
+    // Keep the header of the entry and replace the model by an impossible
+    // name length
+    const auto filename = fs::directory_iterator(cacheFolder)->path().string();
+    {
+        std::fstream file(filename,
+                          std::ios::in | std::ios::out | std::ios::binary);
+        size_t size = 0;
+        file.read((char*)&size, sizeof(size));
+        file.seekg(size, std::ios::cur); // magic
+        file.seekg(sizeof(size_t), std::ios::cur); // version
+        file.read((char*)&size, sizeof(size));
+        file.seekg(size + sizeof(uint64_t), std::ios::cur); // key, time
+        const size_t nameLength = size_t(1) << 40;
+        file.seekp(file.tellg());
+        file.write((const char*)&nameLength, sizeof(nameLength));
+        REQUIRE(file.good());
+    }
+
+    auto reimported =
+        scene.loadModel(BRAYNS_TESTDATA_MODEL_PDB_PATH, params, {});
+    const auto stats = scene.getLoaderCache().getStats();
+    CHECK_EQ(stats.misses, 2);
+    CHECK_EQ(stats.hits, 0);
+    CHECK_EQ(reimported->getModel().getSpheres().size(),
+             imported->getModel().getSpheres().size());
+
+    fs::remove_all(cacheFolder);
+}
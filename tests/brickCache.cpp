@@ -0,0 +1,166 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <brayns/common/geometry/Frustum.h>
+#include <brayns/common/volume/BrickCache.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+using brayns::BrickCache;
+
+namespace
+{
+const brayns::Vector3ui DIMENSIONS(70, 66, 9);
+const size_t BRICK_BYTES = BrickCache::BRICK_SIZE * BrickCache::BRICK_SIZE *
+                           BrickCache::BRICK_SIZE * sizeof(uint16_t);
+
+uint16_t voxel(const size_t x, const size_t y, const size_t z)
+{
+    return x + 100 * y + 10000 * z;
+}
+
+/** A raw file of 16 bit voxels, removed at the end of the test. */
+struct RawFile
+{
+    RawFile()
+    {
+        char name[] = "/tmp/brickCacheXXXXXX";
+        ::close(::mkstemp(name));
+        filename = name;
+
+        std::ofstream file(filename, std::ios::binary);
+        for (size_t z = 0; z < DIMENSIONS.z; ++z)
+            for (size_t y = 0; y < DIMENSIONS.y; ++y)
+                for (size_t x = 0; x < DIMENSIONS.x; ++x)
+                {
+                    const auto value = voxel(x, y, z);
+                    file.write(reinterpret_cast<const char*>(&value),
+                               sizeof(value));
+                }
+    }
+    ~RawFile() { std::remove(filename.c_str()); }
+
+    std::string filename;
+};
+
+uint16_t brickVoxel(const BrickCache& cache, const size_t brick,
+                    const size_t x, const size_t y, const size_t z)
+{
+    const auto voxels =
+        static_cast<const uint16_t*>(cache.getBricks()[brick]);
+    return voxels[x + BrickCache::BRICK_SIZE * (y + BrickCache::BRICK_SIZE * z)];
+}
+} // namespace
+
+TEST_CASE("coarse_level")
+{
+    RawFile file;
+    BrickCache cache(file.filename, DIMENSIONS, brayns::DataType::UINT16, 0);
+    CHECK_EQ(cache.getBrickCounts(), brayns::Vector3ui(2, 2, 1));
+    CHECK_EQ(cache.getCoarseDimensions(), brayns::Vector3ui(9, 9, 2));
+
+    const auto coarse =
+        reinterpret_cast<const uint16_t*>(cache.getCoarseVoxels().data());
+    CHECK_EQ(coarse[0], voxel(0, 0, 0));
+    CHECK_EQ(coarse[8], voxel(64, 0, 0));
+    CHECK_EQ(coarse[9 * 9 + 9 + 2], voxel(16, 8, 8));
+
+    // Nothing fits in the budget
+    CHECK(!cache.update({0, 1, 2, 3}));
+    for (const auto brick : cache.getBricks())
+        CHECK_EQ(brick, nullptr);
+}
+
+TEST_CASE("least_recently_used_bricks_are_evicted")
+{
+    RawFile file;
+    BrickCache cache(file.filename, DIMENSIONS, brayns::DataType::UINT16,
+                     2 * BRICK_BYTES);
+
+    // Only the two most important bricks are loaded
+    CHECK(cache.update({3, 1, 0}));
+    CHECK_EQ(cache.getBricks()[0], nullptr);
+    CHECK_NE(cache.getBricks()[1], nullptr);
+    CHECK_NE(cache.getBricks()[3], nullptr);
+    CHECK_EQ(brickVoxel(cache, 3, 0, 0, 0), voxel(64, 64, 0));
+    CHECK_EQ(brickVoxel(cache, 3, 5, 1, 8), voxel(69, 65, 8));
+    CHECK_EQ(brickVoxel(cache, 1, 3, 63, 2), voxel(67, 63, 2));
+    CHECK_EQ(cache.getBrickBounds(1),
+             brayns::Boxd({64, 0, 0}, {70, 64, 9}));
+
+    // Brick 1 is then less important, so used less recently than brick 3
+    CHECK(!cache.update({3, 1}));
+    CHECK(cache.update({0}));
+    CHECK_NE(cache.getBricks()[0], nullptr);
+    CHECK_EQ(cache.getBricks()[1], nullptr);
+    CHECK_NE(cache.getBricks()[3], nullptr);
+    CHECK_EQ(brickVoxel(cache, 0, 10, 20, 3), voxel(10, 20, 3));
+}
+
+TEST_CASE("loads_are_capped_per_update")
+{
+    RawFile file;
+    BrickCache cache(file.filename, DIMENSIONS, brayns::DataType::UINT16,
+                     4 * BRICK_BYTES);
+
+    // The most important missing bricks are read first
+    CHECK(cache.update({2, 0, 3}, 2));
+    CHECK_EQ(cache.getNbPending(), 1);
+    CHECK_NE(cache.getBricks()[2], nullptr);
+    CHECK_NE(cache.getBricks()[0], nullptr);
+    CHECK_EQ(cache.getBricks()[3], nullptr);
+
+    CHECK(cache.update({2, 0, 3}, 2));
+    CHECK_EQ(cache.getNbPending(), 0);
+    CHECK_NE(cache.getBricks()[3], nullptr);
+    CHECK_EQ(brickVoxel(cache, 3, 5, 1, 8), voxel(69, 65, 8));
+
+    CHECK(!cache.update({2, 0, 3}, 2));
+}
+
+TEST_CASE("invalid_files")
+{
+    CHECK_THROWS_AS(BrickCache("/tmp/does/not/exist", DIMENSIONS,
+                               brayns::DataType::UINT16, 0),
+                    std::runtime_error);
+
+    RawFile file;
+    CHECK_THROWS_AS(BrickCache(file.filename, DIMENSIONS,
+                               brayns::DataType::FLOAT, 0),
+                    std::runtime_error);
+}
+
+TEST_CASE("frustum")
+{
+    const brayns::Frustum frustum({0, 0, 5}, brayns::Quaterniond(), 90., 2.);
+    CHECK(frustum.intersects({{-1, -1, -1}, {1, 1, 1}}));
+    CHECK(frustum.intersects({{9, -1, -1}, {10, 1, 1}}));
+    CHECK(!frustum.intersects({{13, -1, -1}, {14, 1, 1}}));
+    CHECK(!frustum.intersects({{-1, 7, -1}, {1, 8, 1}}));
+    CHECK(!frustum.intersects({{-1, -1, 6}, {1, 1, 7}}));
+
+    const brayns::Frustum unbounded;
+    CHECK(unbounded.intersects({{-1, -1, 6}, {1, 1, 7}}));
+}
@@ -20,11 +20,39 @@
 
 #include "ClientServer.h"
 
+#include <brayns/common/scene/ClipPlane.h>
+
 const std::string ADD_CLIP_PLANE("add-clip-plane");
 const std::string GET_CLIP_PLANES("get-clip-planes");
 const std::string REMOVE_CLIP_PLANES("remove-clip-planes");
 const std::string UPDATE_CLIP_PLANE("update-clip-plane");
 
+TEST_CASE("box_clipping")
+{
+    const brayns::Boxd box{{0, 0, 0}, {1, 1, 1}};
+    const auto makePlanes = [](const brayns::Planes& planes) {
+        brayns::ClipPlanes clipPlanes;
+        for (const auto& plane : planes)
+            clipPlanes.push_back(std::make_shared<brayns::ClipPlane>(plane));
+        return clipPlanes;
+    };
+
+    CHECK(!brayns::isClipped(box, {}));
+    // Visible side is x > 0.5, then x > 2
+    CHECK(!brayns::isClipped(box, makePlanes({{{1, 0, 0, -0.5}}})));
+    CHECK(brayns::isClipped(box, makePlanes({{{1, 0, 0, -2}}})));
+    // Visible side is y < -1
+    CHECK(brayns::isClipped(box, makePlanes({{{0, -1, 0, -1}}})));
+    // Slab 0.25 < z < 0.5 intersects the box, 2 < z < 3 does not
+    CHECK(!brayns::isClipped(box, makePlanes({{{0, 0, 1, -0.25}},
+                                              {{0, 0, -1, 0.5}}})));
+    CHECK(brayns::isClipped(box,
+                            makePlanes({{{0, 0, 1, -2}}, {{0, 0, -1, 3}}})));
+    // Diagonal plane x + y + z > 2.9 only keeps the corner at (1, 1, 1)
+    CHECK(!brayns::isClipped(box, makePlanes({{{1, 1, 1, -2.9}}})));
+    CHECK(brayns::isClipped(box, makePlanes({{{1, 1, 1, -3.1}}})));
+}
+
 TEST_CASE_FIXTURE(ClientServer, "add_plane")
 {
     REQUIRE(getScene().getClipPlanes().empty());
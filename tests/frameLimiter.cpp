@@ -0,0 +1,78 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <brayns/common/FrameLimiter.h>
+#include <brayns/common/Timer.h>
+
+#include <thread>
+
+using Clock = brayns::FrameLimiter::Clock;
+
+namespace
+{
+double secondsSince(const Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+} // namespace
+
+TEST_CASE("paces_frames")
+{
+    brayns::FrameLimiter limiter;
+    limiter.waitForNextFrame(100.);
+    const auto start = Clock::now();
+    for (size_t i = 0; i < 20; ++i)
+        limiter.waitForNextFrame(100.);
+    CHECK_GE(secondsSince(start), 0.199);
+}
+
+TEST_CASE("no_limit")
+{
+    brayns::FrameLimiter limiter;
+    const auto start = Clock::now();
+    for (size_t i = 0; i < 1000; ++i)
+        limiter.waitForNextFrame(0.);
+    CHECK_LT(secondsSince(start), 0.5);
+}
+
+TEST_CASE("late_frame_does_not_burst")
+{
+    brayns::FrameLimiter limiter;
+    limiter.waitForNextFrame(50.);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // The late frame starts immediately, the next one a period later
+    limiter.waitForNextFrame(50.);
+    const auto start = Clock::now();
+    limiter.waitForNextFrame(50.);
+    CHECK_GE(secondsSince(start), 0.019);
+}
+
+TEST_CASE("cpu_usage")
+{
+    brayns::CPUUsage usage;
+    const auto start = Clock::now();
+    volatile size_t sum = 0;
+    while (secondsSince(start) < 0.05)
+        sum = sum + 1;
+    CHECK_GT(usage.sample(), 0.);
+}
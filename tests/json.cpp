@@ -58,3 +58,25 @@ TEST_CASE("loaderProperties")
             "array");
     CHECK(origArray == parseArray);
 }
+
+TEST_CASE("animation_current_resets_fraction")
+{
+    brayns::AnimationParameters params;
+    params.setNumFrames(10);
+    params.setFramePosition(3.5);
+
+    // As applied by the animation-parameters endpoint
+    const auto update = [&params](const std::string& json) {
+        REQUIRE(from_json(params, json));
+        postJSONUpdate(params, json);
+    };
+
+    update(R"({"current": 5})");
+    CHECK_EQ(params.getFramePosition(), 5.);
+
+    update(R"({"current": 6, "fraction": 0.25})");
+    CHECK_EQ(params.getFramePosition(), 6.25);
+
+    update(R"({"delta": 0.5})");
+    CHECK_EQ(params.getFramePosition(), 6.25);
+}
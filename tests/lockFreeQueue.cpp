@@ -0,0 +1,77 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../plugins/Deflect/LockFreeQueue.h"
+
+#include <thread>
+
+using brayns::LockFreeQueue;
+
+TEST_CASE("full_and_empty")
+{
+    LockFreeQueue<int> queue(2);
+    CHECK(!queue.front());
+    CHECK(queue.push(1));
+    CHECK(queue.push(2));
+    CHECK(!queue.push(3));
+
+    REQUIRE(queue.front());
+    CHECK_EQ(*queue.front(), 1);
+    queue.pop();
+    CHECK(queue.push(3));
+    CHECK_EQ(*queue.front(), 2);
+    queue.pop();
+    CHECK_EQ(*queue.front(), 3);
+    queue.pop();
+    CHECK(!queue.front());
+}
+
+TEST_CASE("producer_and_consumer_threads")
+{
+    const size_t count = 100000;
+    LockFreeQueue<size_t> queue(16);
+    std::thread producer([&queue] {
+        for (size_t i = 0; i < count; ++i)
+        {
+            while (!queue.push(i))
+                std::this_thread::yield();
+        }
+    });
+
+    size_t expected = 0;
+    while (expected < count)
+    {
+        const auto item = queue.front();
+        if (!item)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if (*item != expected)
+            break;
+        queue.pop();
+        ++expected;
+    }
+    producer.join();
+    CHECK_EQ(expected, count);
+    CHECK(!queue.front());
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <brayns/common/volume/MacroCellGrid.h>
+
+#include <stdexcept>
+
+using brayns::MacroCellGrid;
+
+TEST_CASE("cell_ranges")
+{
+    // Two cells along x, sharing the voxel at x = 16
+    const brayns::Vector3ui dimensions(MacroCellGrid::CELL_SIZE + 2, 2, 2);
+    brayns::uint8_ts voxels(dimensions.x * dimensions.y * dimensions.z, 10);
+    voxels[3] = 5;
+    voxels[MacroCellGrid::CELL_SIZE] = 200;
+    voxels.back() = 30;
+
+    MacroCellGrid grid;
+    grid.build(voxels.data(), dimensions, brayns::DataType::UINT8);
+    CHECK_EQ(grid.getDimensions(), brayns::Vector3ui(2, 1, 1));
+    CHECK_EQ(grid.getRanges(), brayns::floats({5, 200, 10, 200}));
+
+    voxels[MacroCellGrid::CELL_SIZE] = 10;
+    grid.build(voxels.data(), dimensions, brayns::DataType::UINT8);
+    CHECK_EQ(grid.getRanges(), brayns::floats({5, 10, 10, 30}));
+}
+
+TEST_CASE("visible_cells")
+{
+    const brayns::floats ranges{0, 1, 2, 3, 4.5f, 5, -10, 0};
+    const brayns::floats opacities{0, 0, 0, 0, 1, 0};
+    const brayns::Vector2f valueRange(0, 5);
+
+    CHECK_EQ(MacroCellGrid::getVisibleCells(ranges.data(), 4, opacities.data(),
+                                            opacities.size(), valueRange, 0.f),
+             brayns::uint8_ts({0, 0, 1, 0}));
+
+    // The cell interpolates between 3 and 4, where the opacity increases
+    const brayns::floats touching{3, 3.5f};
+    CHECK_EQ(MacroCellGrid::getVisibleCells(touching.data(), 1,
+                                            opacities.data(), opacities.size(),
+                                            valueRange, 0.f),
+             brayns::uint8_ts({1}));
+
+    CHECK_EQ(MacroCellGrid::getVisibleCells(ranges.data(), 4, opacities.data(),
+                                            opacities.size(), valueRange, 1.f),
+             brayns::uint8_ts({0, 0, 0, 0}));
+
+    CHECK_THROWS_AS(MacroCellGrid::getVisibleCells(ranges.data(), 4, nullptr, 0,
+                                                   valueRange, 0.f),
+                    std::runtime_error);
+}
@@ -0,0 +1,199 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <brayns/io/meshReaders.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using brayns::TriangleMesh;
+using brayns::Vector3f;
+using brayns::Vector3ui;
+
+namespace
+{
+/** Appends a value in the given endianness. */
+template <typename T>
+void append(std::string& data, const T value, const bool bigEndian)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    const uint16_t one = 1;
+    const bool littleEndianHost = *reinterpret_cast<const uint8_t*>(&one);
+    if (bigEndian == littleEndianHost)
+        std::reverse(bytes, bytes + sizeof(T));
+    data.append(bytes, sizeof(T));
+}
+
+/**
+ * A binary PLY file of a unit square in the z = 0 plane, with the given
+ * faces. Each face also has a "flags" property set to 3, which reads as a
+ * triangle count when the records are walked with the triangle size.
+ */
+std::string makePly(const std::vector<std::vector<int32_t>>& faces,
+                    const bool bigEndian = false)
+{
+    std::string data = "ply\nformat ";
+    data += bigEndian ? "binary_big_endian" : "binary_little_endian";
+    data +=
+        " 1.0\nelement vertex 4\nproperty float x\nproperty float y\n"
+        "property float z\nelement face " +
+        std::to_string(faces.size()) +
+        "\nproperty list uchar int vertex_indices\nproperty int flags\n"
+        "end_header\n";
+
+    const float vertices[4][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+    for (const auto& vertex : vertices)
+        for (const auto coordinate : vertex)
+            append(data, coordinate, bigEndian);
+    for (const auto& face : faces)
+    {
+        append(data, uint8_t(face.size()), bigEndian);
+        for (const auto index : face)
+            append(data, index, bigEndian);
+        append(data, int32_t(3), bigEndian);
+    }
+    return data;
+}
+
+TriangleMesh read(const std::string& data, const std::string& type)
+{
+    TriangleMesh mesh;
+    REQUIRE(brayns::readMesh(data.data(), data.size(), type, false, mesh));
+    return mesh;
+}
+
+const std::vector<Vector3ui> SQUARE{{0, 1, 2}, {0, 2, 3}};
+} // namespace
+
+TEST_CASE("ply_triangles")
+{
+    for (const bool bigEndian : {false, true})
+    {
+        const auto mesh =
+            read(makePly({{0, 1, 2}, {0, 2, 3}}, bigEndian), "ply");
+        CHECK_EQ(mesh.vertices.size(), 4);
+        CHECK_EQ(mesh.vertices[2], Vector3f(1, 1, 0));
+        CHECK_EQ(mesh.indices, SQUARE);
+    }
+}
+
+TEST_CASE("ply_quads")
+{
+    for (const bool bigEndian : {false, true})
+    {
+        const auto mesh =
+            read(makePly({{0, 1, 2, 3}, {0, 1, 2, 3}, {0, 1, 2, 3}},
+                         bigEndian),
+                 "ply");
+        CHECK_EQ(mesh.indices.size(), 6);
+        CHECK_EQ(std::vector<Vector3ui>(mesh.indices.begin(),
+                                        mesh.indices.begin() + 2),
+                 SQUARE);
+    }
+}
+
+TEST_CASE("ply_mixed_polygons")
+{
+    const auto mesh =
+        read(makePly({{0, 1, 2}, {0, 1, 2, 3}, {3, 2, 1}}), "ply");
+    const std::vector<Vector3ui> expected{{0, 1, 2},
+                                          {0, 1, 2},
+                                          {0, 2, 3},
+                                          {3, 2, 1}};
+    CHECK_EQ(mesh.indices, expected);
+}
+
+TEST_CASE("ply_invalid_indices")
+{
+    TriangleMesh mesh;
+    const auto triangles = makePly({{0, 1, 2}, {0, 2, 4}});
+    CHECK_THROWS_AS(brayns::readMesh(triangles.data(), triangles.size(),
+                                     "ply", false, mesh),
+                    std::runtime_error);
+
+    const auto polygons = makePly({{0, 1, 2, 3}, {0, -1, 2}});
+    CHECK_THROWS_AS(brayns::readMesh(polygons.data(), polygons.size(), "ply",
+                                     false, mesh),
+                    std::runtime_error);
+
+    const auto truncated = makePly({{0, 1, 2, 3}});
+    CHECK_THROWS_AS(brayns::readMesh(truncated.data(), truncated.size() - 4,
+                                     "ply", false, mesh),
+                    std::runtime_error);
+}
+
+TEST_CASE("obj_polygons")
+{
+    const std::string obj =
+        "# square\nv 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3 4\n";
+    const auto mesh = read(obj, "obj");
+    CHECK_EQ(mesh.vertices.size(), 4);
+    CHECK_EQ(mesh.indices, SQUARE);
+}
+
+TEST_CASE("obj_negative_indices")
+{
+    // Relative indices address the vertices defined before the face
+    const std::string obj =
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nf -3 -2 -1\nv 0 1 0\nf 1 -2 -1\n";
+    const auto mesh = read(obj, "obj");
+    CHECK_EQ(mesh.indices, SQUARE);
+}
+
+TEST_CASE("obj_texture_coordinates_and_normals")
+{
+    const std::string obj =
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nvt 0 0\nvt 1 1\nvn 0 0 1\n"
+        "f 1/1/1 2/2/1 3/2/1\n";
+    const auto mesh = read(obj, "obj");
+    CHECK_EQ(mesh.vertices.size(), 3);
+    CHECK_EQ(mesh.normals.size(), 3);
+    CHECK_EQ(mesh.normals[1], Vector3f(0, 0, 1));
+    REQUIRE_EQ(mesh.textureCoordinates.size(), 3);
+    CHECK_EQ(mesh.textureCoordinates[2], brayns::Vector2f(1, 1));
+}
+
+TEST_CASE("obj_invalid_indices")
+{
+    TriangleMesh mesh;
+    for (const std::string obj : {"v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 4\n",
+                                  "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 0\n",
+                                  "v 0 0 0\nv 1 0 0\nf -3 -2 -1\nv 1 1 0\n"})
+    {
+        CHECK_THROWS_AS(brayns::readMesh(obj.data(), obj.size(), "obj", false,
+                                         mesh),
+                        std::runtime_error);
+    }
+}
+
+TEST_CASE("unsupported_files")
+{
+    TriangleMesh mesh;
+    const std::string ascii =
+        "ply\nformat ascii 1.0\nelement vertex 0\nend_header\n";
+    CHECK(!brayns::readMesh(ascii.data(), ascii.size(), "ply", false, mesh));
+    const std::string materials = "mtllib a.mtl\nv 0 0 0\nf 1 1 1\n";
+    CHECK(!brayns::readMesh(materials.data(), materials.size(), "obj", false,
+                            mesh));
+}
@@ -0,0 +1,115 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <brayns/common/geometry/TriangleMeshSimplifier.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+namespace
+{
+brayns::TriangleMesh createSphere(const size_t nbRings, const size_t nbSegments)
+{
+    brayns::TriangleMesh mesh;
+    for (size_t r = 0; r <= nbRings; ++r)
+    {
+        const float theta = M_PI * r / nbRings;
+        for (size_t s = 0; s < nbSegments; ++s)
+        {
+            const float phi = 2.f * M_PI * s / nbSegments;
+            const brayns::Vector3f vertex(std::sin(theta) * std::cos(phi),
+                                          std::cos(theta),
+                                          std::sin(theta) * std::sin(phi));
+            mesh.vertices.push_back(vertex);
+            mesh.normals.push_back(vertex);
+        }
+    }
+    for (uint32_t r = 0; r < nbRings; ++r)
+        for (uint32_t s = 0; s < nbSegments; ++s)
+        {
+            const uint32_t a = r * nbSegments + s;
+            const uint32_t b = r * nbSegments + (s + 1) % nbSegments;
+            mesh.indices.emplace_back(a, b, a + nbSegments);
+            mesh.indices.emplace_back(b, b + nbSegments, a + nbSegments);
+        }
+    return mesh;
+}
+
+brayns::TriangleMesh createGrid(const uint32_t size)
+{
+    brayns::TriangleMesh mesh;
+    for (uint32_t y = 0; y <= size; ++y)
+        for (uint32_t x = 0; x <= size; ++x)
+            mesh.vertices.emplace_back(float(x) / size, float(y) / size, 0.f);
+    for (uint32_t y = 0; y < size; ++y)
+        for (uint32_t x = 0; x < size; ++x)
+        {
+            const uint32_t a = y * (size + 1) + x;
+            mesh.indices.emplace_back(a, a + 1, a + size + 1);
+            mesh.indices.emplace_back(a + 1, a + size + 2, a + size + 1);
+        }
+    return mesh;
+}
+} // namespace
+
+TEST_CASE("simplify_sphere")
+{
+    const auto sphere = createSphere(64, 128);
+    const auto simplified = brayns::simplifyMesh(sphere, 2000);
+
+    CHECK_LE(simplified.indices.size(), 2000);
+    CHECK_GT(simplified.indices.size(), 1000);
+    CHECK_EQ(simplified.normals.size(), simplified.vertices.size());
+    for (const auto& index : simplified.indices)
+        for (size_t i = 0; i < 3; ++i)
+            CHECK_LT(index[i], simplified.vertices.size());
+    for (const auto& vertex : simplified.vertices)
+        CHECK_EQ(glm::length(vertex), doctest::Approx(1.f).epsilon(0.02));
+}
+
+TEST_CASE("simplify_keeps_boundaries")
+{
+    const auto grid = createGrid(32);
+    const auto simplified = brayns::simplifyMesh(grid, 100);
+
+    CHECK_LE(simplified.indices.size(), 100);
+    float area = 0.f;
+    for (const auto& index : simplified.indices)
+    {
+        const auto& a = simplified.vertices[index.x];
+        const auto& b = simplified.vertices[index.y];
+        const auto& c = simplified.vertices[index.z];
+        area += 0.5f * glm::length(glm::cross(b - a, c - a));
+    }
+    CHECK_EQ(area, doctest::Approx(1.f));
+}
+
+TEST_CASE("create_lods")
+{
+    const auto sphere = createSphere(64, 128);
+    const auto lods = brayns::createLODs(sphere, 3, 0.25);
+
+    REQUIRE_EQ(lods.size(), 3);
+    size_t nbTriangles = sphere.indices.size();
+    for (const auto& lod : lods)
+    {
+        CHECK_LE(lod.indices.size(), nbTriangles / 4);
+        nbTriangles = lod.indices.size();
+    }
+}
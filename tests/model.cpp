@@ -23,6 +23,12 @@
 #include <jsonPropertyMap.h>
 #include <jsonSerialization.h>
 
+#ifdef BRAYNS_USE_OSPRAY
+#include <engines/ospray/OSPRayModel.h>
+#include <ospray/SDK/common/Data.h>
+#include <ospray/SDK/common/Managed.h>
+#endif
+
 #include "ClientServer.h"
 
 const std::string GET_INSTANCES("get-instances");
@@ -163,3 +169,63 @@ TEST_CASE_FIXTURE(ClientServer, "remove_model")
 
     CHECK_EQ(getScene().getNumModels(), 0);
 }
+
+#ifdef BRAYNS_USE_OSPRAY
+namespace
+{
+size_t getNbCommittedSpheres(const brayns::OSPRayModel& model,
+                             const size_t materialId)
+{
+    auto geometry = reinterpret_cast<ospray::ManagedObject*>(
+        model.getSpheresGeometry(materialId));
+    REQUIRE(geometry);
+    auto spheres = geometry->getParamData("spheres", nullptr);
+    REQUIRE(spheres);
+    return spheres->numBytes / sizeof(brayns::Sphere);
+}
+} // namespace
+
+TEST_CASE_FIXTURE(ClientServer, "commit_dirty_materials_only")
+{
+    auto& scene = getScene();
+
+    auto model = scene.createModel();
+    model->createMaterial(0, "first");
+    model->createMaterial(1, "second");
+    model->addSphere(0, {{0.f, 0.f, 0.f}, 1.f});
+    model->addSphere(1, {{2.f, 0.f, 0.f}, 1.f});
+    CHECK(model->getDirtyMaterials() == std::set<size_t>{0, 1});
+
+    auto& spheres = static_cast<brayns::OSPRayModel&>(*model);
+    scene.addModel(
+        std::make_shared<brayns::ModelDescriptor>(std::move(model), "spheres"));
+    commitAndRender();
+    CHECK(spheres.getDirtyMaterials().empty());
+
+    const auto untouched = spheres.getSpheresGeometry(0);
+    REQUIRE(untouched);
+
+    SUBCASE("one_material")
+    {
+        spheres.getSpheres(1).push_back({{4.f, 0.f, 0.f}, 1.f});
+        CHECK(spheres.getDirtyMaterials() == std::set<size_t>{1});
+
+        commitAndRender();
+        CHECK(spheres.getDirtyMaterials().empty());
+        CHECK_EQ(spheres.getSpheresGeometry(0), untouched);
+        CHECK_EQ(getNbCommittedSpheres(spheres, 0), 1);
+        CHECK_EQ(getNbCommittedSpheres(spheres, 1), 2);
+    }
+
+    SUBCASE("all_materials")
+    {
+        spheres.getSpheres()[0].push_back({{4.f, 0.f, 0.f}, 1.f});
+        CHECK(spheres.getDirtyMaterials() == std::set<size_t>{0, 1});
+
+        commitAndRender();
+        CHECK(spheres.getDirtyMaterials().empty());
+        CHECK_EQ(getNbCommittedSpheres(spheres, 0), 2);
+        CHECK_EQ(getNbCommittedSpheres(spheres, 1), 1);
+    }
+}
+#endif
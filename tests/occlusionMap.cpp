@@ -0,0 +1,84 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <brayns/common/geometry/OcclusionMap.h>
+
+#include <limits>
+
+using brayns::OcclusionMap;
+
+namespace
+{
+const brayns::Vector2ui SIZE(64, 32);
+
+/** A wall at distance 5 on the left half of the frame, nothing elsewhere. */
+std::vector<float> leftWall()
+{
+    std::vector<float> depth(SIZE.x * SIZE.y,
+                             std::numeric_limits<float>::infinity());
+    for (size_t y = 0; y < SIZE.y; ++y)
+        for (size_t x = 0; x < SIZE.x / 2; ++x)
+            depth[x + y * SIZE.x] = 5.f;
+    return depth;
+}
+} // namespace
+
+TEST_CASE("empty_map")
+{
+    const OcclusionMap map;
+    CHECK(map.isEmpty());
+    CHECK(!map.isOccluded({{-1, -1, -20}, {1, 1, -19}}));
+}
+
+TEST_CASE("boxes_behind_the_wall")
+{
+    // Camera at the origin looking along -z with a 90 degrees field of view:
+    // the left half of the frame is x < 0
+    const auto depth = leftWall();
+    const OcclusionMap map(depth.data(), SIZE, {0, 0, 0},
+                           brayns::Quaterniond(), 90.);
+    CHECK(!map.isEmpty());
+
+    // Behind the wall
+    CHECK(map.isOccluded({{-8, -1, -11}, {-6, 1, -10}}));
+    // In front of the wall
+    CHECK(!map.isOccluded({{-2, -1, -4}, {-1, 1, -3}}));
+    // Behind the wall but also seen over the background on the right
+    CHECK(!map.isOccluded({{-2, -1, -11}, {2, 1, -10}}));
+    // On the right
+    CHECK(!map.isOccluded({{6, -1, -11}, {8, 1, -10}}));
+    // Behind the camera or around it
+    CHECK(!map.isOccluded({{-8, -1, 10}, {-6, 1, 11}}));
+    CHECK(!map.isOccluded({{-1, -1, -1}, {1, 1, 1}}));
+    // Outside of the frame
+    CHECK(!map.isOccluded({{-40, -1, -11}, {-30, 1, -10}}));
+}
+
+TEST_CASE("moved_camera")
+{
+    // The same wall seen from a camera moved along x
+    const auto depth = leftWall();
+    const OcclusionMap map(depth.data(), SIZE, {100, 0, 0},
+                           brayns::Quaterniond(), 90.);
+    CHECK(map.isOccluded({{92, -1, -11}, {94, 1, -10}}));
+    CHECK(!map.isOccluded({{-8, -1, -11}, {-6, 1, -10}}));
+}
@@ -0,0 +1,102 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <brayns/Brayns.h>
+
+#include <brayns/common/Timer.h>
+#include <brayns/engine/Engine.h>
+#include <brayns/engine/Material.h>
+#include <brayns/engine/Model.h>
+#include <brayns/engine/Scene.h>
+
+#include <omp.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+namespace
+{
+const size_t NB_CELLS = 20000;
+const size_t NB_SPHERES_PER_CELL = 10;
+const size_t NB_TRIANGLES_PER_CELL = 100;
+
+void addCell(brayns::Model& model, const size_t cell)
+{
+    auto material = model.createMaterial(cell, std::to_string(cell));
+    material->setDiffuseColor({float(cell % 255) / 255.f, 0.5f, 0.5f});
+    for (size_t i = 0; i < NB_SPHERES_PER_CELL; ++i)
+        model.addSphere(cell, {{float(cell), float(i), 0.f}, 0.5f});
+
+    auto& mesh = model.getTriangleMeshes(cell);
+    for (size_t i = 0; i < NB_TRIANGLES_PER_CELL; ++i)
+    {
+        const auto first = static_cast<uint32_t>(mesh.vertices.size());
+        mesh.vertices.push_back({float(cell), float(i), 1.f});
+        mesh.vertices.push_back({float(cell) + 0.5f, float(i), 1.f});
+        mesh.vertices.push_back({float(cell), float(i) + 0.5f, 1.f});
+        mesh.indices.push_back({first, first + 1, first + 2});
+    }
+}
+
+/**
+ * Measures the geometry commit of a circuit-like model with one material
+ * per cell. Only the host-side packing of the material table geometries is
+ * parallel, the OSPRay objects are always created by the calling thread.
+ */
+uint64_t commitCells(brayns::Scene& scene, const int nbThreads)
+{
+    omp_set_num_threads(nbThreads);
+    auto model = scene.createModel();
+    for (size_t cell = 0; cell < NB_CELLS; ++cell)
+        addCell(*model, cell);
+
+    brayns::Timer timer;
+    timer.start();
+    model->commitGeometry();
+    timer.stop();
+    return timer.milliseconds();
+}
+
+void benchmark(const bool materialTable)
+{
+    std::vector<const char*> argv = {"brayns"};
+    if (materialTable)
+        argv.push_back("--material-table");
+    brayns::Brayns brayns(argv.size(), argv.data());
+    auto& scene = brayns.getEngine().getScene();
+
+    const int maxThreads = omp_get_max_threads();
+    const auto reference = commitCells(scene, 1);
+    MESSAGE((materialTable ? "Material table" : "One geometry per material")
+            << ", 1 thread: " << reference << " ms");
+    for (int nbThreads = 2; nbThreads <= maxThreads; nbThreads *= 2)
+    {
+        const auto milliseconds = commitCells(scene, nbThreads);
+        MESSAGE(nbThreads << " threads: " << milliseconds << " ms, speedup "
+                          << double(reference) / milliseconds);
+    }
+    omp_set_num_threads(maxThreads);
+}
+} // namespace
+
+TEST_CASE("commit_geometry_benchmark")
+{
+    benchmark(false);
+    benchmark(true);
+}
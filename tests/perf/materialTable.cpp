@@ -0,0 +1,107 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <brayns/Brayns.h>
+
+#include <brayns/common/Timer.h>
+#include <brayns/engine/Engine.h>
+#include <brayns/engine/Material.h>
+#include <brayns/engine/Model.h>
+#include <brayns/engine/Scene.h>
+
+#include <fstream>
+#include <unistd.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+namespace
+{
+const size_t NB_CELLS = 20000;
+const size_t NB_SPHERES_PER_CELL = 10;
+
+size_t residentMemoryInBytes()
+{
+    size_t size = 0, resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+struct CommitStats
+{
+    uint64_t milliseconds;
+    size_t memoryInBytes;
+};
+
+/**
+ * Creates a circuit-like model with one material per cell, and measures the
+ * time and memory needed until the first frame is rendered.
+ */
+CommitStats commitCells(const bool materialTable)
+{
+    std::vector<const char*> argv = {"brayns"};
+    if (materialTable)
+        argv.push_back("--material-table");
+    brayns::Brayns brayns(argv.size(), argv.data());
+    brayns.commit();
+
+    auto& scene = brayns.getEngine().getScene();
+    auto model = scene.createModel();
+    for (size_t cell = 0; cell < NB_CELLS; ++cell)
+    {
+        auto material = model->createMaterial(cell, std::to_string(cell));
+        material->setDiffuseColor({float(cell % 255) / 255.f, 0.5f, 0.5f});
+        for (size_t i = 0; i < NB_SPHERES_PER_CELL; ++i)
+            model->addSphere(cell, {{float(cell), float(i), 0.f}, 0.5f});
+    }
+
+    const auto memoryBefore = residentMemoryInBytes();
+    brayns::Timer timer;
+    timer.start();
+    scene.addModel(
+        std::make_shared<brayns::ModelDescriptor>(std::move(model), "cells"));
+    brayns.commitAndRender();
+    timer.stop();
+    const auto memoryAfter = residentMemoryInBytes();
+
+    return {timer.milliseconds(),
+            memoryAfter > memoryBefore ? memoryAfter - memoryBefore : 0};
+}
+} // namespace
+
+TEST_CASE("material_table_benchmark")
+{
+    const auto perMaterial = commitCells(false);
+    const auto materialTable = commitCells(true);
+
+    MESSAGE("One geometry per material: " << perMaterial.milliseconds
+                                          << " ms, "
+                                          << perMaterial.memoryInBytes
+                                          << " bytes");
+    MESSAGE("Material table           : " << materialTable.milliseconds
+                                          << " ms, "
+                                          << materialTable.memoryInBytes
+                                          << " bytes");
+
+    CHECK_MESSAGE(materialTable.milliseconds <= perMaterial.milliseconds,
+                  "Material table commit expected to be faster");
+    CHECK_MESSAGE(materialTable.memoryInBytes <= perMaterial.memoryInBytes,
+                  "Material table expected to use less memory");
+}
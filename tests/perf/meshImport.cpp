@@ -0,0 +1,202 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <brayns/Brayns.h>
+
+#include <brayns/common/Timer.h>
+#include <brayns/common/utils/filesystem.h>
+#include <brayns/engine/Engine.h>
+#include <brayns/engine/Model.h>
+#include <brayns/engine/Scene.h>
+#include <brayns/io/MeshLoader.h>
+
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <omp.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+namespace
+{
+const size_t NB_MESHES = 2000;
+const size_t NB_MATERIALS = 10;
+const size_t NB_RINGS = 32;
+const size_t NB_SEGMENTS = 64;
+const size_t GRID_SIZE = 1024;
+
+/** Writes a UV sphere as an OBJ file, as a stand-in for a cell mesh. */
+void writeSphere(const std::string& filename)
+{
+    std::ofstream file(filename);
+    for (size_t r = 0; r <= NB_RINGS; ++r)
+    {
+        const float theta = M_PI * r / NB_RINGS;
+        for (size_t s = 0; s < NB_SEGMENTS; ++s)
+        {
+            const float phi = 2.f * M_PI * s / NB_SEGMENTS;
+            file << "v " << std::sin(theta) * std::cos(phi) << " "
+                 << std::cos(theta) << " " << std::sin(theta) * std::sin(phi)
+                 << "\n";
+        }
+    }
+    for (size_t r = 0; r < NB_RINGS; ++r)
+        for (size_t s = 0; s < NB_SEGMENTS; ++s)
+        {
+            const size_t a = r * NB_SEGMENTS + s + 1;
+            const size_t b = r * NB_SEGMENTS + (s + 1) % NB_SEGMENTS + 1;
+            file << "f " << a << " " << b << " " << a + NB_SEGMENTS << "\n";
+            file << "f " << b << " " << b + NB_SEGMENTS << " "
+                 << a + NB_SEGMENTS << "\n";
+        }
+}
+
+/** Writes a binary PLY height field, as a stand-in for a scanned surface. */
+size_t writeGrid(const std::string& filename)
+{
+    const size_t nbFaces = 2 * (GRID_SIZE - 1) * (GRID_SIZE - 1);
+    std::ofstream file(filename, std::ios::binary);
+    file << "ply\nformat binary_little_endian 1.0\n"
+         << "element vertex " << GRID_SIZE * GRID_SIZE << "\n"
+         << "property float x\nproperty float y\nproperty float z\n"
+         << "element face " << nbFaces << "\n"
+         << "property list uchar int vertex_indices\nend_header\n";
+    for (size_t y = 0; y < GRID_SIZE; ++y)
+        for (size_t x = 0; x < GRID_SIZE; ++x)
+        {
+            const float vertex[] = {float(x), float(y),
+                                    std::sin(x * 0.1f) * std::cos(y * 0.1f)};
+            file.write(reinterpret_cast<const char*>(vertex), sizeof(vertex));
+        }
+    const uint8_t nbIndices = 3;
+    for (size_t y = 0; y + 1 < GRID_SIZE; ++y)
+        for (size_t x = 0; x + 1 < GRID_SIZE; ++x)
+        {
+            const int32_t a = y * GRID_SIZE + x;
+            const int32_t b = a + GRID_SIZE;
+            for (const auto& face : {std::array<int32_t, 3>{{a, a + 1, b}},
+                                     std::array<int32_t, 3>{{a + 1, b + 1, b}}})
+            {
+                file.write(reinterpret_cast<const char*>(&nbIndices), 1);
+                file.write(reinterpret_cast<const char*>(face.data()),
+                           sizeof(face));
+            }
+        }
+    return nbFaces;
+}
+
+uint64_t importMeshes(brayns::Scene& scene,
+                      const std::vector<brayns::MeshFile>& files,
+                      const int nbThreads)
+{
+    omp_set_num_threads(nbThreads);
+    brayns::MeshLoader loader(scene);
+    auto model = scene.createModel();
+
+    brayns::Timer timer;
+    timer.start();
+    const auto errors = loader.importMeshes(files, *model,
+                                            brayns::GeometryQuality::high, {});
+    timer.stop();
+
+    CHECK(errors.empty());
+    size_t nbTriangles = 0;
+    for (const auto& mesh : model->getTriangleMeshes())
+        nbTriangles += mesh.second.indices.size();
+    CHECK_EQ(nbTriangles, NB_MESHES * NB_RINGS * NB_SEGMENTS * 2);
+    return timer.milliseconds();
+}
+} // namespace
+
+TEST_CASE("mesh_import_benchmark")
+{
+    const auto folder = fs::temp_directory_path() / "brayns_mesh_import";
+    fs::create_directories(folder);
+
+    std::vector<brayns::MeshFile> files;
+    for (size_t i = 0; i < NB_MESHES; ++i)
+    {
+        const auto filename =
+            (folder / (std::to_string(i) + ".obj")).string();
+        writeSphere(filename);
+        brayns::Matrix4f transformation(1.f);
+        transformation[3] = brayns::Vector4f(3.f * i, 0.f, 0.f, 1.f);
+        files.push_back({filename, transformation, i % NB_MATERIALS});
+    }
+
+    const char* argv[] = {"brayns"};
+    brayns::Brayns brayns(1, argv);
+    auto& scene = brayns.getEngine().getScene();
+
+    const int maxThreads = omp_get_max_threads();
+    const auto reference = importMeshes(scene, files, 1);
+    MESSAGE("1 thread: " << reference << " ms");
+    for (int nbThreads = 2; nbThreads <= maxThreads; nbThreads *= 2)
+    {
+        const auto milliseconds = importMeshes(scene, files, nbThreads);
+        MESSAGE(nbThreads << " threads: " << milliseconds << " ms, speedup "
+                          << double(reference) / milliseconds);
+    }
+    omp_set_num_threads(maxThreads);
+
+    fs::remove_all(folder);
+}
+
+TEST_CASE("ply_import_benchmark")
+{
+    const auto filename =
+        (fs::temp_directory_path() / "brayns_grid.ply").string();
+    const auto nbFaces = writeGrid(filename);
+
+    const char* argv[] = {"brayns"};
+    brayns::Brayns brayns(1, argv);
+    auto& scene = brayns.getEngine().getScene();
+    brayns::MeshLoader loader(scene);
+
+    const int maxThreads = omp_get_max_threads();
+    for (const auto quality :
+         {brayns::GeometryQuality::low, brayns::GeometryQuality::high})
+    {
+        for (int nbThreads = 1; nbThreads <= maxThreads; nbThreads *= 2)
+        {
+            omp_set_num_threads(nbThreads);
+            auto model = scene.createModel();
+            brayns::Timer timer;
+            timer.start();
+            loader.importMesh(filename, {}, *model, brayns::Matrix4f(1),
+                              brayns::NO_MATERIAL, quality);
+            timer.stop();
+
+            const auto& mesh = model->getTriangleMeshes().at(0);
+            CHECK_EQ(mesh.indices.size(), nbFaces);
+            CHECK_EQ(mesh.vertices.size(), GRID_SIZE * GRID_SIZE);
+            CHECK_EQ(mesh.normals.size(),
+                     quality == brayns::GeometryQuality::high
+                         ? mesh.vertices.size()
+                         : 0);
+            MESSAGE(brayns::enumToString(quality)
+                    << " quality, " << nbThreads
+                    << " threads: " << timer.milliseconds() << " ms");
+        }
+    }
+    omp_set_num_threads(maxThreads);
+
+    fs::remove(filename);
+}
@@ -0,0 +1,160 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <brayns/Brayns.h>
+
+#include <brayns/common/Timer.h>
+#include <brayns/engine/Camera.h>
+#include <brayns/engine/Engine.h>
+#include <brayns/engine/Model.h>
+#include <brayns/engine/Scene.h>
+#include <brayns/engine/SharedDataVolume.h>
+#include <brayns/parameters/ParametersManager.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "../doctest.h"
+
+namespace
+{
+const uint32_t VOLUME_SIZE = 256;
+const size_t NB_FRAMES = 10;
+const double REFERENCE_SAMPLING_RATE = 8.0;
+const double SAMPLING_RATES[] = {0.0625, 0.125, 0.25, 0.5, 1.0};
+
+/**
+ * A mostly transparent volume: a dense sphere in the middle of empty space,
+ * as it is typical for segmented or simulated data.
+ */
+brayns::uint8_ts createSparseVoxels()
+{
+    brayns::uint8_ts voxels(size_t(VOLUME_SIZE) * VOLUME_SIZE * VOLUME_SIZE);
+    const float center = VOLUME_SIZE / 2.f;
+    const float radius = VOLUME_SIZE / 8.f;
+    size_t index = 0;
+    for (uint32_t z = 0; z < VOLUME_SIZE; ++z)
+        for (uint32_t y = 0; y < VOLUME_SIZE; ++y)
+            for (uint32_t x = 0; x < VOLUME_SIZE; ++x, ++index)
+            {
+                const brayns::Vector3f position(x, y, z);
+                const float distance =
+                    glm::length(position - brayns::Vector3f(center));
+                if (distance < radius)
+                    voxels[index] = 255 - uint8_t(255.f * distance / radius);
+            }
+    return voxels;
+}
+
+struct Frame
+{
+    float msPerFrame{0.f};
+    brayns::uint8_ts pixels;
+};
+
+/**
+ * Average rendering time of a frame of the volume, in milliseconds, and the
+ * last rendered frame. The camera does not move, so that all frames can be
+ * compared with each other.
+ */
+Frame renderVolume(const double samplingRate, const bool preIntegration)
+{
+    const auto rate = std::to_string(samplingRate);
+    std::vector<const char*> argv = {"brayns",
+                                     "--disable-accumulation",
+                                     "--plugin",
+                                     "braynsCircuitExplorer",
+                                     "--renderer",
+                                     "circuit_explorer_advanced",
+                                     "--volume-sampling-rate",
+                                     rate.c_str()};
+    if (preIntegration)
+        argv.push_back("--volume-pre-integration");
+    brayns::Brayns brayns(argv.size(), argv.data());
+    brayns.commit();
+
+    auto& scene = brayns.getEngine().getScene();
+    auto model = scene.createModel();
+    auto volume = model->createSharedDataVolume(
+        brayns::Vector3ui(VOLUME_SIZE), brayns::Vector3f(1.f),
+        brayns::DataType::UINT8);
+    volume->mapData(createSparseVoxels());
+    model->addVolume(volume);
+    scene.addModel(
+        std::make_shared<brayns::ModelDescriptor>(std::move(model), "volume"));
+    brayns.commitAndRender();
+
+    // Without accumulation, every frame samples the volume again
+    brayns::Timer timer;
+    timer.start();
+    for (size_t i = 0; i < NB_FRAMES; ++i)
+        brayns.commitAndRender();
+    timer.stop();
+
+    Frame frame;
+    frame.msPerFrame = float(timer.milliseconds()) / NB_FRAMES;
+
+    auto& frameBuffer = brayns.getEngine().getFrameBuffer();
+    frameBuffer.map();
+    const auto size = frameBuffer.getSize();
+    const auto colors = frameBuffer.getColorBuffer();
+    frame.pixels.assign(colors, colors + size_t(size.x) * size.y *
+                                             frameBuffer.getColorDepth());
+    frameBuffer.unmap();
+    return frame;
+}
+
+/** Root mean square error of the color channels, in [0, 255]. */
+float imageError(const brayns::uint8_ts& image,
+                 const brayns::uint8_ts& reference)
+{
+    REQUIRE_EQ(image.size(), reference.size());
+    double sum = 0.0;
+    for (size_t i = 0; i < image.size(); ++i)
+    {
+        const double difference = double(image[i]) - double(reference[i]);
+        sum += difference * difference;
+    }
+    return float(std::sqrt(sum / std::max(image.size(), size_t(1))));
+}
+} // namespace
+
+TEST_CASE("volume_sampling_benchmark")
+{
+    // Far more samples than any interactive setting, close to the exact
+    // integral of the volume
+    const auto reference = renderVolume(REFERENCE_SAMPLING_RATE, true);
+    MESSAGE("Reference, sampling rate " << REFERENCE_SAMPLING_RATE << ": "
+                                        << reference.msPerFrame
+                                        << " ms/frame");
+
+    for (const bool preIntegration : {false, true})
+    {
+        for (const double samplingRate : SAMPLING_RATES)
+        {
+            const auto frame = renderVolume(samplingRate, preIntegration);
+            MESSAGE((preIntegration ? "Pre-integrated" : "Point sampled ")
+                    << ", sampling rate " << samplingRate << ": "
+                    << frame.msPerFrame << " ms/frame, RMS error "
+                    << imageError(frame.pixels, reference.pixels));
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <tests/paths.h>
+
+#include <brayns/Brayns.h>
+
+#include <brayns/engine/Engine.h>
+#include <brayns/engine/Material.h>
+#include <brayns/engine/Model.h>
+#include <brayns/engine/Scene.h>
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+namespace
+{
+struct ProteinLoader
+{
+    const char* argv[1] = {"brayns"};
+    brayns::Brayns brayns{1, argv};
+
+    brayns::ModelDescriptorPtr load(
+        const std::string& path,
+        const brayns::PropertyMap& properties = brayns::PropertyMap())
+    {
+        auto& scene = brayns.getEngine().getScene();
+        return scene.loadModel(path, {"protein", path, properties}, {});
+    }
+};
+
+size_t getNbSpheres(const brayns::Model& model, const size_t materialId)
+{
+    const auto it = model.getSpheres().find(materialId);
+    return it == model.getSpheres().end() ? 0 : it->second.size();
+}
+
+void checkPosition(const brayns::Vector3d& position,
+                   const brayns::Vector3d& expected)
+{
+    for (size_t i = 0; i < 3; ++i)
+        CHECK_EQ(position[i], doctest::Approx(expected[i]).epsilon(1e-5));
+}
+} // namespace
+
+TEST_CASE_FIXTURE(ProteinLoader, "pdb_atoms")
+{
+    const auto descriptor = load(BRAYNS_TESTDATA_MODEL_PDB_PATH);
+    const auto& model = descriptor->getModel();
+
+    // Materials are the colors of the elements, named after them
+    const std::map<size_t, std::pair<std::string, size_t>> elements = {
+        {5, {"C", 232}}, {6, {"N", 92}}, {7, {"O", 220}}, {14, {"P", 22}}};
+    CHECK_EQ(model.getSpheres().size(), elements.size());
+    CHECK_EQ(model.getMaterials().size(), elements.size());
+    for (const auto& element : elements)
+    {
+        const auto materialId = element.first;
+        REQUIRE(model.getMaterials().count(materialId));
+        CHECK_EQ(model.getMaterial(materialId)->getName(),
+                 element.second.first);
+        CHECK_EQ(getNbSpheres(model, materialId), element.second.second);
+    }
+
+    // Carbon radius of 67 picometers, in the units of the positions
+    CHECK_EQ(model.getSpheres().at(5)[0].radius, doctest::Approx(0.0067f));
+
+    // A single BIOMT operator does not instantiate anything
+    CHECK_EQ(descriptor->getInstances().size(), 1);
+}
+
+TEST_CASE_FIXTURE(ProteinLoader, "pdb_chains")
+{
+    brayns::PropertyMap properties;
+    properties.setProperty({"colorScheme", std::string("protein-chains")});
+    const auto descriptor = load(BRAYNS_TESTDATA_MODEL_PDB_PATH, properties);
+    const auto& model = descriptor->getModel();
+
+    CHECK_EQ(model.getSpheres().size(), 2);
+    CHECK_EQ(getNbSpheres(model, 1), 280);
+    CHECK_EQ(getNbSpheres(model, 2), 286);
+}
+
+TEST_CASE_FIXTURE(ProteinLoader, "pdb_biological_assembly")
+{
+    const auto descriptor = load(BRAYNS_TESTDATA_MODEL_PDB_BIOMT_PATH);
+    const auto& model = descriptor->getModel();
+
+    // Chain B is not part of the assembly
+    CHECK_EQ(model.getSpheres().size(), 2);
+    CHECK_EQ(getNbSpheres(model, 5), 1);
+    CHECK_EQ(getNbSpheres(model, 7), 1);
+    CHECK_EQ(getNbSpheres(model, 6), 0);
+
+    // Positions are converted from angstrom to nanometers
+    const brayns::Vector3d carbon(model.getSpheres().at(5)[0].center);
+    checkPosition(carbon, {0.01, 0.02, 0.03});
+
+    // One instance per operator, the first one is the loaded geometry
+    const auto& instances = descriptor->getInstances();
+    REQUIRE_EQ(instances.size(), 3);
+
+    // Rotation of 90 degrees around z, then translation of 10 angstrom on x
+    const auto first = instances[1].getTransformation().toMatrix();
+    checkPosition(brayns::Vector3d(first * brayns::Vector4d(carbon, 1.)),
+                  {0.08, 0.01, 0.03});
+
+    // Translation of 20 angstrom on y
+    const auto second = instances[2].getTransformation().toMatrix();
+    checkPosition(brayns::Vector3d(second * brayns::Vector4d(carbon, 1.)),
+                  {0.01, 0.22, 0.03});
+}
+
+TEST_CASE_FIXTURE(ProteinLoader, "pdb_asymmetric_unit")
+{
+    brayns::PropertyMap properties;
+    properties.setProperty({"biologicalAssembly", false});
+    const auto descriptor =
+        load(BRAYNS_TESTDATA_MODEL_PDB_BIOMT_PATH, properties);
+    const auto& model = descriptor->getModel();
+
+    CHECK_EQ(getNbSpheres(model, 5), 1);
+    CHECK_EQ(getNbSpheres(model, 6), 1);
+    CHECK_EQ(getNbSpheres(model, 7), 1);
+    CHECK_EQ(descriptor->getInstances().size(), 1);
+}
@@ -0,0 +1,65 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ClientServer.h"
+
+const std::string SET_RENDER_REGIONS("set-render-regions");
+
+TEST_CASE_FIXTURE(ClientServer, "set_render_regions")
+{
+    const brayns::FrameBufferRegions params{"", {{{0, 0}, {128, 128}}}};
+    CHECK(makeRequest<brayns::FrameBufferRegions, bool>(SET_RENDER_REGIONS,
+                                                         params));
+    REQUIRE_EQ(getFrameBuffer().getRenderRegions().size(), 1);
+    CHECK_EQ(getFrameBuffer().getRenderRegions()[0].size,
+             brayns::Vector2ui(128, 128));
+
+    CHECK(!makeRequest<brayns::FrameBufferRegions, bool>(
+        SET_RENDER_REGIONS, {"unknown", {}}));
+    CHECK_EQ(getFrameBuffer().getRenderRegions().size(), 1);
+
+    CHECK(makeRequest<brayns::FrameBufferRegions, bool>(SET_RENDER_REGIONS,
+                                                         {"", {}}));
+    CHECK(getFrameBuffer().getRenderRegions().empty());
+}
+
+TEST_CASE_FIXTURE(ClientServer, "tiles_outside_regions_are_empty")
+{
+    auto& frameBuffer = getFrameBuffer();
+    frameBuffer.setRenderRegions({{{0, 0}, {100, 100}}});
+    commitAndRender();
+
+    // The regions are rounded up to whole tiles of 64 pixels
+    frameBuffer.map();
+    const auto& size = frameBuffer.getSize();
+    const auto colors = frameBuffer.getColorBuffer();
+    size_t nbRendered = 0;
+    for (size_t y = 0; y < size.y; ++y)
+    {
+        for (size_t x = 128; x < size.x; ++x)
+        {
+            const auto pixel = colors + 4 * (y * size.x + x);
+            nbRendered += pixel[0] || pixel[1] || pixel[2] || pixel[3];
+        }
+    }
+    frameBuffer.unmap();
+    CHECK_EQ(nbRendered, 0);
+
+    frameBuffer.setRenderRegions({});
+}
@@ -0,0 +1,149 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <brayns/common/simulation/AbstractSimulationHandler.h>
+#include <brayns/parameters/AnimationParameters.h>
+
+namespace
+{
+/** Frames filled with their frame number, counting the report reads. */
+class TestSimulationHandler : public brayns::AbstractSimulationHandler
+{
+public:
+    TestSimulationHandler()
+    {
+        _nbFrames = 10;
+        _frameSize = 3;
+    }
+
+    brayns::AbstractSimulationHandlerPtr clone() const final
+    {
+        return std::make_shared<TestSimulationHandler>(*this);
+    }
+
+    void* getFrameData(const uint32_t frame) final
+    {
+        const auto boundedFrame = _getBoundedFrame(frame);
+        if (_currentFrame != boundedFrame)
+        {
+            ++reads;
+            _frameData.assign(_frameSize, boundedFrame);
+            _currentFrame = boundedFrame;
+        }
+        return _frameData.data();
+    }
+
+    size_t reads{0};
+};
+
+float firstValue(void* data)
+{
+    return static_cast<const float*>(data)[0];
+}
+} // namespace
+
+TEST_CASE("whole_frames")
+{
+    TestSimulationHandler handler;
+    CHECK_EQ(firstValue(handler.getInterpolatedFrameData(3.)), 3.f);
+    CHECK_EQ(handler.getCurrentFramePosition(), 3.);
+}
+
+TEST_CASE("blends_neighbouring_frames")
+{
+    TestSimulationHandler handler;
+    CHECK_EQ(firstValue(handler.getInterpolatedFrameData(2.25)),
+             doctest::Approx(2.25));
+    CHECK_EQ(handler.getCurrentFramePosition(), doctest::Approx(2.25));
+
+    // The last frame is not blended with the first one
+    CHECK_EQ(firstValue(handler.getInterpolatedFrameData(9.5)), 9.f);
+}
+
+TEST_CASE("each_frame_is_read_once")
+{
+    TestSimulationHandler handler;
+    for (double position = 0.; position < 8.; position += 0.25)
+    {
+        CHECK_EQ(firstValue(handler.getInterpolatedFrameData(position)),
+                 doctest::Approx(position));
+    }
+    CHECK_EQ(handler.reads, 9);
+
+    handler.reads = 0;
+    for (double position = 7.75; position > 2.; position -= 0.25)
+        handler.getInterpolatedFrameData(position);
+    CHECK_EQ(handler.reads, 5);
+}
+
+TEST_CASE("quantized_frames")
+{
+    TestSimulationHandler handler;
+    auto data = static_cast<float*>(handler.getInterpolatedFrameData(3.));
+    CHECK_EQ(handler.encodeFrameData(data, {0, 9}), data);
+
+    handler.setEncoding(brayns::SimulationDataEncoding::uint8);
+    auto bytes =
+        static_cast<const uint8_t*>(handler.encodeFrameData(data, {0, 9}));
+    CHECK_EQ(bytes[0], 85);
+    CHECK_EQ(bytes[2], 85);
+
+    // Values outside of the range are clamped
+    bytes = static_cast<const uint8_t*>(handler.encodeFrameData(data, {4, 9}));
+    CHECK_EQ(bytes[0], 0);
+    bytes = static_cast<const uint8_t*>(handler.encodeFrameData(data, {0, 2}));
+    CHECK_EQ(bytes[0], 255);
+
+    handler.setEncoding(brayns::SimulationDataEncoding::uint16);
+    const auto words =
+        static_cast<const uint16_t*>(handler.encodeFrameData(data, {0, 9}));
+    CHECK_EQ(words[1], 21845);
+    CHECK_EQ(brayns::AbstractSimulationHandler::getBytesPerValue(
+                 handler.getEncoding()),
+             2);
+}
+
+TEST_CASE("fractional_animation_delta")
+{
+    brayns::AnimationParameters animation;
+    animation.setNumFrames(4);
+    animation.setDelta(0.25);
+    animation.togglePlayback();
+
+    for (size_t i = 0; i < 6; ++i)
+        animation.update();
+    CHECK_EQ(animation.getFrame(), 1);
+    CHECK_EQ(animation.getFramePosition(), doctest::Approx(1.5));
+
+    // 0.1 is not exact in binary, the frames must still be reached
+    animation.setFrame(0);
+    animation.setDelta(0.1);
+    for (size_t i = 0; i < 10; ++i)
+        animation.update();
+    CHECK_EQ(animation.getFramePosition(), doctest::Approx(1.));
+    CHECK_EQ(animation.getFrame(), 1);
+
+    animation.setDelta(-0.5);
+    for (size_t i = 0; i < 3; ++i)
+        animation.update();
+    CHECK_EQ(animation.getFramePosition(), doctest::Approx(3.5));
+}
@@ -0,0 +1,130 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include <plugins/CircuitExplorer/plugin/io/SpikeFrame.h>
+
+#include <algorithm>
+#include <random>
+
+namespace
+{
+const size_t NB_CELLS = 100;
+const uint32_t NB_FRAMES = 500;
+const double DT = 0.01;
+const SpikeDecay DECAY{-80.f, -1.f, 1.f, 1.f};
+
+Spikes createSpikes()
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> time(0.f, NB_FRAMES * DT);
+    std::uniform_int_distribution<uint32_t> cell(0, NB_CELLS - 1);
+
+    Spikes spikes(1000);
+    for (auto& spike : spikes)
+        spike = {time(generator), cell(generator)};
+    std::stable_sort(spikes.begin(), spikes.end(),
+                     [](const Spike& a, const Spike& b) {
+                         return a.time < b.time;
+                     });
+    return spikes;
+}
+
+/** The frame computed from all the spikes, without any decay window */
+std::vector<float> referenceFrame(const Spikes& spikes, const uint32_t frame)
+{
+    const double ts = frame * DT;
+    std::vector<float> data(NB_CELLS, DECAY.restValue);
+    for (const auto& spike : spikes)
+    {
+        if (spike.time >= ts + DECAY.anticipation)
+            continue;
+        const double elapsed =
+            spike.time >= ts ? 0. : frame - std::floor(spike.time / DT);
+        const float value =
+            std::max<float>(DECAY.restValue,
+                            DECAY.spikingValue - DECAY.decaySpeed * elapsed);
+        data[spike.cell] = std::max(data[spike.cell], value);
+    }
+    return data;
+}
+
+/**
+ * Computes the frames in the given order into the same buffer, like the
+ * simulation handler does, and checks each against the reference.
+ */
+void checkFrames(const Spikes& spikes, const std::vector<uint32_t>& frames)
+{
+    std::vector<float> data(NB_CELLS, 0.f);
+    for (const auto frame : frames)
+    {
+        computeSpikeFrame(spikes, frame, DT, DECAY, data.data(), NB_CELLS);
+        REQUIRE_MESSAGE(data == referenceFrame(spikes, frame),
+                        "Frame " << frame);
+    }
+}
+} // namespace
+
+TEST_CASE("spike_frames_forward")
+{
+    const auto spikes = createSpikes();
+    std::vector<uint32_t> frames(NB_FRAMES);
+    for (uint32_t i = 0; i < NB_FRAMES; ++i)
+        frames[i] = i;
+    checkFrames(spikes, frames);
+}
+
+TEST_CASE("spike_frames_backward")
+{
+    const auto spikes = createSpikes();
+    std::vector<uint32_t> frames(NB_FRAMES);
+    for (uint32_t i = 0; i < NB_FRAMES; ++i)
+        frames[i] = NB_FRAMES - 1 - i;
+    checkFrames(spikes, frames);
+}
+
+TEST_CASE("spike_frames_seek")
+{
+    const auto spikes = createSpikes();
+    std::vector<uint32_t> frames(NB_FRAMES);
+    for (uint32_t i = 0; i < NB_FRAMES; ++i)
+        frames[i] = i;
+    std::shuffle(frames.begin(), frames.end(), std::mt19937(7));
+    checkFrames(spikes, frames);
+}
+
+TEST_CASE("spike_frame_decay")
+{
+    // A spike at frame 10 shows from one time unit before, then decays
+    const Spikes spikes{{10 * DT, 3}};
+    std::vector<float> data(NB_CELLS);
+
+    computeSpikeFrame(spikes, 10, DT, DECAY, data.data(), NB_CELLS);
+    CHECK_EQ(data[3], DECAY.spikingValue);
+    CHECK_EQ(data[2], DECAY.restValue);
+
+    computeSpikeFrame(spikes, 15, DT, DECAY, data.data(), NB_CELLS);
+    CHECK_EQ(data[3], doctest::Approx(DECAY.spikingValue - 5.f));
+
+    computeSpikeFrame(spikes, 200, DT, DECAY, data.data(), NB_CELLS);
+    CHECK_EQ(data[3], DECAY.restValue);
+}
@@ -0,0 +1,96 @@
+/* Copyright (c) 2015-2019, EPFL/Blue Brain Project
+ * All rights reserved. Do not distribute without permission.
+ *
+ * This file is part of Brayns <https://github.com/BlueBrain/Brayns>
+ *
+ * This library is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License version 3.0 as published
+ * by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+
+#include "../plugins/Rockets/VersionedObject.h"
+
+#include <stdexcept>
+
+namespace
+{
+std::string patch(const std::string& from, const std::string& to)
+{
+    rapidjson::Document fromDocument;
+    fromDocument.Parse(from.c_str());
+    rapidjson::Document toDocument;
+    toDocument.Parse(to.c_str());
+    return brayns::createJsonPatch(fromDocument, toDocument);
+}
+} // namespace
+
+TEST_CASE("patch_members")
+{
+    CHECK_EQ(patch(R"({"a":1,"b":{"c":true}})", R"({"a":1,"b":{"c":true}})"),
+             "[]");
+    CHECK_EQ(patch(R"({"a":1,"b":"x"})", R"({"b":"y","c":[1]})"),
+             R"([{"op":"remove","path":"/a"},)"
+             R"({"op":"replace","path":"/b","value":"y"},)"
+             R"({"op":"add","path":"/c","value":[1]}])");
+    CHECK_EQ(patch(R"({"a/b":{"c~d":1}})", R"({"a/b":{"c~d":2}})"),
+             R"([{"op":"replace","path":"/a~1b/c~0d","value":2}])");
+}
+
+TEST_CASE("patch_arrays")
+{
+    CHECK_EQ(patch("[1,2,3]", "[1,5]"),
+             R"([{"op":"replace","path":"/1","value":5},)"
+             R"({"op":"remove","path":"/2"}])");
+    CHECK_EQ(patch("[1,2,3,4]", "[1]"),
+             R"([{"op":"remove","path":"/3"},)"
+             R"({"op":"remove","path":"/2"},)"
+             R"({"op":"remove","path":"/1"}])");
+    CHECK_EQ(patch(R"([{"a":1}])", R"([{"a":2},{"b":3}])"),
+             R"([{"op":"replace","path":"/0/a","value":2},)"
+             R"({"op":"add","path":"/1","value":{"b":3}}])");
+    CHECK_EQ(patch(R"({"a":[1]})", R"({"a":{"b":1}})"),
+             R"([{"op":"replace","path":"/a","value":{"b":1}}])");
+}
+
+TEST_CASE("versioned_object")
+{
+    brayns::VersionedObject object;
+    CHECK_EQ(object.getVersion(), 0);
+
+    const std::string first = R"({"size":[1,2],"name":"scene","ids":[0]})";
+    CHECK_EQ(object.update(first),
+             R"([{"op":"replace","path":"","value":)" + first + "}]");
+    CHECK_EQ(object.getVersion(), 1);
+
+    CHECK(object.update(first).empty());
+    CHECK_EQ(object.getVersion(), 1);
+
+    const std::string second = R"({"size":[1,3],"name":"scene","ids":[0]})";
+    CHECK_EQ(object.update(second),
+             R"([{"op":"replace","path":"/size/1","value":3}])");
+    CHECK_EQ(object.getVersion(), 2);
+    CHECK_EQ(object.getJson(), second);
+
+    // The whole document is cheaper to send than the list of changes
+    const std::string third = R"({"a":1})";
+    CHECK_EQ(object.update(third),
+             R"([{"op":"replace","path":"","value":{"a":1}}])");
+    CHECK_EQ(object.getReplacePatch(),
+             R"([{"op":"replace","path":"","value":{"a":1}}])");
+    CHECK_EQ(object.getVersion(), 3);
+
+    CHECK_THROWS_AS(object.update("{"), std::runtime_error);
+    CHECK_EQ(object.getVersion(), 3);
+}